@@ -25,6 +25,18 @@ function [lambda, gamma]=RBF(S,Y,flag)
 
 
 [m,n]=size(S);
+
+if exist('rbfbuild_mex', 'file') == 3 && any(strcmp(flag, {'cubic', 'TPS', 'linear'}))
+    % Compiled engine (see buildRBFMex); the tail comes back as [1; x]
+    try
+        params = rbfbuild_mex(S, Y, flag, 0, 1, 0);
+        lambda = params(1:m);
+        gamma = [params(m+2:end); params(m+1)];
+        return
+    catch
+        % singular system, use the pseudoinverse below
+    end
+end
 P=[S,ones(m,1)];
 
 R=zeros(m,m);
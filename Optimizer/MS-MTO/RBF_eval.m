@@ -30,6 +30,12 @@ if nX~=nS %check that both matrices are of the right shape
     [mX,nX]=size(X);
 end
 
+if exist('rbfpredict_mex', 'file') == 3 && any(strcmp(flag, {'cubic', 'TPS', 'linear'}))
+    % Compiled engine, see buildRBFMex
+    Yest = rbfpredict_mex(S, [lambda; gamma(end); gamma(1:end-1)], 0, flag, 0, 1, X);
+    return
+end
+
 R=zeros(mX,mS); %compute pairwise distances of points in X and S
 for ii = 1:mX
     for jj = 1:mS
@@ -0,0 +1,81 @@
+classdef DaceModel < handle
+%DACEMODEL  Kriging model for a growing set of design sites
+%
+% Call:   M = DaceModel(S, Y, regr, corr, theta0)
+%         M = DaceModel(S, Y, regr, corr, theta0, lob, upb)
+%         M = DaceModel(..., 'refit', k, 'window', w)
+%
+% Input as for DACEFIT. The model is fitted once, and APPEND then adds
+% design sites by extending the Cholesky factor of the correlation matrix
+% with theta and the normalisation held fixed, which costs O(m^2) per site
+% instead of the O(m^3) of a new fit.
+%   k : refit with DACEFIT, starting from the current theta, after every
+%       k appended sites (default 0: never)
+%   w : keep at most the w most recent sites (default 0: all); older
+%       sites are dropped by a rank-one update of the factor
+%
+% Methods
+%   M.append(S, Y)         add the sites in the rows of S with responses Y
+%   M.remove()             drop the oldest site
+%   [y, mse] = M.predict(x)  as PREDICTOR for the sites in the rows of x
+%   dmodel = M.model()     DACE model struct for PREDICTOR
+%   m = M.size()           number of design sites
+%
+% Uses the compiled engine, see BUILDDACEMEX.
+
+properties (SetAccess = private)
+    handle = []
+end
+
+methods
+    function M = DaceModel(S, Y, regr, corr, theta0, varargin)
+        lob = [];  upb = [];
+        if numel(varargin) >= 2 && ~ischar(varargin{1})
+            lob = varargin{1};  upb = varargin{2};
+            varargin = varargin(3:end);
+        end
+        opt = struct('refit', 0, 'window', 0);
+        for i = 1:2:numel(varargin)
+            opt.(lower(varargin{i})) = varargin{i+1};
+        end
+        [use, rn, cn] = usedacemex('dacemodel_mex', regr, corr);
+        if ~use
+            error('DaceModel needs dacemodel_mex (run buildDaceMex) and the regpoly0/1/2 and corrgauss/correxp/corrspline models');
+        end
+        M.handle = dacemodel_mex('new', S, Y, rn, cn, theta0, lob, upb, ...
+                                 opt.refit, opt.window);
+    end
+
+    function append(M, S, Y)
+        dacemodel_mex('append', M.handle, S, Y);
+    end
+
+    function remove(M)
+        dacemodel_mex('remove', M.handle);
+    end
+
+    function [y, mse] = predict(M, x)
+        if nargout > 1
+            [y, mse] = dacemodel_mex('predict', M.handle, x);
+        else
+            y = dacemodel_mex('predict', M.handle, x);
+        end
+    end
+
+    function dmodel = model(M)
+        dmodel = dacemodel_mex('model', M.handle);
+        dmodel.regr = str2func(dmodel.regr);
+        dmodel.corr = str2func(dmodel.corr);
+    end
+
+    function m = size(M)
+        m = dacemodel_mex('size', M.handle);
+    end
+
+    function delete(M)
+        if ~isempty(M.handle) && exist('dacemodel_mex', 'file') == 3
+            dacemodel_mex('delete', M.handle);
+        end
+    end
+end
+end
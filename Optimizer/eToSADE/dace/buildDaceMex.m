@@ -0,0 +1,35 @@
+function buildDaceMex(varargin)
+%BUILDDACEMEX  Build the compiled Kriging engine used by DACEFIT and PREDICTOR
+%
+% Call:   buildDaceMex()                    % with OpenMP
+%         buildDaceMex('openmp', false)     % serial
+%         buildDaceMex('lapack', true)      % factorise R with LAPACK dpotrf
+%
+% The sources are in the native directory, and the MEX files dacefit_mex,
+% predictor_mex, dacemodel_mex and dacelikelihood_mex are placed next to
+% this file. Once they exist, DACEFIT and PREDICTOR use them for the
+% regpoly0/1/2 and corrgauss/correxp/corrspline models, and fall back to
+% the MATLAB code otherwise. DACEMODEL and DACELIKELIHOOD require them.
+
+opt = struct('openmp', true, 'lapack', false);
+for i = 1:2:numel(varargin)
+    opt.(lower(varargin{i})) = varargin{i+1};
+end
+here = fileparts(mfilename('fullpath'));
+src = fullfile(here, 'native');
+flags = {'-outdir', here, ['-I', src]};
+if opt.openmp
+    if ispc
+        flags = [flags, {'COMPFLAGS=$COMPFLAGS /openmp'}];
+    elseif ismac
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -Xpreprocessor -fopenmp', 'LDFLAGS=$LDFLAGS -lomp'}];
+    else
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -fopenmp', 'LDFLAGS=$LDFLAGS -fopenmp'}];
+    end
+end
+if opt.lapack
+    flags = [flags, {'-DUSE_LAPACK', '-lmwlapack'}];
+end
+for f = {'dacefit_mex', 'predictor_mex', 'dacemodel_mex', 'dacelikelihood_mex'}
+    mex(flags{:}, fullfile(src, [f{1}, '.cpp']), fullfile(src, 'dace.cpp'));
+end
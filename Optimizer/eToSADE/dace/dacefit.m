@@ -59,6 +59,18 @@ else  % given theta
     error('theta0 must be strictly positive'), end
 end
 
+% Use the compiled engine when it is built, see buildDaceMex
+[usemex, rn, cn] = usedacemex('dacefit_mex', regr, corr);
+if  usemex
+  if  nargin > 5
+    [dmodel, perf] = dacefit_mex(S, Y, rn, cn, theta0, lob, upb);
+  else
+    [dmodel, perf] = dacefit_mex(S, Y, rn, cn, theta0);
+  end
+  dmodel.regr = regr;   dmodel.corr = corr;
+  return
+end
+
 % Normalize data
 mS = mean(S);   sS = std(S);
 mY = mean(Y);   sY = std(Y);
@@ -0,0 +1,28 @@
+function  [lnL, dlnL, psi] = dacelikelihood(S, Y, regr, corr, Theta)
+%DACELIKELIHOOD  Kriging likelihood for a batch of correlation parameters
+%
+% Call:   lnL = dacelikelihood(S, Y, regr, corr, Theta)
+%         [lnL, dlnL, psi] = dacelikelihood(S, Y, regr, corr, Theta)
+%
+% Input
+% S, Y    : Data points and responses as in DACEFIT
+% regr    : Regression model, regpoly0/1/2
+% corr    : Correlation model, corrgauss/correxp/corrspline
+% Theta   : Candidate correlation parameters, one per row
+%
+% Output
+% lnL     : Concentrated log-likelihood of the data normalised as in
+%           DACEFIT, -Inf where the correlation matrix is not positive
+%           definite
+% dlnL    : Gradient of lnL with respect to theta, one row per candidate
+% psi     : The objective that DACEFIT minimises over theta
+%
+% The pairwise site differences are computed once for all candidates,
+% which are evaluated in parallel. Uses the compiled engine, see
+% BUILDDACEMEX.
+
+[use, rn, cn] = usedacemex('dacelikelihood_mex', regr, corr);
+if  ~use
+  error('DACELIKELIHOOD needs dacelikelihood_mex (run buildDaceMex) and the regpoly0/1/2 and corrgauss/correxp/corrspline models')
+end
+[lnL, dlnL, psi] = dacelikelihood_mex(S, Y, rn, cn, Theta);
@@ -0,0 +1,1598 @@
+/*
+  Native Kriging engine, see dace.h.
+
+  Optional build flags:
+  -fopenmp     assemble R, factorise it and evaluate the predictor sites and
+               likelihood candidates in parallel
+  -DUSE_LAPACK factorise R with LAPACK dpotrf (-lmwlapack in MATLAB)
+*/
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef USE_LAPACK
+#include "lapack.h"
+#endif
+#include "dace.h"
+
+namespace dace {
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+const double LOG_2PI = 1.8378770664093454836;
+
+/* Column block of the Cholesky factorisation */
+const int CHOL_BLOCK = 64;
+
+/* Largest number of cached site differences (256 MB) */
+const size_t DIFF_CACHE_MAX = (size_t)1 << 25;
+
+/* --------------------------------------------------------------------- */
+/* Regression and correlation models                                     */
+/* --------------------------------------------------------------------- */
+
+/* f [p] at the scaled site x [n], as regpoly0/1/2.m */
+void regression(Regression regr, const double *x, int n, double *f)
+{
+    int j = n + 1;
+    f[0] = 1.0;
+    if (regr == REGPOLY0) {
+        return;
+    }
+    for (int k = 0; k < n; k++) {
+        f[1 + k] = x[k];
+    }
+    if (regr == REGPOLY1) {
+        return;
+    }
+    for (int k = 0; k < n; k++) {
+        for (int l = k; l < n; l++) {
+            f[j++] = x[k] * x[l];
+        }
+    }
+}
+
+/* Jacobian df [n x p] of the regression functions at x */
+void regressionJacobian(Regression regr, const double *x, int n, int p, double *df)
+{
+    std::fill(df, df + (size_t)n * p, 0.0);
+    if (regr == REGPOLY0) {
+        return;
+    }
+    for (int k = 0; k < n; k++) {
+        df[k + (1 + k) * n] = 1.0;
+    }
+    if (regr == REGPOLY1) {
+        return;
+    }
+    int c = n + 1;
+    for (int k = 0; k < n; k++) {
+        for (int l = k; l < n; l++, c++) {
+            if (l == k) {
+                df[k + c * n] = 2.0 * x[k];
+            } else {
+                df[k + c * n] = x[l];
+                df[l + c * n] = x[k];
+            }
+        }
+    }
+}
+
+/* Correlation r(theta, d) of the difference d [n], and if dr is not NULL
+   its gradient dr [n], as corrgauss/correxp/corrspline.m. theta has one
+   entry (isotropic) or n. */
+double correlation(Correlation corr, const double *theta, int lth,
+                   const double *d, int n, double *dr)
+{
+    double s = 0.0, r;
+    switch (corr) {
+    case CORRGAUSS:
+        for (int k = 0; k < n; k++) {
+            s += d[k] * d[k] * -theta[lth == 1 ? 0 : k];
+        }
+        r = std::exp(s);
+        if (dr != NULL) {
+            for (int k = 0; k < n; k++) {
+                dr[k] = -2.0 * theta[lth == 1 ? 0 : k] * d[k] * r;
+            }
+        }
+        return r;
+    case CORREXP:
+        for (int k = 0; k < n; k++) {
+            s += std::fabs(d[k]) * -theta[lth == 1 ? 0 : k];
+        }
+        r = std::exp(s);
+        if (dr != NULL) {
+            for (int k = 0; k < n; k++) {
+                const double sg = d[k] > 0.0 ? 1.0 : (d[k] < 0.0 ? -1.0 : 0.0);
+                dr[k] = -theta[lth == 1 ? 0 : k] * sg * r;
+            }
+        }
+        return r;
+    case CORRSPLINE:
+    default:
+        r = 1.0;
+        for (int k = 0; k < n; k++) {
+            const double xi = std::fabs(d[k]) * theta[lth == 1 ? 0 : k];
+            double ss = 0.0;
+            if (xi <= 0.2) {
+                ss = 1.0 - xi * xi * (15.0 - 30.0 * xi);
+            } else if (xi < 1.0) {
+                ss = 1.25 * (1.0 - xi) * (1.0 - xi) * (1.0 - xi);
+            }
+            r *= ss;
+        }
+        if (dr != NULL) {
+            /* dr_j is the product of the factors with the j-th replaced by
+               its derivative; recomputed per j as in corrspline.m, since
+               factors may be zero */
+            for (int j = 0; j < n; j++) {
+                double pr = 1.0;
+                for (int k = 0; k < n; k++) {
+                    const double th = theta[lth == 1 ? 0 : k];
+                    const double xi = std::fabs(d[k]) * th;
+                    double v = 0.0;
+                    if (k == j) {
+                        const double u = (d[k] > 0.0 ? 1.0 : (d[k] < 0.0 ? -1.0 : 0.0)) * th;
+                        if (xi <= 0.2) {
+                            v = u * ((90.0 * xi - 30.0) * xi);
+                        } else if (xi < 1.0) {
+                            v = -3.75 * u * (1.0 - xi) * (1.0 - xi);
+                        }
+                    } else if (xi <= 0.2) {
+                        v = 1.0 - xi * xi * (15.0 - 30.0 * xi);
+                    } else if (xi < 1.0) {
+                        v = 1.25 * (1.0 - xi) * (1.0 - xi) * (1.0 - xi);
+                    }
+                    pr *= v;
+                }
+                dr[j] = pr;
+            }
+        }
+        return r;
+    }
+}
+
+/* Derivatives dt [lth] of r(theta, d) with respect to theta */
+void correlationTheta(Correlation corr, const double *theta, int lth,
+                      const double *d, int n, double *dt)
+{
+    std::fill(dt, dt + lth, 0.0);
+    switch (corr) {
+    case CORRGAUSS:
+    case CORREXP: {
+        const double r = correlation(corr, theta, lth, d, n, NULL);
+        for (int k = 0; k < n; k++) {
+            const double a = corr == CORRGAUSS ? d[k] * d[k] : std::fabs(d[k]);
+            dt[lth == 1 ? 0 : k] -= a * r;
+        }
+        return;
+    }
+    case CORRSPLINE:
+    default: {
+        /* d/dtheta_k of the k-th factor times the product of the others,
+           the latter from prefix and suffix products since factors may be
+           zero */
+        double ss[64], ds[64], pre[65];
+        std::vector<double> big;
+        double *s = ss, *sd = ds, *pr = pre;
+        if (n > 64) {
+            big.resize(3 * (size_t)n + 1);
+            s = big.data();
+            sd = s + n;
+            pr = sd + n;
+        }
+        pr[0] = 1.0;
+        for (int k = 0; k < n; k++) {
+            const double a = std::fabs(d[k]), xi = a * theta[lth == 1 ? 0 : k];
+            s[k] = sd[k] = 0.0;
+            if (xi <= 0.2) {
+                s[k] = 1.0 - xi * xi * (15.0 - 30.0 * xi);
+                sd[k] = a * (90.0 * xi - 30.0) * xi;
+            } else if (xi < 1.0) {
+                s[k] = 1.25 * (1.0 - xi) * (1.0 - xi) * (1.0 - xi);
+                sd[k] = -3.75 * a * (1.0 - xi) * (1.0 - xi);
+            }
+            pr[k + 1] = pr[k] * s[k];
+        }
+        double suf = 1.0;
+        for (int k = n - 1; k >= 0; k--) {
+            dt[lth == 1 ? 0 : k] += pr[k] * sd[k] * suf;
+            suf *= s[k];
+        }
+        return;
+    }
+    }
+}
+
+/* Differences S(j,:) - S(i,:) of all pairs of scaled design sites i > j,
+   the D matrix of dacefit.m, computed once per training set and shared by
+   all evaluations of the objective. Above DIFF_CACHE_MAX values the pairs
+   are formed on demand instead. */
+class Differences
+{
+public:
+    Differences(const std::vector<double> &S, int m, int n)
+        : m_(m), n_(n), Srow_((size_t)m * n)
+    {
+        for (int i = 0; i < m; i++) {
+            for (int k = 0; k < n; k++) {
+                Srow_[(size_t)i * n + k] = S[i + (size_t)k * m];
+            }
+        }
+        const size_t pairs = (size_t)m * (m - 1) / 2;
+        if (pairs * n <= DIFF_CACHE_MAX) {
+            D_.resize(pairs * n);
+#pragma omp parallel for schedule(dynamic, 16)
+            for (int j = 0; j < m; j++) {
+                for (int i = j + 1; i < m; i++) {
+                    diff(i, j, D_.data() + pair(i, j) * n);
+                }
+            }
+        }
+    }
+
+    int m() const { return m_; }
+    int n() const { return n_; }
+
+    /* d [n] of the pair (i, j), i > j; buf [n] is used if it is not cached */
+    const double *get(int i, int j, double *buf) const
+    {
+        if (D_.empty()) {
+            diff(i, j, buf);
+            return buf;
+        }
+        return D_.data() + pair(i, j) * n_;
+    }
+
+private:
+    size_t pair(int i, int j) const
+    {
+        return (size_t)j * (2 * (size_t)m_ - j - 1) / 2 + (i - j - 1);
+    }
+
+    void diff(int i, int j, double *d) const
+    {
+        const double *si = Srow_.data() + (size_t)i * n_, *sj = Srow_.data() + (size_t)j * n_;
+        for (int k = 0; k < n_; k++) {
+            d[k] = sj[k] - si[k];
+        }
+    }
+
+    int m_, n_;
+    std::vector<double> Srow_, D_;
+};
+
+/* --------------------------------------------------------------------- */
+/* Dense linear algebra on column-major matrices                         */
+/* --------------------------------------------------------------------- */
+
+/* In-place lower Cholesky factor of the symmetric A [m x m], of which only
+   the lower triangle is read. Returns false if A is not positive definite. */
+bool cholesky(double *A, int m)
+{
+#ifdef USE_LAPACK
+    ptrdiff_t mm = m, info = 0;
+    dpotrf("L", &mm, A, &mm, &info);
+    return info == 0;
+#else
+    /* Left-looking by column blocks: update the block column with all
+       previous columns, then factorise it. The update runs down whole
+       columns and is split over row ranges. */
+    const size_t ld = m;
+    for (int jb = 0; jb < m; jb += CHOL_BLOCK) {
+        const int je = std::min(jb + CHOL_BLOCK, m);
+        if (jb > 0) {
+#pragma omp parallel for schedule(static) if ((size_t)(m - jb) * jb > 65536)
+            for (int ib = jb; ib < m; ib += CHOL_BLOCK) {
+                const int ie = std::min(ib + CHOL_BLOCK, m);
+                int k = 0;
+                for (; k + 4 <= jb; k += 4) {
+                    /* four columns at a time to save loads and stores of A */
+                    const double *L0 = A + k * ld, *L1 = L0 + ld, *L2 = L1 + ld, *L3 = L2 + ld;
+                    for (int c = jb; c < je; c++) {
+                        const double l0 = L0[c], l1 = L1[c], l2 = L2[c], l3 = L3[c];
+                        double *Ac = A + c * ld;
+                        for (int i = std::max(ib, c); i < ie; i++) {
+                            Ac[i] -= L0[i] * l0 + L1[i] * l1 + L2[i] * l2 + L3[i] * l3;
+                        }
+                    }
+                }
+                for (; k < jb; k++) {
+                    const double *Lk = A + k * ld;
+                    for (int c = jb; c < je; c++) {
+                        const double lck = Lk[c];
+                        double *Ac = A + c * ld;
+                        for (int i = std::max(ib, c); i < ie; i++) {
+                            Ac[i] -= Lk[i] * lck;
+                        }
+                    }
+                }
+            }
+        }
+        for (int j = jb; j < je; j++) {
+            double *Aj = A + j * ld;
+            const double d = Aj[j];
+            if (!(d > 0.0)) {
+                return false;
+            }
+            Aj[j] = std::sqrt(d);
+            for (int i = j + 1; i < m; i++) {
+                Aj[i] /= Aj[j];
+            }
+            for (int c = j + 1; c < je; c++) {
+                const double lcj = Aj[c];
+                double *Ac = A + c * ld;
+                for (int i = c; i < m; i++) {
+                    Ac[i] -= Aj[i] * lcj;
+                }
+            }
+        }
+    }
+    return true;
+#endif
+}
+
+/* Solve L x = b in place for the lower triangular L [m x m] */
+void forwardSolve(const double *L, int m, double *x)
+{
+    const size_t ld = m;
+    for (int j = 0; j < m; j++) {
+        const double *Lj = L + j * ld;
+        const double xj = (x[j] /= Lj[j]);
+        for (int i = j + 1; i < m; i++) {
+            x[i] -= Lj[i] * xj;
+        }
+    }
+}
+
+/* Solve L' x = b in place for the lower triangular L [m x m] */
+void backSolveTransposed(const double *L, int m, double *x)
+{
+    const size_t ld = m;
+    for (int j = m - 1; j >= 0; j--) {
+        const double *Lj = L + j * ld;
+        double s = x[j];
+        for (int i = j + 1; i < m; i++) {
+            s -= Lj[i] * x[i];
+        }
+        x[j] = s / Lj[j];
+    }
+}
+
+/* Solve U x = b in place for the upper triangular U [p x p] */
+void backSolveUpper(const double *U, int p, double *x)
+{
+    for (int j = p - 1; j >= 0; j--) {
+        x[j] /= U[j + j * p];
+        for (int i = 0; i < j; i++) {
+            x[i] -= U[i + j * p] * x[j];
+        }
+    }
+}
+
+/* Lower triangle of R^-1 = C^-T C^-1 from the lower Cholesky factor C
+   [m x m]; W [m x m] is workspace for C^-1 */
+void choleskyInverse(const double *C, int m, double *W, double *Rinv)
+{
+    const size_t ld = m;
+#pragma omp parallel for schedule(dynamic, 8) if (m > 128)
+    for (int j = 0; j < m; j++) {
+        double *w = W + j * ld;
+        std::fill(w, w + m, 0.0);
+        w[j] = 1.0;
+        for (int k = j; k < m; k++) {
+            const double *Ck = C + k * ld;
+            const double wk = (w[k] /= Ck[k]);
+            for (int i = k + 1; i < m; i++) {
+                w[i] -= Ck[i] * wk;
+            }
+        }
+    }
+#pragma omp parallel for schedule(dynamic, 8) if (m > 128)
+    for (int j = 0; j < m; j++) {
+        const double *wj = W + j * ld;
+        for (int i = j; i < m; i++) {
+            const double *wi = W + i * ld;
+            double s = 0.0;
+            for (int k = i; k < m; k++) {
+                s += wi[k] * wj[k];
+            }
+            Rinv[i + j * ld] = s;
+        }
+    }
+}
+
+/* L*L' + v*v' for the lower triangular L [m x m] by Givens rotations; v is
+   overwritten */
+void choleskyUpdate(double *L, int m, double *v)
+{
+    const size_t mm = m;
+    for (int k = 0; k < m; k++) {
+        double *Lk = L + k * mm;
+        const double r = std::hypot(Lk[k], v[k]);
+        const double c = r / Lk[k], s = v[k] / Lk[k];
+        Lk[k] = r;
+        for (int i = k + 1; i < m; i++) {
+            Lk[i] = (Lk[i] + s * v[i]) / c;
+            v[i] = c * v[i] - s * Lk[i];
+        }
+    }
+}
+
+/* Householder QR of A [m x p], m >= p, in the LAPACK dgeqrf convention:
+   R is left in the upper triangle, the reflectors below it and in tau. */
+void householderQR(double *A, int m, int p, double *tau)
+{
+    for (int k = 0; k < p; k++) {
+        double *ak = A + (size_t)k * m;
+        double xnorm = 0.0;
+        for (int i = k + 1; i < m; i++) {
+            xnorm = std::hypot(xnorm, ak[i]);
+        }
+        if (xnorm == 0.0) {
+            tau[k] = 0.0;
+            continue;
+        }
+        const double alpha = ak[k];
+        const double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+        tau[k] = (beta - alpha) / beta;
+        for (int i = k + 1; i < m; i++) {
+            ak[i] /= alpha - beta;
+        }
+        ak[k] = beta;
+        for (int c = k + 1; c < p; c++) {
+            double *ac = A + (size_t)c * m;
+            double s = ac[k];
+            for (int i = k + 1; i < m; i++) {
+                s += ak[i] * ac[i];
+            }
+            s *= tau[k];
+            ac[k] -= s;
+            for (int i = k + 1; i < m; i++) {
+                ac[i] -= s * ak[i];
+            }
+        }
+    }
+}
+
+/* y := Q' y with the reflectors of householderQR */
+void applyQt(const double *A, int m, int p, const double *tau, double *y)
+{
+    for (int k = 0; k < p; k++) {
+        const double *ak = A + (size_t)k * m;
+        double s = y[k];
+        for (int i = k + 1; i < m; i++) {
+            s += ak[i] * y[i];
+        }
+        s *= tau[k];
+        y[k] -= s;
+        for (int i = k + 1; i < m; i++) {
+            y[i] -= s * ak[i];
+        }
+    }
+}
+
+/* Reciprocal 1-norm condition number of the upper triangle of R [p x p]
+   (leading dimension ld), computed from the exact inverse. */
+double rcondUpper(const double *R, int p, int ld)
+{
+    double normR = 0.0, normInv = 0.0;
+    std::vector<double> e(p);
+    for (int j = 0; j < p; j++) {
+        if (R[j + (size_t)j * ld] == 0.0) {
+            return 0.0;
+        }
+        double s = 0.0;
+        for (int i = 0; i <= j; i++) {
+            s += std::fabs(R[i + (size_t)j * ld]);
+        }
+        normR = std::max(normR, s);
+    }
+    for (int j = 0; j < p; j++) {
+        /* column j of inv(R) solves R e = unit vector j */
+        std::fill(e.begin(), e.end(), 0.0);
+        e[j] = 1.0;
+        double s = 0.0;
+        for (int c = j; c >= 0; c--) {
+            e[c] /= R[c + (size_t)c * ld];
+            for (int i = 0; i < c; i++) {
+                e[i] -= R[i + (size_t)c * ld] * e[c];
+            }
+        }
+        for (int i = 0; i <= j; i++) {
+            s += std::fabs(e[i]);
+        }
+        normInv = std::max(normInv, s);
+    }
+    return 1.0 / (normR * normInv);
+}
+
+/* --------------------------------------------------------------------- */
+/* Likelihood objective and the boxmin search of dacefit.m               */
+/* --------------------------------------------------------------------- */
+
+/* Workspace of glsSolve */
+struct GlsWork {
+    std::vector<double> qr, tau, Gu, qty;
+};
+
+/* Generalised least squares step of objfunc in dacefit.m, from the
+   decorrelated regression matrix Ft [m x p] and responses Yt [m x q]
+   (overwritten): beta [p x q], sigma2 [q] of the scaled responses,
+   gamma = rho' / C [q x m] and G [p x p], the transposed triangular factor
+   of Ft. Returns false if rcond(G) < 1e-10. */
+bool glsSolve(const double *C, const double *Ft, double *Yt, int m, int p, int q,
+              GlsWork &w, double *beta, double *sigma2, double *gamma, double *G)
+{
+    const size_t mm = m;
+    w.qr.assign(Ft, Ft + mm * p);
+    w.tau.resize(p);
+    w.qty.resize(m);
+    householderQR(w.qr.data(), m, p, w.tau.data());
+    if (rcondUpper(w.qr.data(), p, m) < 1e-10) {
+        return false;
+    }
+    w.Gu.assign((size_t)p * p, 0.0);
+    for (int j = 0; j < p; j++) {
+        for (int i = 0; i <= j; i++) {
+            w.Gu[i + (size_t)j * p] = w.qr[i + (size_t)j * m];
+            G[j + (size_t)i * p] = w.qr[i + (size_t)j * m];
+        }
+        for (int i = j + 1; i < p; i++) {
+            G[j + (size_t)i * p] = 0.0;
+        }
+    }
+    for (int l = 0; l < q; l++) {
+        /* beta = G \ (Q'*Yt), rho = Yt - Ft*beta, gamma = rho' / C */
+        double *yt = Yt + l * mm, *b = beta + (size_t)l * p;
+        std::copy(yt, yt + m, w.qty.begin());
+        applyQt(w.qr.data(), m, p, w.tau.data(), w.qty.data());
+        std::copy(w.qty.begin(), w.qty.begin() + p, b);
+        backSolveUpper(w.Gu.data(), p, b);
+        double s = 0.0;
+        for (int i = 0; i < m; i++) {
+            double fb = 0.0;
+            for (int c = 0; c < p; c++) {
+                fb += Ft[i + c * mm] * b[c];
+            }
+            yt[i] -= fb;
+            s += yt[i] * yt[i];
+        }
+        sigma2[l] = s / m;
+        backSolveTransposed(C, m, yt);
+        for (int i = 0; i < m; i++) {
+            gamma[l + (size_t)i * q] = yt[i];
+        }
+    }
+    return true;
+}
+
+struct Fit {
+    std::vector<double> C, Ft, G, beta, gamma, sigma2;
+};
+
+/* Regularisation of R for m design sites, as in dacefit.m */
+double diagonalShift(int m)
+{
+    return (10 + m) * DBL_EPSILON;
+}
+
+/* objfunc of dacefit.m with its workspace, which is reused over all
+   evaluations of one fit */
+class Objective
+{
+public:
+    Objective(const Differences &D, const std::vector<double> &Y,
+              const std::vector<double> &F, int q, int p, Correlation corr, int lth)
+        : D_(D), Y_(Y), F_(F), m_(D.m()), n_(D.n()), q_(q), p_(p), corr_(corr),
+          lth_(lth), rho_((size_t)D.m() * q), condF_(-1.0)
+    {
+    }
+
+    /* psi(theta) and the corresponding fit, INF if R is not positive
+       definite or the decorrelated regression matrix is too ill
+       conditioned */
+    double operator()(const double *theta, Fit &fit)
+    {
+        const int m = m_, n = n_, q = q_, p = p_;
+        const size_t mm = m;
+        fit.C.resize(mm * m);
+        fit.Ft.resize(mm * p);
+        fit.G.resize((size_t)p * p);
+        fit.beta.resize((size_t)p * q);
+        fit.gamma.resize((size_t)q * m);
+        fit.sigma2.resize(q);
+
+        /* R, with (10 + m) eps added to the diagonal */
+        double *C = fit.C.data();
+        const double mu = diagonalShift(m);
+#pragma omp parallel
+        {
+            std::vector<double> d(n);
+#pragma omp for schedule(dynamic, 16)
+            for (int j = 0; j < m; j++) {
+                double *Cj = C + j * mm;
+                std::fill(Cj, Cj + j, 0.0);
+                Cj[j] = 1.0 + mu;
+                for (int i = j + 1; i < m; i++) {
+                    Cj[i] = correlation(corr_, theta, lth_, D_.get(i, j, d.data()), n, NULL);
+                }
+            }
+        }
+        if (!cholesky(C, m)) {
+            return INF;
+        }
+
+        /* Ft = C \ F, Yt = C \ Y */
+        std::copy(F_.begin(), F_.end(), fit.Ft.begin());
+        std::copy(Y_.begin(), Y_.end(), rho_.begin());
+#pragma omp parallel for schedule(static) if (p + q > 1 && mm * m > 65536)
+        for (int c = 0; c < p + q; c++) {
+            forwardSolve(C, m, c < p ? fit.Ft.data() + c * mm : rho_.data() + (c - p) * mm);
+        }
+        if (!glsSolve(C, fit.Ft.data(), rho_.data(), m, p, q, gls_, fit.beta.data(),
+                      fit.sigma2.data(), fit.gamma.data(), fit.G.data())) {
+            if (conditionF() > 1e15) {
+                throw std::runtime_error("F is too ill conditioned\n"
+                                         "Poor combination of regression model and design sites");
+            }
+            return INF;
+        }
+        double obj = 0.0, detR = 1.0;
+        for (int l = 0; l < q; l++) {
+            obj += fit.sigma2[l];
+        }
+        for (int j = 0; j < m; j++) {
+            detR *= std::pow(C[j + j * mm], 2.0 / m);
+        }
+        obj *= detR;
+        return obj;
+    }
+
+    /* Concentrated log-likelihood of the normalised data for the fit of
+       theta by operator(), and if grad is not NULL its gradient [lth]:
+       with gamma = R^-1 rho,
+         d lnL / d theta = 1/2 sum_l gamma_l' dR gamma_l / sigma2_l
+                           - q/2 trace(R^-1 dR) */
+    double logLikelihood(const double *theta, const Fit &fit, double *grad)
+    {
+        const int m = m_, n = n_, q = q_, lth = lth_;
+        const size_t mm = m;
+        double lnL = 0.0, logdetR = 0.0;
+        for (int l = 0; l < q; l++) {
+            lnL += std::log(fit.sigma2[l]);
+        }
+        for (int j = 0; j < m; j++) {
+            logdetR += 2.0 * std::log(fit.C[j + j * mm]);
+        }
+        lnL = -0.5 * (m * lnL + q * logdetR + m * q * (1.0 + LOG_2PI));
+        if (grad == NULL) {
+            return lnL;
+        }
+
+        Rinv_.resize(mm * m);
+        W_.resize(mm * m);
+        choleskyInverse(fit.C.data(), m, W_.data(), Rinv_.data());
+        std::fill(grad, grad + lth, 0.0);
+#pragma omp parallel
+        {
+            std::vector<double> d(n), dt(lth), g(lth, 0.0);
+#pragma omp for schedule(dynamic, 16)
+            for (int j = 0; j < m; j++) {
+                for (int i = j + 1; i < m; i++) {
+                    /* Both triangles of the symmetric dR */
+                    double w = -q * Rinv_[i + j * mm];
+                    for (int l = 0; l < q; l++) {
+                        w += fit.gamma[l + (size_t)i * q] * fit.gamma[l + (size_t)j * q] / fit.sigma2[l];
+                    }
+                    correlationTheta(corr_, theta, lth, D_.get(i, j, d.data()), n, dt.data());
+                    for (int k = 0; k < lth; k++) {
+                        g[k] += w * dt[k];
+                    }
+                }
+            }
+#pragma omp critical
+            for (int k = 0; k < lth; k++) {
+                grad[k] += g[k];
+            }
+        }
+        return lnL;
+    }
+
+private:
+    /* 1-norm condition of F, evaluated once when needed. dacefit.m uses
+       the 2-norm condition number here. */
+    double conditionF()
+    {
+        if (condF_ < 0.0) {
+            std::vector<double> A(F_), t(p_);
+            householderQR(A.data(), m_, p_, t.data());
+            const double rc = rcondUpper(A.data(), p_, m_);
+            condF_ = rc > 0.0 ? 1.0 / rc : INF;
+        }
+        return condF_;
+    }
+
+    const Differences &D_;
+    const std::vector<double> &Y_, &F_;
+    int m_, n_, q_, p_;
+    Correlation corr_;
+    int lth_;
+    std::vector<double> rho_, Rinv_, W_;
+    GlsWork gls_;
+    double condF_;
+};
+
+/* Iteration state of boxmin (itpar in dacefit.m) */
+struct BoxminState {
+    std::vector<double> D, lo, up;
+    std::vector<int> ne;
+    std::vector<double> perf;
+    int nv;
+    int p;
+
+    void record(const std::vector<double> &t, double f, double type)
+    {
+        perf.insert(perf.end(), t.begin(), t.end());
+        perf.push_back(f);
+        perf.push_back(type);
+        nv++;
+    }
+    void markLast(double type)
+    {
+        perf.back() = type;
+    }
+};
+
+class Boxmin
+{
+public:
+    Boxmin(Objective &objective) : objective_(objective) {}
+
+    /* Minimise psi over lo <= t <= up, starting from t0 */
+    double run(const double *t0, const double *lo, const double *up, int p,
+               std::vector<double> &t, Fit &fit, Performance *perf)
+    {
+        double f = start(t0, lo, up, p, t, fit);
+        if (f != INF) {
+            const int kmax = p <= 2 ? 2 : std::min(p, 4);
+            for (int k = 0; k < kmax; k++) {
+                std::vector<double> th(t);
+                f = explore(t, f, fit);
+                f = move(th, t, f, fit);
+            }
+        }
+        if (perf != NULL) {
+            perf->nv = it_.nv;
+            perf->perf = it_.perf;
+        }
+        return f;
+    }
+
+private:
+    double evaluate(const std::vector<double> &t)
+    {
+        return objective_(t.data(), trial_);
+    }
+
+    void accept(Fit &fit)
+    {
+        std::swap(fit, trial_);
+    }
+
+    double start(const double *t0, const double *lo, const double *up, int p,
+                 std::vector<double> &t, Fit &fit)
+    {
+        std::vector<int> ng;
+        t.assign(t0, t0 + p);
+        it_.p = p;
+        it_.lo.assign(lo, lo + p);
+        it_.up.assign(up, up + p);
+        it_.D.resize(p);
+        for (int k = 0; k < p; k++) {
+            it_.D[k] = std::pow(2.0, (k + 1.0) / (p + 2));
+        }
+        for (int k = 0; k < p; k++) {
+            if (up[k] == lo[k]) {
+                it_.D[k] = 1.0;
+                t[k] = up[k];
+            }
+        }
+        for (int k = 0; k < p; k++) {
+            if (t[k] < lo[k] || up[k] < t[k]) {
+                ng.push_back(k);
+                t[k] = std::pow(lo[k] * std::pow(up[k], 7.0), 1.0 / 8.0);
+            }
+        }
+        it_.ne.clear();
+        for (int k = 0; k < p; k++) {
+            if (it_.D[k] != 1.0) {
+                it_.ne.push_back(k);
+            }
+        }
+
+        double f = objective_(t.data(), fit);
+        it_.nv = 0;
+        it_.perf.clear();
+        it_.record(t, f, 1);
+        if (f == INF) {
+            return f;
+        }
+
+        if (ng.size() > 1) {
+            /* Try to improve the starting guess */
+            const double d0 = 16.0, d1 = 2.0;
+            std::vector<double> th(t), DD(p), v(p), tk, tt;
+            const double fh = f;
+            int jdom = ng[0];
+            for (size_t kk = 0; kk < ng.size(); kk++) {
+                const int j = ng[kk];
+                double fk = fh;
+                std::fill(DD.begin(), DD.end(), 1.0);
+                for (size_t i = 0; i < ng.size(); i++) {
+                    DD[ng[i]] = 1.0 / d1;
+                }
+                DD[j] = 1.0 / d0;
+                double alpha = INF;
+                for (size_t i = 0; i < ng.size(); i++) {
+                    const int g = ng[i];
+                    alpha = std::min(alpha, std::log(lo[g] / th[g]) / std::log(DD[g]));
+                }
+                alpha /= 5.0;
+                for (int i = 0; i < p; i++) {
+                    v[i] = std::pow(DD[i], alpha);
+                }
+                tk = th;
+                for (int rept = 0; rept < 4; rept++) {
+                    tt = tk;
+                    for (int i = 0; i < p; i++) {
+                        tt[i] *= v[i];
+                    }
+                    const double ff = evaluate(tt);
+                    it_.record(tt, ff, 1);
+                    if (ff <= fk) {
+                        tk = tt;
+                        fk = ff;
+                        if (ff <= f) {
+                            t = tt;
+                            f = ff;
+                            accept(fit);
+                            jdom = j;
+                        }
+                    } else {
+                        it_.markLast(-1);
+                        break;
+                    }
+                }
+            }
+            if (jdom > 0) {
+                std::swap(it_.D[0], it_.D[jdom]);
+            }
+        }
+        return f;
+    }
+
+    double explore(std::vector<double> &t, double f, Fit &fit)
+    {
+        for (size_t k = 0; k < it_.ne.size(); k++) {
+            const int j = it_.ne[k];
+            std::vector<double> tt(t);
+            const double DD = it_.D[j];
+            bool atbd;
+            if (t[j] == it_.up[j]) {
+                atbd = true;
+                tt[j] = t[j] / std::sqrt(DD);
+            } else if (t[j] == it_.lo[j]) {
+                atbd = true;
+                tt[j] = t[j] * std::sqrt(DD);
+            } else {
+                atbd = false;
+                tt[j] = std::min(it_.up[j], t[j] * DD);
+            }
+            double ff = evaluate(tt);
+            it_.record(tt, ff, 2);
+            if (ff < f) {
+                t = tt;
+                f = ff;
+                accept(fit);
+            } else {
+                it_.markLast(-2);
+                if (!atbd) {
+                    /* try decrease */
+                    tt[j] = std::max(it_.lo[j], t[j] / DD);
+                    ff = evaluate(tt);
+                    it_.record(tt, ff, 2);
+                    if (ff < f) {
+                        t = tt;
+                        f = ff;
+                        accept(fit);
+                    } else {
+                        it_.markLast(-2);
+                    }
+                }
+            }
+        }
+        return f;
+    }
+
+    double move(const std::vector<double> &th, std::vector<double> &t, double f, Fit &fit)
+    {
+        const int p = it_.p;
+        std::vector<double> v(p), tt(p);
+        bool same = true;
+        for (int i = 0; i < p; i++) {
+            v[i] = t[i] / th[i];
+            same = same && v[i] == 1.0;
+        }
+        if (same) {
+            rotateD(0.2);
+            return f;
+        }
+        /* Proper move */
+        bool rept = true;
+        while (rept) {
+            bool atbd = false;
+            for (int i = 0; i < p; i++) {
+                tt[i] = std::min(it_.up[i], std::max(it_.lo[i], t[i] * v[i]));
+                atbd = atbd || tt[i] == it_.lo[i] || tt[i] == it_.up[i];
+            }
+            const double ff = evaluate(tt);
+            it_.record(tt, ff, 3);
+            if (ff < f) {
+                t = tt;
+                f = ff;
+                accept(fit);
+                for (int i = 0; i < p; i++) {
+                    v[i] *= v[i];
+                }
+            } else {
+                it_.markLast(-3);
+                rept = false;
+            }
+            if (atbd) {
+                rept = false;
+            }
+        }
+        rotateD(0.25);
+        return f;
+    }
+
+    /* D = D([2:p 1]).^e */
+    void rotateD(double e)
+    {
+        std::rotate(it_.D.begin(), it_.D.begin() + 1, it_.D.end());
+        for (int i = 0; i < it_.p; i++) {
+            it_.D[i] = std::pow(it_.D[i], e);
+        }
+    }
+
+    Objective &objective_;
+    Fit trial_;
+    BoxminState it_;
+};
+
+/* Normalised sites (in model.S) and responses Y [m x q], their scalings
+   and the regression matrix F [m x p], the first steps of dacefit.m.
+   Returns p. */
+int prepare(const double *S0, const double *Y0, int m, int n, int q, Regression regr,
+            Model &model, std::vector<double> &Y, std::vector<double> &F)
+{
+    const size_t mm = m;
+    /* Normalize data; a zero standard deviation is replaced by 1 */
+    model.Ssc.assign(2 * (size_t)n, 0.0);
+    model.Ysc.assign(2 * (size_t)q, 0.0);
+    model.S.resize(mm * n);
+    Y.resize(mm * q);
+    for (int pass = 0; pass < 2; pass++) {
+        const double *A = pass == 0 ? S0 : Y0;
+        double *sc = pass == 0 ? model.Ssc.data() : model.Ysc.data();
+        double *out = pass == 0 ? model.S.data() : Y.data();
+        const int nc = pass == 0 ? n : q;
+        for (int k = 0; k < nc; k++) {
+            const double *a = A + k * mm;
+            double mean = 0.0, var = 0.0;
+            for (int i = 0; i < m; i++) {
+                mean += a[i];
+            }
+            mean /= m;
+            for (int i = 0; i < m; i++) {
+                var += (a[i] - mean) * (a[i] - mean);
+            }
+            double sd = m > 1 ? std::sqrt(var / (m - 1)) : 0.0;
+            if (sd == 0.0) {
+                sd = 1.0;
+            }
+            sc[2 * k] = mean;
+            sc[2 * k + 1] = sd;
+            for (int i = 0; i < m; i++) {
+                out[i + k * mm] = (a[i] - mean) / sd;
+            }
+        }
+    }
+
+    /* Multiple design sites make R singular */
+    for (int i = 0; i < m; i++) {
+        for (int j = i + 1; j < m; j++) {
+            int k = 0;
+            while (k < n && model.S[i + k * mm] == model.S[j + k * mm]) {
+                k++;
+            }
+            if (k == n) {
+                throw std::runtime_error("Multiple design sites are not allowed");
+            }
+        }
+    }
+
+    /* Regression matrix */
+    const int p = regressionSize(regr, n);
+    if (p > m) {
+        throw std::runtime_error("least squares problem is underdetermined");
+    }
+    std::vector<double> x(n), f(p);
+    F.resize(mm * p);
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++) {
+            x[k] = model.S[i + k * mm];
+        }
+        regression(regr, x.data(), n, f.data());
+        for (int c = 0; c < p; c++) {
+            F[i + c * mm] = f[c];
+        }
+    }
+    return p;
+}
+
+} // namespace
+
+/* ------------------------------------------------------------------------- */
+
+int regressionFromName(const char *name)
+{
+    std::string s(name != NULL ? name : "");
+    if (!s.empty() && s[0] == '@') {
+        s.erase(0, 1);
+    }
+    if (s == "regpoly0") return REGPOLY0;
+    if (s == "regpoly1") return REGPOLY1;
+    if (s == "regpoly2") return REGPOLY2;
+    return -1;
+}
+
+int correlationFromName(const char *name)
+{
+    std::string s(name != NULL ? name : "");
+    if (!s.empty() && s[0] == '@') {
+        s.erase(0, 1);
+    }
+    if (s == "corrgauss") return CORRGAUSS;
+    if (s == "correxp") return CORREXP;
+    if (s == "corrspline") return CORRSPLINE;
+    return -1;
+}
+
+int regressionSize(Regression regr, int n)
+{
+    switch (regr) {
+    case REGPOLY0:
+        return 1;
+    case REGPOLY1:
+        return n + 1;
+    case REGPOLY2:
+    default:
+        return (n + 1) * (n + 2) / 2;
+    }
+}
+
+ModelData Model::data() const
+{
+    ModelData d;
+    d.regr = regr;
+    d.corr = corr;
+    d.m = m;
+    d.n = n;
+    d.q = q;
+    d.p = p;
+    d.lth = (int)theta.size();
+    d.theta = theta.data();
+    d.beta = beta.data();
+    d.gamma = gamma.data();
+    d.sigma2 = sigma2.data();
+    d.S = S.data();
+    d.Ssc = Ssc.data();
+    d.Ysc = Ysc.data();
+    d.C = C.data();
+    d.Ft = Ft.data();
+    d.G = G.data();
+    return d;
+}
+
+void fit(const double *S0, const double *Y0, int m, int n, int q,
+         Regression regr, Correlation corr, const double *theta0,
+         const double *lob, const double *upb, int lth,
+         Model &model, Performance *perf)
+{
+    if (m < 1 || n < 1 || q < 1) {
+        throw std::invalid_argument("S and Y must be nonempty");
+    }
+    if (lth != 1 && lth != n) {
+        throw std::invalid_argument("Length of theta must be 1 or " + std::to_string(n));
+    }
+    if (lob != NULL) {
+        for (int k = 0; k < lth; k++) {
+            if (lob[k] <= 0 || upb[k] < lob[k]) {
+                throw std::invalid_argument("The bounds must satisfy  0 < lob <= upb");
+            }
+        }
+    } else {
+        for (int k = 0; k < lth; k++) {
+            if (theta0[k] <= 0) {
+                throw std::invalid_argument("theta0 must be strictly positive");
+            }
+        }
+    }
+
+    std::vector<double> Y, F;
+    const int p = prepare(S0, Y0, m, n, q, regr, model, Y, F);
+
+    /* Determine theta */
+    Differences D(model.S, m, n);
+    Objective objective(D, Y, F, q, p, corr, lth);
+    Fit best;
+    double obj;
+    if (lob != NULL) {
+        Boxmin boxmin(objective);
+        obj = boxmin.run(theta0, lob, upb, lth, model.theta, best, perf);
+        if (obj == INF) {
+            throw std::runtime_error("Bad parameter region.  Try increasing  upb");
+        }
+    } else {
+        model.theta.assign(theta0, theta0 + lth);
+        obj = objective(theta0, best);
+        if (perf != NULL) {
+            perf->nv = 1;
+            perf->perf.assign(theta0, theta0 + lth);
+            perf->perf.push_back(obj);
+            perf->perf.push_back(1.0);
+        }
+        if (obj == INF) {
+            throw std::runtime_error("Bad point.  Try increasing theta0");
+        }
+    }
+
+    model.regr = regr;
+    model.corr = corr;
+    model.m = m;
+    model.n = n;
+    model.q = q;
+    model.p = p;
+    model.mu = diagonalShift(m);
+    model.beta.swap(best.beta);
+    model.gamma.swap(best.gamma);
+    model.sigma2.swap(best.sigma2);
+    for (int l = 0; l < q; l++) {
+        model.sigma2[l] *= model.Ysc[2 * l + 1] * model.Ysc[2 * l + 1];
+    }
+    model.C.swap(best.C);
+    model.Ft.swap(best.Ft);
+    model.G.swap(best.G);
+}
+
+void likelihood(const double *S0, const double *Y0, int m, int n, int q,
+                Regression regr, Correlation corr, const double *theta, int lth, int nt,
+                double *lnL, double *dlnL, double *psi)
+{
+    if (m < 1 || n < 1 || q < 1) {
+        throw std::invalid_argument("S and Y must be nonempty");
+    }
+    if (lth != 1 && lth != n) {
+        throw std::invalid_argument("Length of theta must be 1 or " + std::to_string(n));
+    }
+    for (int t = 0; t < nt * lth; t++) {
+        if (!(theta[t] > 0)) {
+            throw std::invalid_argument("theta must be strictly positive");
+        }
+    }
+    Model model;
+    std::vector<double> Y, F;
+    const int p = prepare(S0, Y0, m, n, q, regr, model, Y, F);
+    const Differences D(model.S, m, n);
+
+    /* One workspace per thread; a single candidate is parallelised inside
+       the objective instead */
+    std::string err;
+#pragma omp parallel if (nt > 1)
+    {
+        Objective objective(D, Y, F, q, p, corr, lth);
+        Fit fit;
+#pragma omp for schedule(dynamic, 1)
+        for (int t = 0; t < nt; t++) {
+            const double *th = theta + (size_t)t * lth;
+            double *g = dlnL != NULL ? dlnL + (size_t)t * lth : NULL;
+            double obj = INF;
+            try {
+                obj = objective(th, fit);
+            } catch (const std::exception &e) {
+#pragma omp critical
+                err = e.what();
+            }
+            if (psi != NULL) {
+                psi[t] = obj;
+            }
+            if (obj == INF) {
+                lnL[t] = -INF;
+                if (g != NULL) {
+                    std::fill(g, g + lth, std::numeric_limits<double>::quiet_NaN());
+                }
+            } else {
+                lnL[t] = objective.logLikelihood(th, fit, g);
+            }
+        }
+    }
+    if (!err.empty()) {
+        throw std::runtime_error(err);
+    }
+}
+
+void predict(const ModelData &md, const double *x, int mx,
+             double *y, double *mse, double *dy)
+{
+    const int m = md.m, n = md.n, q = md.q, p = md.p;
+    const size_t mm = m;
+    std::vector<double> Srow(mm * n);
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++) {
+            Srow[(size_t)i * n + k] = md.S[i + k * mm];
+        }
+    }
+#pragma omp parallel if (mx > 1)
+    {
+        std::vector<double> xs(n), d(n), f(p), r(m), rt, u, df, dr, drk;
+        if (mse != NULL) {
+            rt.resize(m);
+            u.resize(p);
+        }
+        if (dy != NULL) {
+            df.resize((size_t)n * p);
+            dr.resize(mm * n);
+            drk.resize(n);
+        }
+#pragma omp for schedule(dynamic, 4)
+        for (int k = 0; k < mx; k++) {
+            /* Normalize the trial site, distances to the design sites */
+            for (int j = 0; j < n; j++) {
+                xs[j] = (x[k + (size_t)j * mx] - md.Ssc[2 * j]) / md.Ssc[2 * j + 1];
+            }
+            regression(md.regr, xs.data(), n, f.data());
+            for (int i = 0; i < m; i++) {
+                const double *si = Srow.data() + (size_t)i * n;
+                for (int j = 0; j < n; j++) {
+                    d[j] = xs[j] - si[j];
+                }
+                r[i] = correlation(md.corr, md.theta, md.lth, d.data(), n,
+                                   dy != NULL ? drk.data() : NULL);
+                if (dy != NULL) {
+                    for (int j = 0; j < n; j++) {
+                        dr[i + j * mm] = drk[j];
+                    }
+                }
+            }
+
+            /* Scaled predictor sy = f*beta + (gamma*r)' */
+            for (int l = 0; l < q; l++) {
+                double sy = 0.0, gr = 0.0;
+                for (int c = 0; c < p; c++) {
+                    sy += f[c] * md.beta[c + (size_t)l * p];
+                }
+                for (int i = 0; i < m; i++) {
+                    gr += md.gamma[l + (size_t)i * q] * r[i];
+                }
+                y[k + (size_t)l * mx] = md.Ysc[2 * l] + md.Ysc[2 * l + 1] * (sy + gr);
+            }
+
+            if (mse != NULL) {
+                /* rt = C \ r, u = G \ (Ft'*rt - f') */
+                std::copy(r.begin(), r.end(), rt.begin());
+                forwardSolve(md.C, m, rt.data());
+                double srt = 0.0, su = 0.0;
+                for (int i = 0; i < m; i++) {
+                    srt += rt[i] * rt[i];
+                }
+                for (int c = 0; c < p; c++) {
+                    double s = 0.0;
+                    for (int i = 0; i < m; i++) {
+                        s += md.Ft[i + c * mm] * rt[i];
+                    }
+                    u[c] = s - f[c];
+                }
+                forwardSolve(md.G, p, u.data());
+                for (int c = 0; c < p; c++) {
+                    su += u[c] * u[c];
+                }
+                for (int l = 0; l < q; l++) {
+                    mse[k + (size_t)l * mx] = md.sigma2[l] * (1.0 + su - srt);
+                }
+            }
+
+            if (dy != NULL) {
+                /* Unscaled Jacobian of (df*beta)' + gamma*dr */
+                regressionJacobian(md.regr, xs.data(), n, p, df.data());
+                double *dyk = dy + (size_t)k * q * n;
+                for (int j = 0; j < n; j++) {
+                    for (int l = 0; l < q; l++) {
+                        double s = 0.0, g = 0.0;
+                        for (int c = 0; c < p; c++) {
+                            s += df[j + (size_t)c * n] * md.beta[c + (size_t)l * p];
+                        }
+                        for (int i = 0; i < m; i++) {
+                            g += md.gamma[l + (size_t)i * q] * dr[i + j * mm];
+                        }
+                        dyk[l + (size_t)j * q] = (s + g) * md.Ysc[2 * l + 1] / md.Ssc[2 * j + 1];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* --------------------------------------------------------------------- */
+/* IncrementalModel                                                      */
+/* --------------------------------------------------------------------- */
+
+IncrementalModel::IncrementalModel(Regression regr, Correlation corr, int refitEvery, int window)
+    : regr_(regr), corr_(corr), refitEvery_(refitEvery), window_(window), appended_(0), fits_(0)
+{
+    if (refitEvery < 0 || window < 0) {
+        throw std::invalid_argument("refitEvery and window must be nonnegative");
+    }
+    model_.m = 0;
+}
+
+void IncrementalModel::fit(const double *S, const double *Y, int m, int n, int q,
+                           const double *theta0, const double *lob, const double *upb, int lth)
+{
+    if (m < 1 || n < 1 || q < 1) {
+        throw std::invalid_argument("S and Y must be nonempty");
+    }
+    if (window_ > 0 && window_ < regressionSize(regr_, n)) {
+        throw std::invalid_argument("window is smaller than the number of regression functions");
+    }
+    const int first = window_ > 0 && m > window_ ? m - window_ : 0;
+    X_.resize((size_t)(m - first) * n);
+    Y_.resize((size_t)(m - first) * q);
+    for (int i = first; i < m; i++) {
+        for (int k = 0; k < n; k++) {
+            X_[(size_t)(i - first) * n + k] = S[i + (size_t)k * m];
+        }
+        for (int l = 0; l < q; l++) {
+            Y_[(size_t)(i - first) * q + l] = Y[i + (size_t)l * m];
+        }
+    }
+    model_.n = n;
+    model_.q = q;
+    if (lob != NULL) {
+        lob_.assign(lob, lob + lth);
+        upb_.assign(upb, upb + lth);
+    } else {
+        lob_.clear();
+        upb_.clear();
+    }
+    appended_ = 0;
+    refit(theta0, lth);
+}
+
+/* dacefit on the stored sites; boxmin starts from theta0 */
+void IncrementalModel::refit(const double *theta0, int lth)
+{
+    const int n = model_.n, q = model_.q, m = (int)(Y_.size() / q);
+    const size_t mm = m;
+    std::vector<double> S(mm * n), Y(mm * q), t0(theta0, theta0 + lth);
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++) {
+            S[i + k * mm] = X_[(size_t)i * n + k];
+        }
+        for (int l = 0; l < q; l++) {
+            Y[i + l * mm] = Y_[(size_t)i * q + l];
+        }
+    }
+    for (int k = 0; k < (int)lob_.size(); k++) {
+        t0[k] = std::min(std::max(t0[k], lob_[k]), upb_[k]);
+    }
+    dace::fit(S.data(), Y.data(), m, n, q, regr_, corr_, t0.data(),
+              lob_.empty() ? NULL : lob_.data(), lob_.empty() ? NULL : upb_.data(),
+              lth, model_, NULL);
+    fits_++;
+
+    /* Scaled regression matrix and responses, Yt = C \ Yn */
+    const int p = model_.p;
+    std::vector<double> x(n), f(p);
+    F_.resize(mm * p);
+    Yn_.resize(mm * q);
+    for (int i = 0; i < m; i++) {
+        for (int k = 0; k < n; k++) {
+            x[k] = model_.S[i + k * mm];
+        }
+        regression(regr_, x.data(), n, f.data());
+        for (int c = 0; c < p; c++) {
+            F_[i + c * mm] = f[c];
+        }
+        for (int l = 0; l < q; l++) {
+            Yn_[i + l * mm] = (Y[i + l * mm] - model_.Ysc[2 * l]) / model_.Ysc[2 * l + 1];
+        }
+    }
+    Yt_ = Yn_;
+    for (int l = 0; l < q; l++) {
+        forwardSolve(model_.C.data(), m, Yt_.data() + l * mm);
+    }
+}
+
+/* beta, gamma, sigma2 and G from C, Ft and Yt; refits if Ft has become too
+   ill conditioned */
+void IncrementalModel::solve()
+{
+    const int m = model_.m, q = model_.q, p = model_.p;
+    std::vector<double> rho(Yt_);
+    GlsWork work;
+    model_.G.resize((size_t)p * p);
+    model_.beta.resize((size_t)p * q);
+    model_.gamma.resize((size_t)q * m);
+    model_.sigma2.resize(q);
+    if (!glsSolve(model_.C.data(), model_.Ft.data(), rho.data(), m, p, q, work,
+                  model_.beta.data(), model_.sigma2.data(), model_.gamma.data(),
+                  model_.G.data())) {
+        refit(model_.theta.data(), (int)model_.theta.size());
+        return;
+    }
+    for (int l = 0; l < q; l++) {
+        model_.sigma2[l] *= model_.Ysc[2 * l + 1] * model_.Ysc[2 * l + 1];
+    }
+}
+
+void IncrementalModel::append(const double *x, const double *y)
+{
+    if (model_.m == 0) {
+        throw std::logic_error("IncrementalModel: fit the model before appending sites");
+    }
+    const int n = model_.n, q = model_.q, p = model_.p;
+    std::vector<double> xs(n);
+    for (int k = 0; k < n; k++) {
+        xs[k] = (x[k] - model_.Ssc[2 * k]) / model_.Ssc[2 * k + 1];
+    }
+    for (int i = 0; i < model_.m; i++) {
+        int k = 0;
+        while (k < n && model_.S[i + k * (size_t)model_.m] == xs[k]) {
+            k++;
+        }
+        if (k == n) {
+            throw std::runtime_error("Multiple design sites are not allowed");
+        }
+    }
+
+    if (window_ > 0 && model_.m >= window_) {
+        removeOldest();
+    }
+    X_.insert(X_.end(), x, x + n);
+    Y_.insert(Y_.end(), y, y + q);
+    appended_++;
+    if (refitEvery_ > 0 && appended_ % refitEvery_ == 0) {
+        refit(model_.theta.data(), (int)model_.theta.size());
+        return;
+    }
+
+    /* New row [l' d] of C from l = C \ r and d^2 = 1 + mu - l'l, with the
+       mu of the last full fit so that R keeps one diagonal shift */
+    const int mo = model_.m;
+    const size_t mmo = mo, mn = mo + 1;
+    const double *C = model_.C.data();
+    std::vector<double> l(mo), d(n), f(p);
+    for (int i = 0; i < mo; i++) {
+        for (int k = 0; k < n; k++) {
+            d[k] = xs[k] - model_.S[i + k * mmo];
+        }
+        l[i] = correlation(corr_, model_.theta.data(), (int)model_.theta.size(), d.data(), n, NULL);
+    }
+    forwardSolve(C, mo, l.data());
+    double d2 = 1.0 + model_.mu;
+    for (int i = 0; i < mo; i++) {
+        d2 -= l[i] * l[i];
+    }
+    if (!(d2 > 0.0)) {
+        refit(model_.theta.data(), (int)model_.theta.size());
+        return;
+    }
+    const double dn = std::sqrt(d2);
+
+    std::vector<double> Cn(mn * mn, 0.0), Sn(mn * n), Ftn(mn * p), Fn(mn * p),
+        Ynn(mn * q), Ytn(mn * q);
+    for (int j = 0; j < mo; j++) {
+        std::copy(C + j * mmo + j, C + (j + 1) * mmo, Cn.data() + j * mn + j);
+        Cn[mo + j * mn] = l[j];
+    }
+    Cn[mo + mo * mn] = dn;
+    regression(regr_, xs.data(), n, f.data());
+    const std::vector<double> *from[] = {&model_.S, &F_, &model_.Ft, &Yn_, &Yt_};
+    std::vector<double> *to[] = {&Sn, &Fn, &Ftn, &Ynn, &Ytn};
+    const int ncols[] = {n, p, p, q, q};
+    for (int a = 0; a < 5; a++) {
+        for (int c = 0; c < ncols[a]; c++) {
+            const double *src = from[a]->data() + c * mmo;
+            std::copy(src, src + mo, to[a]->data() + c * mn);
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        Sn[mo + k * mn] = xs[k];
+    }
+    for (int c = 0; c < p; c++) {
+        double s = f[c];
+        for (int i = 0; i < mo; i++) {
+            s -= l[i] * model_.Ft[i + c * mmo];
+        }
+        Fn[mo + c * mn] = f[c];
+        Ftn[mo + c * mn] = s / dn;
+    }
+    for (int c = 0; c < q; c++) {
+        const double ys = (y[c] - model_.Ysc[2 * c]) / model_.Ysc[2 * c + 1];
+        double s = ys;
+        for (int i = 0; i < mo; i++) {
+            s -= l[i] * Yt_[i + c * mmo];
+        }
+        Ynn[mo + c * mn] = ys;
+        Ytn[mo + c * mn] = s / dn;
+    }
+    model_.C.swap(Cn);
+    model_.S.swap(Sn);
+    model_.Ft.swap(Ftn);
+    F_.swap(Fn);
+    Yn_.swap(Ynn);
+    Yt_.swap(Ytn);
+    model_.m = mo + 1;
+    solve();
+}
+
+void IncrementalModel::removeOldest()
+{
+    const int m = model_.m, n = model_.n, q = model_.q, p = model_.p;
+    if (m - 1 < std::max(p, 1)) {
+        throw std::runtime_error("least squares problem is underdetermined");
+    }
+    const size_t mo = m, mn = m - 1;
+    X_.erase(X_.begin(), X_.begin() + n);
+    Y_.erase(Y_.begin(), Y_.begin() + q);
+
+    /* R(2:m,2:m) = C(2:m,2:m)*C(2:m,2:m)' + v*v' with v = C(2:m,1); the
+       diagonal of R keeps the shift model_.mu */
+    std::vector<double> Cn(mn * mn, 0.0), v(model_.C.begin() + 1, model_.C.begin() + mo);
+    for (size_t j = 0; j < mn; j++) {
+        const double *src = model_.C.data() + (j + 1) * mo;
+        std::copy(src + j + 1, src + mo, Cn.data() + j * mn + j);
+    }
+    choleskyUpdate(Cn.data(), (int)mn, v.data());
+
+    /* Drop the first rows; Ft and Yt are solved again with the new factor */
+    std::vector<double> *cols[] = {&model_.S, &F_, &Yn_};
+    const int ncols[] = {n, p, q};
+    for (int a = 0; a < 3; a++) {
+        std::vector<double> &A = *cols[a];
+        for (int c = 0; c < ncols[a]; c++) {
+            std::copy(A.begin() + c * mo + 1, A.begin() + (c + 1) * mo, A.begin() + c * mn);
+        }
+        A.resize(mn * ncols[a]);
+    }
+    model_.C.swap(Cn);
+    model_.m = m - 1;
+    model_.Ft = F_;
+    Yt_ = Yn_;
+#pragma omp parallel for schedule(static) if (p + q > 1 && mn * mn > 65536)
+    for (int c = 0; c < p + q; c++) {
+        forwardSolve(model_.C.data(), (int)mn,
+                     c < p ? model_.Ft.data() + c * mn : Yt_.data() + (c - p) * mn);
+    }
+    solve();
+}
+
+} // namespace dace
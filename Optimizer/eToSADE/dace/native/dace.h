@@ -0,0 +1,144 @@
+/*
+  Native Kriging engine: dacefit and predictor of the DACE toolbox for the
+  regpoly0/1/2 regression and the corrgauss, correxp and corrspline
+  correlation models.
+
+  The algorithms follow dacefit.m and predictor.m step by step (data
+  normalisation, the boxmin pattern search over theta, Cholesky and QR
+  based generalised least squares), and the model fields have the meaning
+  and column-major layout of the dmodel struct. The MATLAB interfaces are
+  dacefit_mex.cpp and predictor_mex.cpp, which dacefit.m and predictor.m
+  call when they are built (see buildDaceMex.m). IncrementalModel keeps a
+  fitted model up to date as design sites are added one at a time, and is
+  used from MATLAB through DaceModel.m and dacemodel_mex.cpp, and
+  likelihood evaluates batches of theta through dacelikelihood_mex.cpp.
+*/
+#ifndef DACE_H
+#define DACE_H
+
+#include <vector>
+
+namespace dace {
+
+enum Regression { REGPOLY0, REGPOLY1, REGPOLY2 };
+enum Correlation { CORRGAUSS, CORREXP, CORRSPLINE };
+
+/* Model from its MATLAB function name, -1 if it is not supported. */
+int regressionFromName(const char *name);
+int correlationFromName(const char *name);
+
+/* Number of regression functions for sites of dimension n. */
+int regressionSize(Regression regr, int n);
+
+/* Read-only view of a fitted model, see dacefit.m for the fields. */
+struct ModelData {
+    Regression regr;
+    Correlation corr;
+    int m;                 // number of design sites
+    int n;                 // dimension of the sites
+    int q;                 // number of responses
+    int p;                 // number of regression functions
+    int lth;               // length of theta, 1 or n
+    const double *theta;   // lth
+    const double *beta;    // p x q
+    const double *gamma;   // q x m
+    const double *sigma2;  // q
+    const double *S;       // m x n, scaled design sites
+    const double *Ssc;     // 2 x n
+    const double *Ysc;     // 2 x q
+    const double *C;       // m x m, lower Cholesky factor of R
+    const double *Ft;      // m x p
+    const double *G;       // p x p, lower, Ft = Q*G'
+};
+
+/* Fitted model owning its data. */
+struct Model {
+    Regression regr;
+    Correlation corr;
+    int m, n, q, p;
+    double mu;  // shift added to the diagonal of R when C was factorised
+    std::vector<double> theta, beta, gamma, sigma2, S, Ssc, Ysc, C, Ft, G;
+
+    ModelData data() const;
+};
+
+/* perf output of dacefit: (lth + 2) x nv columns [theta; psi(theta); type]. */
+struct Performance {
+    int nv;
+    std::vector<double> perf;
+};
+
+/* dacefit(S, Y, regr, corr, theta0, lob, upb) for S [m x n] and Y [m x q].
+   With lob and upb NULL, theta0 is used for theta. Throws
+   std::invalid_argument for inconsistent input and std::runtime_error with
+   the messages of dacefit.m when no model can be fitted. */
+void fit(const double *S, const double *Y, int m, int n, int q,
+         Regression regr, Correlation corr, const double *theta0,
+         const double *lob, const double *upb, int lth,
+         Model &model, Performance *perf);
+
+/* Concentrated log-likelihood lnL [nt] of the data normalised as in
+   dacefit for each of the nt candidates theta [lth x nt], and if not NULL
+   its gradient dlnL [lth x nt] and the objective psi [nt] that dacefit
+   minimises. The site differences are computed once and the candidates
+   are evaluated in parallel when built with OpenMP. A candidate for which
+   R is not positive definite gets lnL = -Inf, a NaN gradient and
+   psi = Inf. */
+void likelihood(const double *S, const double *Y, int m, int n, int q,
+                Regression regr, Correlation corr, const double *theta, int lth, int nt,
+                double *lnL, double *dlnL, double *psi);
+
+/* Predictor at the mx sites x [mx x n]: y [mx x q], and if not NULL, the
+   mean squared error mse [mx x q] and the Jacobian of y dy [q x n x mx].
+   Sites are evaluated in parallel when built with OpenMP. */
+void predict(const ModelData &model, const double *x, int mx,
+             double *y, double *mse, double *dy);
+
+/* Kriging model for a growing archive of design sites. Between full fits,
+   theta, the normalisation Ssc/Ysc and the diagonal shift of R are held
+   fixed; an appended site extends the Cholesky factor by one row and the
+   decorrelated Ft and Y, which costs O(m*(m*n + p + q)) instead of
+   O(m^3) for a fit, and the generalised least squares step is redone
+   in O(m*p*(p + q)). Every refitEvery appends (0: never) the model is
+   refitted with dacefit, starting from the current theta. With a window,
+   the oldest site is dropped once the model holds window sites, by a
+   rank-one update of the remaining factor. */
+class IncrementalModel
+{
+public:
+    IncrementalModel(Regression regr, Correlation corr, int refitEvery = 0, int window = 0);
+
+    /* Full fit as dace::fit; with lob and upb NULL, theta stays theta0. If
+       there are more than window sites, only the last window are used. */
+    void fit(const double *S, const double *Y, int m, int n, int q,
+             const double *theta0, const double *lob, const double *upb, int lth);
+
+    /* Add the site x [n] with responses y [q]. Falls back to a full fit when
+       the extended factor or the least squares problem break down. */
+    void append(const double *x, const double *y);
+
+    /* Drop the oldest design site. */
+    void removeOldest();
+
+    const Model &model() const { return model_; }
+    int size() const { return model_.m; }
+    int fits() const { return fits_; }
+
+private:
+    void refit(const double *theta0, int lth);
+    void solve();
+
+    Regression regr_;
+    Correlation corr_;
+    int refitEvery_, window_, appended_, fits_;
+    std::vector<double> lob_, upb_;
+    std::vector<double> X_, Y_;  // unscaled sites and responses, by rows
+    std::vector<double> F_;      // m x p, regression matrix of the scaled sites
+    std::vector<double> Yn_;     // m x q, scaled responses
+    std::vector<double> Yt_;     // m x q, C \ Yn
+    Model model_;
+};
+
+} // namespace dace
+
+#endif /* DACE_H */
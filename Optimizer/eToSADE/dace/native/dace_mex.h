@@ -0,0 +1,48 @@
+/*
+  Helpers shared by the MEX interfaces of the native Kriging engine.
+*/
+#ifndef DACE_MEX_H
+#define DACE_MEX_H
+
+#include <mex.h>
+#include <string.h>
+#include <vector>
+#include "dace.h"
+
+static mxArray *toMatrix(const std::vector<double> &v, size_t m, size_t n)
+{
+    mxArray *a = mxCreateDoubleMatrix(m, n, mxREAL);
+    if (m * n > 0) {
+        memcpy(mxGetPr(a), v.data(), m * n * sizeof(double));
+    }
+    return a;
+}
+
+static bool isRealMatrix(const mxArray *a)
+{
+    return mxIsDouble(a) && !mxIsComplex(a) && !mxIsSparse(a);
+}
+
+/* dmodel struct of dacefit.m, with the model names regr and corr */
+static mxArray *modelStruct(const dace::Model &model, const char *regr, const char *corr)
+{
+    const char *fields[] = {"regr", "corr", "theta", "beta", "gamma", "sigma2",
+                            "S", "Ssc", "Ysc", "C", "Ft", "G"};
+    const int m = model.m, n = model.n, q = model.q, p = model.p;
+    mxArray *s = mxCreateStructMatrix(1, 1, 12, fields);
+    mxSetField(s, 0, "regr", mxCreateString(regr));
+    mxSetField(s, 0, "corr", mxCreateString(corr));
+    mxSetField(s, 0, "theta", toMatrix(model.theta, 1, model.theta.size()));
+    mxSetField(s, 0, "beta", toMatrix(model.beta, p, q));
+    mxSetField(s, 0, "gamma", toMatrix(model.gamma, q, m));
+    mxSetField(s, 0, "sigma2", toMatrix(model.sigma2, 1, q));
+    mxSetField(s, 0, "S", toMatrix(model.S, m, n));
+    mxSetField(s, 0, "Ssc", toMatrix(model.Ssc, 2, n));
+    mxSetField(s, 0, "Ysc", toMatrix(model.Ysc, 2, q));
+    mxSetField(s, 0, "C", toMatrix(model.C, m, m));
+    mxSetField(s, 0, "Ft", toMatrix(model.Ft, m, p));
+    mxSetField(s, 0, "G", toMatrix(model.G, p, p));
+    return s;
+}
+
+#endif /* DACE_MEX_H */
@@ -0,0 +1,83 @@
+/*
+  MATLAB interface to dace::fit, called by dacefit.m when it is built:
+
+    [dmodel, perf] = dacefit_mex(S, Y, regr, corr, theta0)
+    [dmodel, perf] = dacefit_mex(S, Y, regr, corr, theta0, lob, upb)
+
+  regr and corr are model names ('regpoly0', 'regpoly1', 'regpoly2',
+  'corrgauss', 'correxp', 'corrspline'); dacefit.m stores its own function
+  handles in the returned dmodel. Build with buildDaceMex.
+*/
+#include <string.h>
+#include <exception>
+#include "dace_mex.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static char err[512];
+    if ((nrhs != 5 && nrhs != 7) || nlhs > 2) {
+        mexErrMsgTxt("usage: [dmodel, perf] = dacefit_mex(S, Y, regr, corr, theta0[, lob, upb])");
+    }
+    for (int i = 0; i < nrhs; i++) {
+        if (i != 2 && i != 3 && !isRealMatrix(prhs[i])) {
+            mexErrMsgTxt("S, Y, theta0, lob and upb must be real, full matrices.");
+        }
+    }
+    if (!mxIsChar(prhs[2]) || !mxIsChar(prhs[3])) {
+        mexErrMsgTxt("regr and corr must be model names.");
+    }
+
+    /* Check design points */
+    const int m = (int)mxGetM(prhs[0]), n = (int)mxGetN(prhs[0]);
+    int lY = (int)mxGetM(prhs[1]), q = (int)mxGetN(prhs[1]);
+    if (lY == 1 || q == 1) {
+        lY = lY * q;
+        q = 1;
+    }
+    if (m != lY) {
+        mexErrMsgTxt("S and Y must have the same number of rows");
+    }
+
+    char *rname = mxArrayToString(prhs[2]), *cname = mxArrayToString(prhs[3]);
+    const int regr = dace::regressionFromName(rname);
+    const int corr = dace::correlationFromName(cname);
+    if (regr < 0 || corr < 0) {
+        mexErrMsgTxt("Only the regpoly0/1/2 and corrgauss/correxp/corrspline models are supported.");
+    }
+
+    /* Check correlation parameters */
+    const int lth = (int)mxGetNumberOfElements(prhs[4]);
+    const double *lob = NULL, *upb = NULL;
+    if (nrhs == 7) {
+        if ((int)mxGetNumberOfElements(prhs[5]) != lth || (int)mxGetNumberOfElements(prhs[6]) != lth) {
+            mexErrMsgTxt("theta0, lob and upb must have the same length");
+        }
+        lob = mxGetPr(prhs[5]);
+        upb = mxGetPr(prhs[6]);
+    }
+
+    dace::Model model;
+    dace::Performance perf;
+    err[0] = '\0';
+    try {
+        dace::fit(mxGetPr(prhs[0]), mxGetPr(prhs[1]), m, n, q,
+                  (dace::Regression)regr, (dace::Correlation)corr,
+                  mxGetPr(prhs[4]), lob, upb, lth, model, &perf);
+    } catch (const std::exception &e) {
+        strncpy(err, e.what(), sizeof(err) - 1);
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+
+    plhs[0] = modelStruct(model, rname, cname);
+    mxFree(rname);
+    mxFree(cname);
+
+    if (nlhs > 1) {
+        const char *pfields[] = {"nv", "perf"};
+        plhs[1] = mxCreateStructMatrix(1, 1, 2, pfields);
+        mxSetField(plhs[1], 0, "nv", mxCreateDoubleScalar(perf.nv));
+        mxSetField(plhs[1], 0, "perf", toMatrix(perf.perf, lth + 2, perf.nv));
+    }
+}
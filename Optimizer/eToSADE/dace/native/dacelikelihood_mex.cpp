@@ -0,0 +1,84 @@
+/*
+  MATLAB interface to dace::likelihood, called by dacelikelihood.m:
+
+    [lnL, dlnL, psi] = dacelikelihood_mex(S, Y, regr, corr, Theta)
+
+  with one candidate theta per row of Theta [nt x lth]: lnL [nt x 1],
+  dlnL [nt x lth] and psi [nt x 1]. Build with buildDaceMex.
+*/
+#include <string.h>
+#include <exception>
+#include "dace_mex.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static char err[512];
+    if (nrhs != 5 || nlhs > 3) {
+        mexErrMsgTxt("usage: [lnL, dlnL, psi] = dacelikelihood_mex(S, Y, regr, corr, Theta)");
+    }
+    if (!isRealMatrix(prhs[0]) || !isRealMatrix(prhs[1]) || !isRealMatrix(prhs[4])) {
+        mexErrMsgTxt("S, Y and Theta must be real, full matrices.");
+    }
+    if (!mxIsChar(prhs[2]) || !mxIsChar(prhs[3])) {
+        mexErrMsgTxt("regr and corr must be model names.");
+    }
+
+    const int m = (int)mxGetM(prhs[0]), n = (int)mxGetN(prhs[0]);
+    int lY = (int)mxGetM(prhs[1]), q = (int)mxGetN(prhs[1]);
+    if (lY == 1 || q == 1) {
+        lY = lY * q;
+        q = 1;
+    }
+    if (m != lY) {
+        mexErrMsgTxt("S and Y must have the same number of rows");
+    }
+
+    char *rname = mxArrayToString(prhs[2]), *cname = mxArrayToString(prhs[3]);
+    const int regr = dace::regressionFromName(rname);
+    const int corr = dace::correlationFromName(cname);
+    mxFree(rname);
+    mxFree(cname);
+    if (regr < 0 || corr < 0) {
+        mexErrMsgTxt("Only the regpoly0/1/2 and corrgauss/correxp/corrspline models are supported.");
+    }
+
+    /* Candidates as columns */
+    const int nt = (int)mxGetM(prhs[4]), lth = (int)mxGetN(prhs[4]);
+    const double *T = mxGetPr(prhs[4]);
+    std::vector<double> theta((size_t)nt * lth), dlnL((size_t)nt * lth);
+    for (int t = 0; t < nt; t++) {
+        for (int k = 0; k < lth; k++) {
+            theta[k + (size_t)t * lth] = T[t + (size_t)k * nt];
+        }
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(nt, 1, mxREAL);
+    mxArray *psi = mxCreateDoubleMatrix(nt, 1, mxREAL);
+    err[0] = '\0';
+    try {
+        dace::likelihood(mxGetPr(prhs[0]), mxGetPr(prhs[1]), m, n, q,
+                         (dace::Regression)regr, (dace::Correlation)corr, theta.data(), lth, nt,
+                         mxGetPr(plhs[0]), nlhs > 1 ? dlnL.data() : NULL, mxGetPr(psi));
+    } catch (const std::exception &e) {
+        strncpy(err, e.what(), sizeof(err) - 1);
+    }
+    if (err[0] != '\0') {
+        mxDestroyArray(psi);
+        mexErrMsgTxt(err);
+    }
+
+    if (nlhs > 1) {
+        plhs[1] = mxCreateDoubleMatrix(nt, lth, mxREAL);
+        double *G = mxGetPr(plhs[1]);
+        for (int t = 0; t < nt; t++) {
+            for (int k = 0; k < lth; k++) {
+                G[t + (size_t)k * nt] = dlnL[k + (size_t)t * lth];
+            }
+        }
+    }
+    if (nlhs > 2) {
+        plhs[2] = psi;
+    } else {
+        mxDestroyArray(psi);
+    }
+}
@@ -0,0 +1,215 @@
+/*
+  MATLAB interface to dace::IncrementalModel, used by DaceModel.m:
+
+    h         = dacemodel_mex('new', S, Y, regr, corr, theta0, lob, upb, refit, window)
+                dacemodel_mex('append', h, S, Y)
+                dacemodel_mex('remove', h)
+    [y, mse]  = dacemodel_mex('predict', h, x)
+    dmodel    = dacemodel_mex('model', h)
+    m         = dacemodel_mex('size', h)
+                dacemodel_mex('delete', h)
+
+  lob and upb may be empty to keep theta fixed, S and Y of 'append' hold one
+  site per row, and dmodel is the struct returned by dacefit. The models
+  live until they are deleted or the MEX file is cleared. Build with
+  buildDaceMex.
+*/
+#include <stdio.h>
+#include <exception>
+#include <map>
+#include <string>
+#include "dace_mex.h"
+
+namespace {
+
+struct Entry {
+    dace::IncrementalModel model;
+    std::string regr, corr;
+
+    Entry(dace::Regression r, dace::Correlation c, int refit, int window,
+          const std::string &rn, const std::string &cn)
+        : model(r, c, refit, window), regr(rn), corr(cn)
+    {
+    }
+};
+
+std::map<int, Entry *> models;
+int nextHandle = 1;
+
+void clearModels()
+{
+    for (std::map<int, Entry *>::iterator it = models.begin(); it != models.end(); ++it) {
+        delete it->second;
+    }
+    models.clear();
+}
+
+Entry *lookup(const mxArray *h)
+{
+    if (!mxIsDouble(h) || mxGetNumberOfElements(h) != 1) {
+        mexErrMsgTxt("Invalid model handle.");
+    }
+    std::map<int, Entry *>::iterator it = models.find((int)mxGetScalar(h));
+    if (it == models.end()) {
+        mexErrMsgTxt("Invalid model handle.");
+    }
+    return it->second;
+}
+
+std::string name(const mxArray *a)
+{
+    char *s = mxArrayToString(a);
+    std::string r(s != NULL ? s : "");
+    mxFree(s);
+    return r;
+}
+
+/* Sites x of dimension n, one per row, a single site may be a column */
+int siteCount(const mxArray *x, int n, const char *what)
+{
+    static char msg[96];
+    int mx = (int)mxGetM(x), nx = (int)mxGetN(x);
+    if (!isRealMatrix(x)) {
+        sprintf(msg, "%s must be a real, full matrix.", what);
+        mexErrMsgTxt(msg);
+    }
+    if (nx == 1 && mx == n && n > 1) {
+        return 1;
+    }
+    if (nx != n) {
+        sprintf(msg, "Dimension of %s should be %d", what, n);
+        mexErrMsgTxt(msg);
+    }
+    return mx;
+}
+
+void create(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 10 || nlhs > 1) {
+        mexErrMsgTxt("usage: h = dacemodel_mex('new', S, Y, regr, corr, theta0, lob, upb, refit, window)");
+    }
+    const int regr = dace::regressionFromName(name(prhs[3]).c_str());
+    const int corr = dace::correlationFromName(name(prhs[4]).c_str());
+    if (regr < 0 || corr < 0) {
+        mexErrMsgTxt("Only the regpoly0/1/2 and corrgauss/correxp/corrspline models are supported.");
+    }
+    for (int i = 1; i < nrhs; i++) {
+        if (i != 3 && i != 4 && !isRealMatrix(prhs[i])) {
+            mexErrMsgTxt("S, Y, theta0, lob, upb, refit and window must be real, full matrices.");
+        }
+    }
+    const int m = (int)mxGetM(prhs[1]), n = (int)mxGetN(prhs[1]);
+    int lY = (int)mxGetM(prhs[2]), q = (int)mxGetN(prhs[2]);
+    if (lY == 1 || q == 1) {
+        lY = lY * q;
+        q = 1;
+    }
+    if (m != lY) {
+        mexErrMsgTxt("S and Y must have the same number of rows");
+    }
+    const int lth = (int)mxGetNumberOfElements(prhs[5]);
+    const bool bounds = !mxIsEmpty(prhs[6]);
+    if (bounds && ((int)mxGetNumberOfElements(prhs[6]) != lth
+                   || (int)mxGetNumberOfElements(prhs[7]) != lth)) {
+        mexErrMsgTxt("theta0, lob and upb must have the same length");
+    }
+
+    static char err[512];
+    Entry *e = NULL;
+    err[0] = '\0';
+    try {
+        e = new Entry((dace::Regression)regr, (dace::Correlation)corr,
+                      (int)mxGetScalar(prhs[8]), (int)mxGetScalar(prhs[9]),
+                      name(prhs[3]), name(prhs[4]));
+        e->model.fit(mxGetPr(prhs[1]), mxGetPr(prhs[2]), m, n, q, mxGetPr(prhs[5]),
+                     bounds ? mxGetPr(prhs[6]) : NULL, bounds ? mxGetPr(prhs[7]) : NULL, lth);
+    } catch (const std::exception &ex) {
+        strncpy(err, ex.what(), sizeof(err) - 1);
+        delete e;
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+    if (models.empty()) {
+        mexAtExit(clearModels);
+    }
+    models[nextHandle] = e;
+    plhs[0] = mxCreateDoubleScalar(nextHandle++);
+}
+
+} // namespace
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs < 1 || !mxIsChar(prhs[0])) {
+        mexErrMsgTxt("usage: dacemodel_mex(command, ...)");
+    }
+    const std::string cmd = name(prhs[0]);
+    if (cmd == "new") {
+        create(nlhs, plhs, nrhs, prhs);
+        return;
+    }
+    if (nrhs < 2) {
+        mexErrMsgTxt("Missing model handle.");
+    }
+    Entry *e = lookup(prhs[1]);
+    const dace::Model &md = e->model.model();
+    static char err[512];
+    err[0] = '\0';
+
+    if (cmd == "append") {
+        if (nrhs != 4) {
+            mexErrMsgTxt("usage: dacemodel_mex('append', h, S, Y)");
+        }
+        const int ms = siteCount(prhs[2], md.n, "S");
+        const int my = md.q == 1 ? (int)mxGetNumberOfElements(prhs[3]) : siteCount(prhs[3], md.q, "Y");
+        if (ms != my) {
+            mexErrMsgTxt("S and Y must have the same number of rows");
+        }
+        const double *S = mxGetPr(prhs[2]), *Y = mxGetPr(prhs[3]);
+        std::vector<double> x(md.n), y(md.q);
+        try {
+            for (int i = 0; i < ms; i++) {
+                for (int k = 0; k < md.n; k++) {
+                    x[k] = S[i + (size_t)k * ms];
+                }
+                for (int l = 0; l < md.q; l++) {
+                    y[l] = Y[i + (size_t)l * ms];
+                }
+                e->model.append(x.data(), y.data());
+            }
+        } catch (const std::exception &ex) {
+            strncpy(err, ex.what(), sizeof(err) - 1);
+        }
+    } else if (cmd == "remove") {
+        try {
+            e->model.removeOldest();
+        } catch (const std::exception &ex) {
+            strncpy(err, ex.what(), sizeof(err) - 1);
+        }
+    } else if (cmd == "predict") {
+        if (nrhs != 3 || nlhs > 2) {
+            mexErrMsgTxt("usage: [y, mse] = dacemodel_mex('predict', h, x)");
+        }
+        const int mx = siteCount(prhs[2], md.n, "x");
+        plhs[0] = mxCreateDoubleMatrix(mx, md.q, mxREAL);
+        double *mse = NULL;
+        if (nlhs > 1) {
+            plhs[1] = mxCreateDoubleMatrix(mx, md.q, mxREAL);
+            mse = mxGetPr(plhs[1]);
+        }
+        dace::predict(md.data(), mxGetPr(prhs[2]), mx, mxGetPr(plhs[0]), mse, NULL);
+    } else if (cmd == "model") {
+        plhs[0] = modelStruct(md, e->regr.c_str(), e->corr.c_str());
+    } else if (cmd == "size") {
+        plhs[0] = mxCreateDoubleScalar(e->model.size());
+    } else if (cmd == "delete") {
+        models.erase((int)mxGetScalar(prhs[1]));
+        delete e;
+    } else {
+        mexErrMsgTxt("Unknown command.");
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+}
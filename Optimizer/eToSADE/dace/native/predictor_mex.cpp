@@ -0,0 +1,130 @@
+/*
+  MATLAB interface to dace::predict, called by predictor.m when it is built:
+
+    y             = predictor_mex(x, dmodel, regr, corr)
+    [y, or]       = predictor_mex(x, dmodel, regr, corr)
+    [y, dy, mse]  = predictor_mex(x, dmodel, regr, corr)
+
+  with the outputs of predictor.m: for a single site or is the gradient,
+  for several sites it is the mean squared error, and all sites are
+  evaluated in one call. regr and corr are the names of the models in
+  dmodel. Build with buildDaceMex.
+*/
+#include <mex.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "dace.h"
+
+/* Full double field of dmodel with the expected size */
+static const double *field(const mxArray *dmodel, const char *name, size_t m, size_t n,
+                           mxArray **tmp)
+{
+    static char msg[128];
+    mxArray *f = mxGetField(dmodel, 0, name);
+    if (f == NULL || !mxIsDouble(f) || mxIsComplex(f)
+        || mxGetM(f) * mxGetN(f) != m * n) {
+        sprintf(msg, "DMODEL.%s is missing or has the wrong size", name);
+        mexErrMsgTxt(msg);
+    }
+    if (mxIsSparse(f)) {
+        /* C is sparse in models fitted by dacefit.m */
+        mexCallMATLAB(1, tmp, 1, &f, "full");
+        return mxGetPr(*tmp);
+    }
+    return mxGetPr(f);
+}
+
+static int modelSize(const mxArray *dmodel, const char *name, int dim)
+{
+    mxArray *f = mxGetField(dmodel, 0, name);
+    return f == NULL ? 0 : (int)(dim == 1 ? mxGetM(f) : mxGetN(f));
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 4 || nlhs > 3 || !mxIsStruct(prhs[1]) || !mxIsChar(prhs[2]) || !mxIsChar(prhs[3])) {
+        mexErrMsgTxt("usage: [y, or1, or2] = predictor_mex(x, dmodel, regr, corr)");
+    }
+    if (!mxIsDouble(prhs[0]) || mxIsComplex(prhs[0]) || mxIsSparse(prhs[0])) {
+        mexErrMsgTxt("x must be a real, full matrix.");
+    }
+    char *rname = mxArrayToString(prhs[2]), *cname = mxArrayToString(prhs[3]);
+    const int regr = dace::regressionFromName(rname);
+    const int corr = dace::correlationFromName(cname);
+    mxFree(rname);
+    mxFree(cname);
+    if (regr < 0 || corr < 0) {
+        mexErrMsgTxt("Only the regpoly0/1/2 and corrgauss/correxp/corrspline models are supported.");
+    }
+
+    /* Model sizes from the design sites and the regression */
+    const mxArray *dm = prhs[1];
+    dace::ModelData md;
+    mxArray *Cfull = NULL;
+    md.regr = (dace::Regression)regr;
+    md.corr = (dace::Correlation)corr;
+    md.m = modelSize(dm, "S", 1);
+    md.n = modelSize(dm, "S", 2);
+    md.q = modelSize(dm, "Ysc", 2);
+    md.p = dace::regressionSize(md.regr, md.n);
+    md.lth = (int)(modelSize(dm, "theta", 1) * modelSize(dm, "theta", 2));
+    if (md.lth != 1 && md.lth != md.n) {
+        char msg[64];
+        sprintf(msg, "Length of theta must be 1 or %d", md.n);
+        mexErrMsgTxt(msg);
+    }
+    md.theta = field(dm, "theta", md.lth, 1, NULL);
+    md.beta = field(dm, "beta", md.p, md.q, NULL);
+    md.gamma = field(dm, "gamma", md.q, md.m, NULL);
+    md.sigma2 = field(dm, "sigma2", 1, md.q, NULL);
+    md.S = field(dm, "S", md.m, md.n, NULL);
+    md.Ssc = field(dm, "Ssc", 2, md.n, NULL);
+    md.Ysc = field(dm, "Ysc", 2, md.q, NULL);
+    md.C = field(dm, "C", md.m, md.m, &Cfull);
+    md.Ft = field(dm, "Ft", md.m, md.p, NULL);
+    md.G = field(dm, "G", md.p, md.p, NULL);
+
+    /* Trial sites, a single site may be a row or a column */
+    const int n = md.n, q = md.q;
+    int mx = (int)mxGetM(prhs[0]), nx = (int)mxGetN(prhs[0]);
+    if ((mx == 1 || nx == 1) && n > 1 && mx * nx == n) {
+        mx = 1;
+        nx = n;
+    }
+    if (nx != n) {
+        char msg[64];
+        sprintf(msg, "Dimension of trial sites should be %d", n);
+        mexErrMsgTxt(msg);
+    }
+    const double *x = mxGetPr(prhs[0]);
+
+    if (mx == 1) {
+        plhs[0] = mxCreateDoubleMatrix(q, 1, mxREAL);
+        double *dy = NULL, *mse = NULL;
+        if (nlhs > 1) {
+            plhs[1] = q == 1 ? mxCreateDoubleMatrix(n, 1, mxREAL) : mxCreateDoubleMatrix(q, n, mxREAL);
+            dy = mxGetPr(plhs[1]);
+        }
+        if (nlhs > 2) {
+            plhs[2] = mxCreateDoubleMatrix(1, q, mxREAL);
+            mse = mxGetPr(plhs[2]);
+        }
+        dace::predict(md, x, 1, mxGetPr(plhs[0]), mse, dy);
+    } else {
+        plhs[0] = mxCreateDoubleMatrix(mx, q, mxREAL);
+        double *mse = NULL;
+        if (nlhs > 1) {
+            plhs[1] = mxCreateDoubleMatrix(mx, q, mxREAL);
+            mse = mxGetPr(plhs[1]);
+        }
+        if (nlhs > 2) {
+            mexPrintf("WARNING from PREDICTOR.  Only  y  and  or1=mse  are computed\n");
+            plhs[2] = mxCreateDoubleScalar(mxGetNaN());
+        }
+        dace::predict(md, x, mx, mxGetPr(plhs[0]), mse, NULL);
+    }
+    if (Cfull != NULL) {
+        mxDestroyArray(Cfull);
+    }
+}
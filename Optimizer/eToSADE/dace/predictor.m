@@ -33,6 +33,19 @@ function  [y, or1, or2, dmse] = predictor(x, dmodel)
     error('DMODEL has not been found')
   end
 
+  % Use the compiled engine when it is built, see buildDaceMex
+  if  nargout < 4
+    [usemex, rn, cn] = usedacemex('predictor_mex', dmodel.regr, dmodel.corr);
+    if  usemex
+      out = cell(1, max(nargout,1));
+      [out{:}] = predictor_mex(x, dmodel, rn, cn);
+      y = out{1};
+      if  nargout > 1,  or1 = out{2}; end
+      if  nargout > 2,  or2 = out{3}; end
+      return
+    end
+  end
+
   [m n] = size(dmodel.S);  % number of design sites and number of dimensions
   sx = size(x);            % number of trial sites and their dimension
   if  min(sx) == 1 & n > 1 % Single trial point 
@@ -0,0 +1,40 @@
+function testDaceLikelihood()
+%TESTDACELIKELIHOOD  Check the batched Kriging likelihood of DACELIKELIHOOD
+%
+% Call:   testDaceLikelihood()
+%
+% Evaluates a batch of candidates, so that each thread reuses its
+% workspace, and compares lnL and psi with evaluating every candidate on
+% its own, and the gradient dlnL with central finite differences. Needs
+% the MEX files from BUILDDACEMEX.
+
+rng(7);
+m = 30;  n = 2;
+S = rand(m, n);
+Y = sin(5*S(:,1)) + S(:,2).^2;
+Theta = [0.5 2.0; 1.5 0.3; 4.0 4.0; 0.1 8.0; 1.0 1.0; 0.7 3.0];
+nt = size(Theta, 1);
+
+for corr = {@corrgauss, @correxp}
+  [lnL, dlnL, psi] = dacelikelihood(S, Y, @regpoly1, corr{1}, Theta);
+  for t = 1:nt
+    [l1, d1, p1] = dacelikelihood(S, Y, @regpoly1, corr{1}, Theta(t,:));
+    assert(abs(lnL(t) - l1) <= 1e-10*max(1, abs(l1)), ...
+      'lnL of candidate %d differs between batched and single evaluation', t);
+    assert(abs(psi(t) - p1) <= 1e-10*max(1, abs(p1)), ...
+      'psi of candidate %d differs between batched and single evaluation', t);
+    assert(all(abs(dlnL(t,:) - d1) <= 1e-8*max(1, abs(d1))), ...
+      'dlnL of candidate %d differs between batched and single evaluation', t);
+    for k = 1:n
+      h = 1e-6*Theta(t,k);
+      tp = Theta(t,:);  tp(k) = tp(k) + h;
+      tm = Theta(t,:);  tm(k) = tm(k) - h;
+      fd = (dacelikelihood(S, Y, @regpoly1, corr{1}, tp) - ...
+            dacelikelihood(S, Y, @regpoly1, corr{1}, tm)) / (2*h);
+      assert(abs(dlnL(t,k) - fd) <= 1e-5*max(1, abs(fd)), ...
+        'dlnL(%d,%d) = %g, finite difference %g (%s)', ...
+        t, k, dlnL(t,k), fd, func2str(corr{1}));
+    end
+  end
+end
+fprintf('dacelikelihood: batched gradients match finite differences\n');
@@ -0,0 +1,27 @@
+function  [use, rn, cn] = usedacemex(fname, regr, corr)
+%USEDACEMEX  Check if the compiled Kriging engine can be used
+%
+% Call:   [use, rn, cn] = usedacemex(fname, regr, corr)
+%
+% Input
+% fname : Name of the MEX function, 'dacefit_mex', 'predictor_mex',
+%         'dacemodel_mex' or 'dacelikelihood_mex'
+% regr  : Regression model, function handle or name
+% corr  : Correlation model, function handle or name
+%
+% Output
+% use   : true if  fname  is built (see BUILDDACEMEX) and supports both
+%         models, i.e. regpoly0/1/2 and corrgauss/correxp/corrspline
+% rn,cn : Names of the models
+
+rn = modelname(regr);   cn = modelname(corr);
+use = exist(fname, 'file') == 3 && ...
+  any(strcmp(rn, {'regpoly0', 'regpoly1', 'regpoly2'})) && ...
+  any(strcmp(cn, {'corrgauss', 'correxp', 'corrspline'}));
+
+% >>>>>>>>>>>>>>>>   Auxiliary function  ====================
+
+function  s = modelname(f)
+if  isa(f, 'function_handle'),  s = func2str(f);
+elseif  ischar(f),              s = f;
+else,                           s = ''; end
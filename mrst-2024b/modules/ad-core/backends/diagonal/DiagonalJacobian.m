@@ -658,7 +658,63 @@ classdef DiagonalJacobian
                 x.subset = max(sx, sy);
             end
         end
-        
+
+        function x = diagProductSum(v, varargin)
+            % Compute sum_k diag(v{k})*J_k for Jacobians J_1, ..., J_k.
+            % When all Jacobians are non-empty diagonals with matching
+            % subsets, the sum is evaluated in a single pass.
+            J = varargin;
+            k = numel(J);
+            fused = k > 1;
+            for i = 1:k
+                fused = fused && isa(J{i}, 'DiagonalJacobian') && ...
+                        ~isempty(J{i}.diagonal) && any(v{i});
+                if ~fused
+                    break
+                end
+            end
+            if fused
+                x = J{1};
+                for i = 2:k
+                    fused = fused && J{i}.rowMajor == x.rowMajor && ...
+                            subsetsEqualNoZeroCheck(x, J{i});
+                end
+            end
+            if ~fused
+                % Mixed types or subsets: Fall back to pairwise products
+                x = diagMult(v{1}, J{1}, []);
+                for i = 2:k
+                    x = x + diagMult(v{i}, J{i}, []);
+                end
+                return
+            end
+            if x.rowMajor && x.useMex
+                args = cell(1, 2*k);
+                for i = 1:k
+                    args{2*i-1} = J{i}.diagonal;
+                    args{2*i} = v{i};
+                end
+                x.diagonal = mexDiagProductMult(args{:}, true);
+            else
+                d = 0;
+                for i = 1:k
+                    vi = v{i};
+                    if x.rowMajor
+                        vi = vi';
+                    end
+                    if x.allowImplicitExpansion
+                        d = d + J{i}.diagonal.*vi;
+                    else
+                        d = d + bsxfun(@times, J{i}.diagonal, vi);
+                    end
+                end
+                x.diagonal = d;
+            end
+            for i = 2:k
+                x.subset = DiagonalJacobian.treatSubset(x.subset, J{i}.subset);
+            end
+        end
+
         function x = sum(D, n)
             if nargin == 1
                 n = 1;
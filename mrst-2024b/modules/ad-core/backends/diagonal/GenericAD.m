@@ -60,6 +60,51 @@ classdef GenericAD < ADI
             end
         end
         
+        function h = multiTimes(varargin)
+            % Element-wise product of three or more factors.  The Jacobian
+            % sum_i (prod_{j~=i} v_j) J_i is formed by diagProductSum in a
+            % single pass instead of one pass per pairwise product.
+            isAD = cellfun(@(x) isa(x, 'GenericAD'), varargin);
+            n = max(cellfun(@numelValue, varargin));
+            fused = nnz(isAD) > 2;
+            if fused
+                % All AD factors must be full length vectors
+                fused = all(cellfun(@numelValue, varargin(isAD)) == n);
+            end
+            if ~fused
+                h = varargin{1};
+                for i = 2:numel(varargin)
+                    h = h.*varargin{i};
+                end
+                return
+            end
+            v = cellfun(@value, varargin, 'UniformOutput', false);
+            k = numel(v);
+            % Products of all factors before and after factor i
+            pre = cell(1, k+1);
+            suf = cell(1, k+1);
+            pre{1} = 1;
+            suf{k+1} = 1;
+            for i = 1:k
+                pre{i+1} = pre{i}.*v{i};
+                suf{k+1-i} = suf{k+2-i}.*v{k+1-i};
+            end
+            ix = find(isAD);
+            c = cell(1, numel(ix));
+            for i = 1:numel(ix)
+                c{i} = pre{ix(i)}.*suf{ix(i)+1}.*ones(n, 1);
+            end
+            h = varargin{ix(1)};
+            h.val = pre{k+1}.*ones(n, 1);
+            J = cell(1, numel(ix));
+            for j = 1:numel(h.jac)
+                for i = 1:numel(ix)
+                    J{i} = varargin{ix(i)}.jac{j};
+                end
+                h.jac{j} = diagProductSum(c, J{:});
+            end
+        end
+
         function h = vertcat(varargin)
             isD = cellfun(@isnumeric, varargin);
             if any(isD)
@@ -5,7 +5,10 @@
 %   discreteDivergenceDiagonalJac - Undocumented Utility Function
 %   discreteDivergence            - Discrete divergence for the GenericAD library
 %   faceAverage                   - Face average operator for the GenericAD library
+%   faceAverageBatch              - Face average of several quantities for the GenericAD library
+%   getDiagonalOperatorOrdering   - Cell and face ordering with improved locality for the diagonal operators
 %   singlePointUpwind             - Single-point upwind for the GenericAD library
+%   singlePointUpwindBatch        - Single-point upwind of several quantities for the GenericAD library
 %   twoPointGradient              - Discrete gradient for the GenericAD library
 
 %{
@@ -0,0 +1,60 @@
+function v = faceAverageBatch(N, nc, v, useMex)
+%Face average of several quantities for the GenericAD library
+%
+% SYNOPSIS:
+%   v = faceAverageBatch(N, nc, v, useMex)
+%
+% DESCRIPTION:
+%   Average a cell array of quantities (typically one per phase) onto the
+%   faces. With MEX enabled, all values and diagonal Jacobians are
+%   computed in a single sweep over the faces. Quantities that cannot be
+%   batched (e.g. sparse Jacobians) are passed on to faceAverage one at a
+%   time.
+%
+% PARAMETERS:
+%   N      - Face neighborship (nf x 2).
+%   nc     - Number of cells, i.e. rows of the cell quantities.
+%   v      - Cell array of cell quantities (GenericAD or double).
+%   useMex - Use the batched MEX kernel.
+%
+% RETURNS:
+%   v      - Cell array of face averaged quantities.
+%
+% SEE ALSO:
+%   faceAverage, singlePointUpwindBatch
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    np = numel(v);
+    [batch, rowMajor] = getBatchableQuantities(v);
+    if ~useMex || ~any(batch)
+        for i = 1:np
+            v{i} = faceAverage(N, v{i}, useMex);
+        end
+        return
+    end
+    for i = find(~batch)
+        v{i} = faceAverage(N, v{i}, useMex);
+    end
+    ix = find(batch);
+    [vals, diagonals, ~, jacPos] = getBatchArguments(v, ix);
+    [faceVals, faceDiagonals] = mexFaceAverageBatch(vals, diagonals, N, nc, rowMajor);
+    v = setBatchResults(v, ix, N, faceVals, faceDiagonals, jacPos, useMex, rowMajor);
+end
@@ -0,0 +1,127 @@
+function ordering = getDiagonalOperatorOrdering(G, varargin)
+%Cell and face ordering with improved locality for the diagonal operators
+%
+% SYNOPSIS:
+%   ordering = getDiagonalOperatorOrdering(G)
+%   ordering = getDiagonalOperatorOrdering(G, 'type', 'morton')
+%
+% DESCRIPTION:
+%   The discrete divergence, gradient and upwind operators of the diagonal
+%   backend access cells through the face neighborship. For grids where
+%   N(:, 1) and N(:, 2) are far apart in the cell numbering (e.g.
+%   corner-point grids with inactive cells) these accesses have poor cache
+%   reuse. This function computes a cell renumbering that keeps neighbours
+%   close, and a matching face ordering where faces are sorted by their
+%   renumbered neighbours. The ordering is meant to be applied once to the
+%   grid and the cell-wise input data (see permuteGridCells), after which
+%   all AD operators and the linear solver see the improved numbering.
+%
+% PARAMETERS:
+%   G      - Grid structure. Must have geometry for type 'morton'.
+%
+% OPTIONAL PARAMETERS:
+%   type   - 'rcm' (default) for reverse Cuthill-McKee on the cell
+%            connectivity, or 'morton' for a Z-order space-filling curve
+%            through the cell centroids.
+%   useMex - Use the native implementation. Falls back to MATLAB if the
+%            MEX file cannot be built.
+%
+% RETURNS:
+%   ordering - Struct with fields
+%                cells    - New cell i is old cell cells(i).
+%                cellsInv - Old cell i is new cell cellsInv(i). Use this to
+%                           map results back to the original numbering,
+%                           e.g. p = state.pressure(ordering.cellsInv).
+%                faces    - New face i is old (internal) face faces(i).
+%                facesInv - Inverse of faces.
+%                N        - Renumbered neighborship in the new face order.
+%                type     - Ordering type.
+%
+% SEE ALSO:
+%   permuteGridCells, getGridSYMRCMOrdering
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    opt = struct('type', 'rcm', 'useMex', mrstSettings('get', 'useMEX'));
+    opt = merge_options(opt, varargin{:});
+    N = getNeighbourship(G);
+    nc = G.cells.num;
+    nf = size(N, 1);
+    switch lower(opt.type)
+        case 'rcm'
+            centroids = zeros(0, 1);
+        case 'morton'
+            assert(isfield(G.cells, 'centroids'), ...
+                'Morton ordering requires grid geometry. Call computeGeometry first.');
+            centroids = G.cells.centroids;
+        otherwise
+            error('Unknown ordering type ''%s''. Expected ''rcm'' or ''morton''.', opt.type);
+    end
+    if opt.useMex
+        try
+            [cells, faces] = mexCellOrdering(N, nc, centroids);
+        catch ex
+            warning('mexCellOrdering failed (%s), using MATLAB fallback.', ex.message);
+            opt.useMex = false;
+        end
+    end
+    if ~opt.useMex
+        if isempty(centroids)
+            A = getConnectivityMatrix(N, true, nc);
+            cells = reshape(symrcm(A), [], 1);
+        else
+            cells = mortonOrdering(centroids);
+        end
+        renum = zeros(nc, 1);
+        renum(cells) = 1:nc;
+        M = renum(N);
+        [~, faces] = sortrows([min(M, [], 2), max(M, [], 2), (1:nf)']);
+    end
+    cellsInv = zeros(nc, 1);
+    cellsInv(cells) = (1:nc)';
+    facesInv = zeros(nf, 1);
+    facesInv(faces) = (1:nf)';
+
+    ordering = struct('cells',    cells, ...
+                      'cellsInv', cellsInv, ...
+                      'faces',    faces, ...
+                      'facesInv', facesInv, ...
+                      'N',        reshape(cellsInv(N(faces, :)), [], 2), ...
+                      'type',     lower(opt.type));
+end
+
+function order = mortonOrdering(x)
+    [nc, dim] = size(x);
+    % Keys are exact in double precision. mexCellOrdering uses the same
+    % budget so that both implementations give identical orderings.
+    bits = min(floor(52/dim), 32);
+    lo = min(x, [], 1);
+    hi = max(x, [], 1);
+    h = (2^bits - 1)./max(hi - lo, realmin);
+    h(hi == lo) = 0;
+    q = floor(bsxfun(@times, bsxfun(@minus, x, lo), h));
+    key = zeros(nc, 1);
+    for b = bits-1:-1:0
+        for d = dim:-1:1
+            key = 2*key + bitget(q(:, d), b + 1);
+        end
+    end
+    [~, order] = sort(key);
+end
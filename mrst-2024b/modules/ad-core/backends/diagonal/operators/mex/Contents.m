@@ -4,18 +4,22 @@
 %   buildMexExtensions                     - (Re)build a set of mex extensions located in a specific folder
 %   buildMexOperators                      - Build MEX operators for automatic differentiation
 %   getMexDiscreteDivergenceJacPrecomputes - Undocumented Utility Function
+%   mexCellOrdering                        - Undocumented Utility Function
 %   mexDiagonalSparse                      - Undocumented Utility Function
 %   mexDiagMult                            - Undocumented Utility Function
 %   mexDiagProductMult                     - Undocumented Utility Function
 %   mexDiscreteDivergenceBlockJac          - Undocumented Utility Function
 %   mexDiscreteDivergenceJac               - Undocumented Utility Function
 %   mexDiscreteDivergenceVal               - Undocumented Utility Function
+%   mexFaceAverageBatch                    - Undocumented Utility Function
 %   mexFaceAverageDiagonalJac              - Undocumented Utility Function
 %   mexFaceAverageVal                      - Undocumented Utility Function
+%   mexSinglePointUpwindBatch              - Undocumented Utility Function
 %   mexSinglePointUpwindDiagonalJac        - Undocumented Utility Function
 %   mexSinglePointUpwindVal                - Undocumented Utility Function
 %   mexTwoPointGradientDiagonalJac         - Undocumented Utility Function
 %   mexTwoPointGradientVal                 - Undocumented Utility Function
+%   setMexOperatorThreadPolicy             - Set threading policy for the diagonal AD MEX operators
 %   setupMexOperatorBuildFlags             - Undocumented Utility Function
 %   testMexDiagonalOperators               - Undocumented Test Routine
 
@@ -0,0 +1,356 @@
+//
+// Standalone micro-benchmark for the diagonal AD operator kernels.
+//
+// Calls the kernel templates in ../kernels directly (no MATLAB required) on
+// synthetic Cartesian topologies and reports achieved bandwidth against a
+// STREAM triad measured with the same thread count.
+//
+// Usage:
+//   benchmarkDiagonalOperators [--case egg|spe10|NXxNYxNZ] [--m 1,2,3,5]
+//                              [--threads 1,2,4] [--reps 10] [--inactive 0.26]
+//                              [--stream-size 8388608] [--order natural|rcm|morton]
+//
+// The byte counts are nominal: every array entry the kernel must read or
+// write is counted once, and index arrays stored as double (as passed from
+// MATLAB) are counted as 8 bytes.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "../kernels/cellOrdering.h"
+#include "../kernels/diagMult.h"
+#include "../kernels/divergenceJac.h"
+#include "../kernels/gradientJac.h"
+#include "../kernels/jacToSparse.h"
+#include "../kernels/upwind.h"
+#include "../kernels/upwindJac.h"
+
+#define TIME_NOW std::chrono::high_resolution_clock::now
+
+struct Topology {
+    std::string name;
+    int nc;
+    int nf;
+    std::vector<double> N;        // [nf x 2], one-based
+    std::vector<double> facePos;  // [nc + 1], zero-based offsets
+    std::vector<double> faces;    // [nhf], zero-based
+    std::vector<double> cells;    // [nhf], signed one-based
+    std::vector<double> cellsIx;  // [nc]
+};
+
+// Cartesian grid with a fraction of cells removed at random, mimicking the
+// inactive cells of corner-point models. Cells are numbered in natural
+// (i fastest) order, as produced by processGRDECL, and optionally renumbered
+// by one of the orderings in cellOrdering.h.
+Topology makeTopology(const std::string & name, int nx, int ny, int nz, double inactive,
+                      const std::string & order) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<int> map(nx * ny * nz, -1);
+    int nc = 0;
+    for (int i = 0; i < nx * ny * nz; i++) {
+        if (u(gen) >= inactive) {
+            map[i] = nc++;
+        }
+    }
+    Topology t;
+    t.name = name;
+    t.nc = nc;
+    std::vector<double> centroids(3 * (size_t)nc);
+    for (int i = 0; i < nx * ny * nz; i++) {
+        if (map[i] >= 0) {
+            centroids[map[i]] = i % nx;
+            centroids[map[i] + nc] = (i / nx) % ny;
+            centroids[map[i] + 2 * nc] = i / (nx * ny);
+        }
+    }
+    std::vector<int> left, right;
+    for (int k = 0; k < nz; k++) {
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                const int self = map[i + nx * (j + ny * k)];
+                if (self < 0) {
+                    continue;
+                }
+                const int nb[3] = {i + 1 < nx ? map[(i + 1) + nx * (j + ny * k)] : -1,
+                                   j + 1 < ny ? map[i + nx * ((j + 1) + ny * k)] : -1,
+                                   k + 1 < nz ? map[i + nx * (j + ny * (k + 1))] : -1};
+                for (int d = 0; d < 3; d++) {
+                    if (nb[d] >= 0) {
+                        left.push_back(self);
+                        right.push_back(nb[d]);
+                    }
+                }
+            }
+        }
+    }
+    const int nf = left.size();
+    t.nf = nf;
+    t.N.resize(2 * nf);
+    for (int f = 0; f < nf; f++) {
+        t.N[f] = left[f] + 1;
+        t.N[f + nf] = right[f] + 1;
+    }
+    if (order != "natural") {
+        std::vector<int> cellOrder(nc), faceOrder(nf), renum(nc);
+        if (order == "morton") {
+            mortonOrdering(nc, 3, centroids.data(), cellOrder.data());
+        } else {
+            rcmOrdering(nf, nc, t.N.data(), cellOrder.data());
+        }
+        faceOrdering(nf, nc, t.N.data(), cellOrder.data(), faceOrder.data());
+        for (int c = 0; c < nc; c++) {
+            renum[cellOrder[c]] = c;
+        }
+        for (int f = 0; f < nf; f++) {
+            const int old = faceOrder[f];
+            left[f] = renum[(int)t.N[old] - 1];
+            right[f] = renum[(int)t.N[old + nf] - 1];
+        }
+        for (int f = 0; f < nf; f++) {
+            t.N[f] = left[f] + 1;
+            t.N[f + nf] = right[f] + 1;
+        }
+    }
+    // Same layout as getMexDiscreteDivergenceJacPrecomputes: half-faces
+    // sorted by (self, other, face).
+    std::vector<int> count(nc, 0);
+    for (int f = 0; f < nf; f++) {
+        count[left[f]]++;
+        count[right[f]]++;
+    }
+    t.facePos.assign(nc + 1, 0);
+    for (int c = 0; c < nc; c++) {
+        t.facePos[c + 1] = t.facePos[c] + count[c];
+    }
+    std::vector<std::vector<std::pair<int, int> > > hf(nc);
+    for (int f = 0; f < nf; f++) {
+        hf[left[f]].push_back(std::make_pair(right[f], f));
+        hf[right[f]].push_back(std::make_pair(left[f], f));
+    }
+    t.faces.resize(2 * nf);
+    t.cells.resize(2 * nf);
+    t.cellsIx.resize(nc);
+    for (int c = 0; c < nc; c++) {
+        std::sort(hf[c].begin(), hf[c].end());
+        int pos = t.facePos[c];
+        int lower = 0;
+        for (size_t i = 0; i < hf[c].size(); i++) {
+            const int other = hf[c][i].first;
+            const int f = hf[c][i].second;
+            const int sign = (left[f] != c) ? 1 : -1;
+            t.faces[pos + i] = f;
+            t.cells[pos + i] = sign * (other + 1);
+            lower += other < c;
+        }
+        t.cellsIx[c] = lower;
+    }
+    return t;
+}
+
+template <class Fn>
+double timeKernel(Fn fn, const int reps) {
+    fn(); // Warm-up, first touch
+    std::vector<double> t(reps);
+    for (int r = 0; r < reps; r++) {
+        auto start = TIME_NOW();
+        fn();
+        auto stop = TIME_NOW();
+        t[r] = std::chrono::duration<double>(stop - start).count();
+    }
+    std::sort(t.begin(), t.end());
+    return t[reps / 2];
+}
+
+// STREAM triad a = b + s*c, used as the bandwidth roofline.
+double streamTriad(const size_t n, const int reps) {
+    std::vector<double> a(n), b(n, 1.0), c(n, 2.0);
+    const double s = 3.0;
+    double time = timeKernel([&]() {
+        #pragma omp parallel for schedule(static)
+        for (long i = 0; i < (long)n; i++) {
+            a[i] = b[i] + s * c[i];
+        }
+    }, reps);
+    return 3.0 * sizeof(double) * n / time;
+}
+
+void report(const Topology & t, const char * kernel, const int m, const int threads,
+            const double time, const double bytes, const double roofline) {
+    const double bw = bytes / time;
+    std::printf("%-8s %-14s %3d %4d %10.3f %9.2f %7.1f%%\n", t.name.c_str(), kernel, m, threads,
+                1e3 * time, bw * 1e-9, 100.0 * bw / roofline);
+}
+
+void benchmarkTopology(const Topology & t, const std::vector<int> & ms, const int threads,
+                       const int reps, const double roofline) {
+    const int nc = t.nc;
+    const int nf = t.nf;
+    const long nhf = t.facePos[nc];
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    std::vector<double> value(nc), faceValue(nf), v(nc);
+    std::vector<unsigned char> flag(nf);
+    for (int i = 0; i < nc; i++) {
+        value[i] = u(gen);
+        v[i] = u(gen);
+    }
+    for (int f = 0; f < nf; f++) {
+        flag[f] = u(gen) > 0.5;
+    }
+    // Value-only upwind does not depend on m
+    double time = timeKernel([&]() {
+        upwind<unsigned char>(nf, nc, 1, value.data(), t.N.data(), flag.data(), faceValue.data());
+    }, reps);
+    report(t, "upwind", 1, threads, time, nf * (1.0 + 3 * 8.0), roofline);
+
+    for (size_t k = 0; k < ms.size(); k++) {
+        const int m = ms[k];
+        std::vector<double> cellDiag((size_t)nc * m), faceDiag(2 * (size_t)nf * m), out((size_t)nc * m);
+        for (size_t i = 0; i < cellDiag.size(); i++) {
+            cellDiag[i] = u(gen);
+        }
+        for (size_t i = 0; i < faceDiag.size(); i++) {
+            faceDiag[i] = u(gen);
+        }
+        // All kernels benchmarked in row-major layout, which is what the
+        // MEX-enabled diagonal backend uses.
+        time = timeKernel([&]() {
+            diagMult(nc, m, v.data(), cellDiag.data(), out.data());
+        }, reps);
+        report(t, "diagMult", m, threads, time, 8.0 * nc * (2.0 * m + 1), roofline);
+
+        time = timeKernel([&]() {
+            upwindJacMain<true, unsigned char>(m, nf, nc, flag.data(), cellDiag.data(), t.N.data(), faceDiag.data());
+        }, reps);
+        report(t, "upwindJac", m, threads, time, nf * (1.0 + 8.0 + 8.0 * m + 16.0 * m), roofline);
+
+        time = timeKernel([&]() {
+            gradientJacMain<true>(m, nf, nc, cellDiag.data(), t.N.data(), faceDiag.data());
+        }, reps);
+        report(t, "gradientJac", m, threads, time, nf * (16.0 + 32.0 * m), roofline);
+
+        const size_t nzmax = (size_t)(nhf + nc) * m;
+        std::vector<double> pr(nzmax);
+        std::vector<size_t> ir(nzmax), jc((size_t)nc * m + 1, 0);
+        time = timeKernel([&]() {
+            divergenceJacMain<true, false>(nf, nc, m, t.N.data(), t.facePos.data(), t.faces.data(),
+                                           t.cells.data(), t.cellsIx.data(), cellDiag.data(),
+                                           faceDiag.data(), pr.data(), ir.data(), jc.data());
+        }, reps);
+        report(t, "divergenceJac", m, threads, time,
+               16.0 * nc + 16.0 * nhf + 8.0 * nhf * m + 8.0 * nc * m + 16.0 * nzmax + 8.0 * nc * m, roofline);
+
+        std::vector<double> spr((size_t)nc * m);
+        std::vector<size_t> sir((size_t)nc * m), sjc((size_t)nc * m + 1);
+        time = timeKernel([&]() {
+            jac_to_sparse<true>(nc, m, nc, cellDiag.data(), (const double *)NULL, spr.data(), sir.data(), sjc.data());
+        }, reps);
+        report(t, "jac_to_sparse", m, threads, time, 32.0 * nc * m, roofline);
+    }
+}
+
+std::vector<int> parseList(const char * s) {
+    std::vector<int> out;
+    std::string str(s);
+    size_t start = 0;
+    while (start <= str.size()) {
+        size_t end = str.find(',', start);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+        if (end > start) {
+            out.push_back(std::atoi(str.substr(start, end - start).c_str()));
+        }
+        start = end + 1;
+    }
+    return out;
+}
+
+int main(int argc, char ** argv) {
+    std::vector<std::string> cases;
+    std::vector<int> ms = {1, 2, 3, 5, 8};
+    std::vector<int> threads;
+    int reps = 10;
+    double inactive = 0.26;
+    size_t streamSize = 1 << 23;
+    std::string order = "natural";
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--case") && hasValue) {
+            cases.push_back(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--m") && hasValue) {
+            ms = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && hasValue) {
+            threads = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--reps") && hasValue) {
+            reps = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--inactive") && hasValue) {
+            inactive = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--stream-size") && hasValue) {
+            streamSize = std::atol(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--order") && hasValue) {
+            order = argv[++i];
+            if (order != "natural" && order != "rcm" && order != "morton") {
+                std::fprintf(stderr, "Unknown ordering %s\n", order.c_str());
+                return 1;
+            }
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (cases.empty()) {
+        cases.push_back("egg");
+        cases.push_back("spe10");
+    }
+    if (threads.empty()) {
+#ifdef _OPENMP
+        for (int n = 1; n < omp_get_max_threads(); n *= 2) {
+            threads.push_back(n);
+        }
+        threads.push_back(omp_get_max_threads());
+#else
+        threads.push_back(1);
+#endif
+    }
+    std::vector<Topology> topologies;
+    for (size_t i = 0; i < cases.size(); i++) {
+        int nx, ny, nz;
+        if (cases[i] == "egg") {
+            // 60 x 60 x 7 with ~26% inactive gives the 18.5k active cells of the Egg model
+            topologies.push_back(makeTopology("egg", 60, 60, 7, inactive, order));
+        } else if (cases[i] == "spe10") {
+            topologies.push_back(makeTopology("spe10", 60, 220, 85, 0.0, order));
+        } else if (std::sscanf(cases[i].c_str(), "%dx%dx%d", &nx, &ny, &nz) == 3) {
+            topologies.push_back(makeTopology(cases[i], nx, ny, nz, inactive, order));
+        } else {
+            std::fprintf(stderr, "Unknown case %s\n", cases[i].c_str());
+            return 1;
+        }
+        std::printf("# %s: %d cells, %d faces, %s ordering\n", topologies.back().name.c_str(),
+                    topologies.back().nc, topologies.back().nf, order.c_str());
+    }
+    std::printf("%-8s %-14s %3s %4s %10s %9s %8s\n", "case", "kernel", "m", "thr", "time[ms]", "GB/s", "roof");
+    for (size_t k = 0; k < threads.size(); k++) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads[k]);
+#endif
+        const double roofline = streamTriad(streamSize, reps);
+        std::printf("# threads = %d, STREAM triad %.2f GB/s\n", threads[k], roofline * 1e-9);
+        for (size_t i = 0; i < topologies.size(); i++) {
+            benchmarkTopology(topologies[i], ms, threads[k], reps, roofline);
+        }
+    }
+    return 0;
+}
@@ -40,7 +40,10 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
                  'mexTwoPointGradientDiagonalJac', ...
                  'mexTwoPointGradientVal', ...
                  'mexDiagMult', ...
-                 'mexDiagProductMult'};
+                 'mexDiagProductMult', ...
+                 'mexFaceAverageBatch', ...
+                 'mexSinglePointUpwindBatch', ...
+                 'mexCellOrdering'};
     else
         names = opt.names;
         if ~iscell(names)
@@ -0,0 +1,167 @@
+#ifndef MRST_KERNELS_CELL_ORDERING_H
+#define MRST_KERNELS_CELL_ORDERING_H
+//
+// Cell and face orderings that improve locality of the two-point operators.
+//
+// All orderings are zero-based and given as order[new] = old. The face
+// ordering sorts faces by their (lower, upper) renumbered neighbour so that
+// both N(:, 1) and N(:, 2) are traversed close to monotonically.
+//
+#include <algorithm>
+#include <cstdlib>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+// Symmetric compressed adjacency from a one-based neighbourship [nf x 2].
+inline void cellAdjacency(const int nf, const int nc, const double * N,
+                          std::vector<int> & pos, std::vector<int> & adj) {
+    pos.assign(nc + 1, 0);
+    for (int f = 0; f < nf; f++) {
+        pos[(int)N[f]]++;
+        pos[(int)N[f + nf]]++;
+    }
+    for (int c = 0; c < nc; c++) {
+        pos[c + 1] += pos[c];
+    }
+    adj.resize(pos[nc]);
+    std::vector<int> next(pos.begin(), pos.end() - 1);
+    for (int f = 0; f < nf; f++) {
+        const int left = N[f] - 1;
+        const int right = N[f + nf] - 1;
+        adj[next[left]++] = right;
+        adj[next[right]++] = left;
+    }
+}
+
+// Breadth-first traversal from root, visiting neighbours by increasing
+// degree. Appends the visited cells to order, stores the distance from the
+// root in level and returns the number of levels.
+inline int bfsLevels(const int root, const std::vector<int> & pos, const std::vector<int> & adj,
+                     std::vector<int> & mark, const int tag, std::vector<int> & order,
+                     std::vector<int> & level) {
+    const size_t start = order.size();
+    order.push_back(root);
+    mark[root] = tag;
+    level[root] = 0;
+    std::vector<std::pair<int, int> > nb;
+    for (size_t i = start; i < order.size(); i++) {
+        const int c = order[i];
+        nb.clear();
+        for (int j = pos[c]; j < pos[c + 1]; j++) {
+            const int o = adj[j];
+            if (mark[o] != tag) {
+                mark[o] = tag;
+                level[o] = level[c] + 1;
+                nb.push_back(std::make_pair(pos[o + 1] - pos[o], o));
+            }
+        }
+        std::sort(nb.begin(), nb.end());
+        for (size_t j = 0; j < nb.size(); j++) {
+            order.push_back(nb[j].second);
+        }
+    }
+    return level[order.back()] + 1;
+}
+
+// Reverse Cuthill-McKee. Each connected component is started from a
+// pseudo-peripheral cell found by repeated breadth-first searches.
+inline void rcmOrdering(const int nf, const int nc, const double * N, int * order) {
+    std::vector<int> pos, adj;
+    cellAdjacency(nf, nc, N, pos, adj);
+    std::vector<int> mark(nc, -1), level(nc, 0), done(nc, 0);
+    std::vector<int> result, trial;
+    result.reserve(nc);
+    int tag = 0;
+    for (int seed = 0; seed < nc; seed++) {
+        if (done[seed]) {
+            continue;
+        }
+        int root = seed;
+        trial.clear();
+        int depth = bfsLevels(root, pos, adj, mark, tag++, trial, level);
+        for (;;) {
+            // Lowest degree cell in the last level
+            int candidate = -1;
+            for (size_t i = trial.size(); i-- > 0 && level[trial[i]] == depth - 1;) {
+                const int c = trial[i];
+                if (candidate < 0 || pos[c + 1] - pos[c] < pos[candidate + 1] - pos[candidate]) {
+                    candidate = c;
+                }
+            }
+            std::vector<int> next;
+            next.reserve(trial.size());
+            const int d = bfsLevels(candidate, pos, adj, mark, tag++, next, level);
+            if (d <= depth) {
+                break;
+            }
+            depth = d;
+            root = candidate;
+            trial.swap(next);
+        }
+        const size_t offset = result.size();
+        bfsLevels(root, pos, adj, mark, tag++, result, level);
+        for (size_t i = offset; i < result.size(); i++) {
+            done[result[i]] = 1;
+        }
+    }
+    for (int i = 0; i < nc; i++) {
+        order[i] = result[nc - 1 - i];
+    }
+}
+
+// Spread the lower bits of x so that there are (dim - 1) zero bits between each.
+inline uint64_t spreadBits(uint64_t x, const int dim) {
+    uint64_t out = 0;
+    for (int b = 0; b < 64 / dim; b++) {
+        out |= ((x >> b) & 1) << (dim * b);
+    }
+    return out;
+}
+
+// Morton (Z-order) space-filling curve over cell centroids [nc x dim].
+inline void mortonOrdering(const int nc, const int dim, const double * centroids, int * order) {
+    // Same bit budget as the MATLAB fallback, where keys are doubles
+    const int bits = std::min(52 / dim, 32);
+    const double scale = (double)(((uint64_t)1 << bits) - 1);
+    std::vector<std::pair<uint64_t, int> > key(nc);
+    for (int c = 0; c < nc; c++) {
+        key[c] = std::make_pair((uint64_t)0, c);
+    }
+    for (int d = 0; d < dim; d++) {
+        const double * x = centroids + (size_t)nc * d;
+        double lo = x[0], hi = x[0];
+        for (int c = 1; c < nc; c++) {
+            lo = std::min(lo, x[c]);
+            hi = std::max(hi, x[c]);
+        }
+        const double h = hi > lo ? scale / (hi - lo) : 0.0;
+        for (int c = 0; c < nc; c++) {
+            key[c].first |= spreadBits((uint64_t)((x[c] - lo) * h), dim) << d;
+        }
+    }
+    std::sort(key.begin(), key.end());
+    for (int c = 0; c < nc; c++) {
+        order[c] = key[c].second;
+    }
+}
+
+// Faces sorted by (min, max) of the renumbered neighbours.
+inline void faceOrdering(const int nf, const int nc, const double * N, const int * cellOrder, int * order) {
+    std::vector<int> renum(nc);
+    for (int i = 0; i < nc; i++) {
+        renum[cellOrder[i]] = i;
+    }
+    std::vector<std::pair<std::pair<int, int>, int> > key(nf);
+    for (int f = 0; f < nf; f++) {
+        const int left = renum[(int)N[f] - 1];
+        const int right = renum[(int)N[f + nf] - 1];
+        key[f] = std::make_pair(std::make_pair(std::min(left, right), std::max(left, right)), f);
+    }
+    std::sort(key.begin(), key.end());
+    for (int f = 0; f < nf; f++) {
+        order[f] = key[f].second;
+    }
+}
+
+#endif // MRST_KERNELS_CELL_ORDERING_H
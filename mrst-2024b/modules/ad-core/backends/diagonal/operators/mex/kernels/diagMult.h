@@ -0,0 +1,26 @@
+#ifndef MRST_KERNELS_DIAG_MULT_H
+#define MRST_KERNELS_DIAG_MULT_H
+//
+// Row-major diagonal Jacobian scaled by a cell-wise vector.
+//
+#include <cstdlib>
+#include "../mexOperatorPolicy.h"
+
+template <class V_type>
+void diagMult(const size_t n, const size_t m, const V_type * v, const double* D, double* out) {
+    const OperatorThreads threads((long)n * m);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int i = 0; i < n; i++) {
+        const double vi = v[i];
+        for (int j = i * m; j < (i + 1) * m; j++) {
+            out[j] = D[j] * vi;
+        }
+    }
+}
+
+template <int m, class V_type>
+void diagMult(const size_t n, const V_type* v, const double* D, double* out) {
+    diagMult(n, m, v, D, out);
+}
+
+#endif // MRST_KERNELS_DIAG_MULT_H
@@ -0,0 +1,38 @@
+#ifndef MRST_KERNELS_JAC_TO_SPARSE_H
+#define MRST_KERNELS_JAC_TO_SPARSE_H
+//
+// Diagonal Jacobian converted to compressed sparse column storage.
+//
+#include <cstdlib>
+#include "../mexOperatorPolicy.h"
+
+template <bool rowMajor, typename indexType>
+void jac_to_sparse(const int l, const int n, const int m, const double* diagonal, const double* subset,
+    double* pr, indexType* ir, indexType* jc) {
+    const OperatorThreads threads((long)l * n);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int index = 0; index < l * n; index++) {
+        indexType ji, ii;
+        double d;
+        if (rowMajor) {
+            ji = index;
+            ii = index % m;
+            int der = index / m;
+            d = diagonal[ii * n + der];
+        } else {
+            ji = index;
+            ii = index % m;
+            d = diagonal[index];
+        }
+        // One entry per column
+        jc[index] = ji;
+        // Column index
+        ir[index] = ii;
+        // Actual derivative
+        pr[index] = d;
+    }
+    // Final entry, one per column
+    jc[l*n] = l*n;
+}
+
+#endif // MRST_KERNELS_JAC_TO_SPARSE_H
@@ -0,0 +1,28 @@
+#ifndef MRST_KERNELS_UPWIND_H
+#define MRST_KERNELS_UPWIND_H
+//
+// Single-point upwind of cell values.
+//
+#include <cstdlib>
+#include "../mexOperatorPolicy.h"
+
+template <class logic_type> 
+void upwind(const int nf, const int nc, const int dim, const double* value, const double* N, const logic_type * flag, double* result) {
+    const OperatorThreads threads((long)nf * dim);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for(int i=0;i<nf;i++){
+        int fpos = i + nf;
+        if(flag[i]){
+            fpos = i;
+        }
+        else{
+            fpos = i + nf;
+        }
+        int cell_inx = N[fpos] - 1;
+        for(int j =0; j<dim; j++){
+            result[i+nf*j] = value[cell_inx + nc*j];
+        }
+    }
+}
+
+#endif // MRST_KERNELS_UPWIND_H
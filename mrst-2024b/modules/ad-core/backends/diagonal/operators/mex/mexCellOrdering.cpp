@@ -0,0 +1,128 @@
+//
+// include necessary system headers
+//
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include "kernels/cellOrdering.h"
+#ifdef MRST_OCTEXT
+    #include <octave/oct.h>
+    #include <octave/dMatrix.h>
+#else
+    #include <mex.h>
+#endif
+
+// INPUTS:
+//  - N<double>             [nf x 2]
+//  - nc<double>            [scalar]
+//  - centroids<double>     [nc x dim] Cell centroids. If empty, reverse Cuthill-McKee is used,
+//                                     otherwise a Morton space-filling curve.
+// OUTPUT:
+//  - cell_order<double>    [nc x 1] One-based, new cell i is old cell cell_order(i)
+//  - face_order<double>    [nf x 1] One-based, new face i is old face face_order(i)
+const char* inputCheck(const int nin, const int nout, int & status_code){
+    if (nin == 0) {
+        if (nout > 0) {
+            status_code = -1;
+            return "Cannot give outputs with no inputs.";
+        }
+        // We are being called through compilation testing. Just do nothing.
+        // If the binary was actually called, we are good to go.
+        status_code = 1;
+        return "";
+    } else if (nin != 3) {
+        status_code = -2;
+        return "3 input arguments required: N, number of cells and centroids";
+    } else if (nout > 2) {
+        status_code = -3;
+        return "Too many outputs requested. Out: Cell ordering and face ordering";
+    } else {
+        // All ok.
+        status_code = 0;
+        return "";
+    }
+}
+
+void cellOrdering(const int nf, const int nc, const double * N,
+                  const double * centroids, const int dim,
+                  double * cell_order, double * face_order) {
+    std::vector<int> cells(nc), faces(nf);
+    if (dim > 0) {
+        mortonOrdering(nc, dim, centroids, cells.data());
+    } else {
+        rcmOrdering(nf, nc, N, cells.data());
+    }
+    faceOrdering(nf, nc, N, cells.data(), faces.data());
+    for (int i = 0; i < nc; i++) {
+        cell_order[i] = cells[i] + 1;
+    }
+    for (int i = 0; i < nf; i++) {
+        face_order[i] = faces[i] + 1;
+    }
+}
+
+#ifdef MRST_OCTEXT
+    /* OCT gateway */
+    DEFUN_DLD (mexCellOrdering, args, nargout,
+               "Cell and face ordering for the diagonal AD operators.")
+    {
+        const int nrhs = args.length();
+        const int nlhs = nargout;
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            error(msg);
+        }else if (status_code == 1){
+            // Early return
+            return octave_value_list();
+        }
+        const NDArray N_nd = args(0).array_value();
+        int nc = args(1).scalar_value();
+        const NDArray centroids_nd = args(2).array_value();
+
+        int nf = N_nd.rows();
+        int dim = centroids_nd.numel() > 0 ? centroids_nd.cols() : 0;
+        if (dim > 0 && centroids_nd.rows() != nc) {
+            error("Centroids must have one row per cell.");
+        }
+        NDArray cell_order(dim_vector(nc, 1));
+        NDArray face_order(dim_vector(nf, 1));
+        cellOrdering(nf, nc, N_nd.data(), centroids_nd.data(), dim,
+                     cell_order.fortran_vec(), face_order.fortran_vec());
+
+        octave_value_list retval;
+        retval(0) = octave_value(cell_order);
+        retval(1) = octave_value(face_order);
+        return retval;
+    }
+#else
+    /* MEX gateway */
+    void mexFunction( int nlhs, mxArray *plhs[],
+              int nrhs, const mxArray *prhs[] )
+
+    {
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            mexErrMsgTxt(msg);
+        }else if (status_code == 1){
+            // Early return
+            return;
+        }
+        const double * N = mxGetPr(prhs[0]);
+        int nc = mxGetScalar(prhs[1]);
+        const double * centroids = mxGetPr(prhs[2]);
+
+        int nf = mxGetM(prhs[0]);
+        int dim = mxIsEmpty(prhs[2]) ? 0 : mxGetN(prhs[2]);
+        if (dim > 0 && mxGetM(prhs[2]) != nc) {
+            mexErrMsgTxt("Centroids must have one row per cell.");
+        }
+        plhs[0] = mxCreateUninitNumericMatrix(nc, 1, mxDOUBLE_CLASS, mxREAL);
+        plhs[1] = mxCreateUninitNumericMatrix(nf, 1, mxDOUBLE_CLASS, mxREAL);
+        cellOrdering(nf, nc, N, centroids, dim, mxGetPr(plhs[0]), mxGetPr(plhs[1]));
+        return;
+    }
+#endif
@@ -1,6 +1,7 @@
 #include <omp.h>
 #include <chrono>
 #include <iostream>
+#include "kernels/diagMult.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -11,22 +12,6 @@
     #endif
 #endif
 
-template <int m, class V_type>
-void diagMult(const size_t n, const V_type* v, const double* D, double* out) {
-    diagMult(n, m, v, D, out);
-}
-
-template <class V_type>
-void diagMult(const size_t n, const size_t m, const V_type * v, const double* D, double* out) {
-#pragma omp parallel for
-    for (int i = 0; i < n; i++) {
-        const double vi = v[i];
-        for (int j = i * m; j < (i + 1) * m; j++) {
-            out[j] = D[j] * vi;
-        }
-    }
-}
-
 #ifdef MRST_OCTEXT
     /* OCT gateway */
     DEFUN_DLD (mexDiagMult, args, nargout,
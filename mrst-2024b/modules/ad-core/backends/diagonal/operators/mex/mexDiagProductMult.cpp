@@ -1,6 +1,8 @@
 #include <omp.h>
 #include <chrono>
 #include <iostream>
+#include "mexOperatorPolicy.h"
+#include <vector>
 
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
@@ -12,35 +14,126 @@
     #endif
 #endif
 
-// #define operation diagMultBLAS
-#define operation diagProductMult
+// INPUTS:
+//  - D1<double> [m x n], v1<double> [n x 1], ..., Dk<double> [m x n], vk<double> [n x 1]
+//  - rowMajor<bool>     [scalar]
+// OUTPUT:
+//  - sum_r D_r .* v_r'  [m x n]
+//
+// All k products are accumulated in a single pass over the diagonals, so
+// the output block for each cell is written once while it is still in
+// cache instead of once per pairwise product.
+
+void diagProductMultScalar(const size_t n, const int k,
+                           const double* const* v, const double* const* D, double* out) {
+    const OperatorThreads threads((long)n * k);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int i = 0; i < n; i++) {
+        double s = v[0][i] * D[0][i];
+        for (int r = 1; r < k; r++) {
+            s += v[r][i] * D[r][i];
+        }
+        out[i] = s;
+    }
+}
 
-void diagProductMult(const size_t n, const size_t m,
-                                     const double* v1, const double* D1,
-                                     const double* v2, const double* D2, double* out) {
-    #pragma omp parallel for schedule(static)
+void diagProductMult(const size_t n, const size_t m, const int k,
+                     const double* const* v, const double* const* D, double* out) {
+    const OperatorThreads threads((long)n * m * k);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
     for (int i = 0; i < n; i++) {
-        auto v1_i = v1[i];
-        auto v2_i = v2[i];
+        const double v0_i = v[0][i];
+        const double* D0 = D[0];
         for (int j = m * i; j < m * (i + 1); j++) {
-            out[j] = v1_i * D1[j] + v2_i * D2[j];
+            out[j] = v0_i * D0[j];
+        }
+        for (int r = 1; r < k; r++) {
+            const double vr_i = v[r][i];
+            const double* Dr = D[r];
+            for (int j = m * i; j < m * (i + 1); j++) {
+                out[j] += vr_i * Dr[j];
+            }
         }
     }
 }
 
 template <int m>
-void diagProductMult(const size_t n,
-    const double* v1, const double* D1,
-    const double* v2, const double* D2, double* out) {
-    diagProductMult(n, m, v1, D1, v2, D2, out);
+void diagProductMult(const size_t n, const int k,
+                     const double* const* v, const double* const* D, double* out) {
+    const OperatorThreads threads((long)n * m * k);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int i = 0; i < n; i++) {
+        double acc[m];
+        const double v0_i = v[0][i];
+        const double* D0 = D[0] + m * i;
+        for (int j = 0; j < m; j++) {
+            acc[j] = v0_i * D0[j];
+        }
+        for (int r = 1; r < k; r++) {
+            const double vr_i = v[r][i];
+            const double* Dr = D[r] + m * i;
+            for (int j = 0; j < m; j++) {
+                acc[j] += vr_i * Dr[j];
+            }
+        }
+        for (int j = 0; j < m; j++) {
+            out[m * i + j] = acc[j];
+        }
+    }
 }
 
+void diagProductMultMain(const size_t n, const size_t m, const int k,
+                         const double* const* v, const double* const* D, double* out) {
+    switch (m) {
+        case 1:
+            diagProductMultScalar(n, k, v, D, out);
+            break;
+        case 2:
+            diagProductMult<2>(n, k, v, D, out);
+            break;
+        case 3:
+            diagProductMult<3>(n, k, v, D, out);
+            break;
+        case 4:
+            diagProductMult<4>(n, k, v, D, out);
+            break;
+        case 5:
+            diagProductMult<5>(n, k, v, D, out);
+            break;
+        case 6:
+            diagProductMult<6>(n, k, v, D, out);
+            break;
+        case 7:
+            diagProductMult<7>(n, k, v, D, out);
+            break;
+        case 8:
+            diagProductMult<8>(n, k, v, D, out);
+            break;
+        default:
+            diagProductMult(n, m, k, v, D, out);
+    }
+}
 
-void diagProductMultScalar(const size_t n, const double* v1, const double* D1,
-                                           const double* v2, const double* D2, double* out) {
-#pragma omp parallel for schedule(static)
-    for (int i = 0; i < n; i++) {
-        out[i] = v1[i]*D2[i] +  v1[i]*D2[i];
+const char* inputCheck(const int nin, const int nout, int & status_code){
+    if (nin == 0) {
+        if (nout > 0) {
+            status_code = -1;
+            return "Cannot give outputs with no inputs.";
+        }
+        // We are being called through compilation testing. Just do nothing.
+        // If the binary was actually called, we are good to go.
+        status_code = 1;
+        return "";
+    } else if (nin < 3 || nin % 2 == 0) {
+        status_code = -2;
+        return "Input must be pairs of diagonal and vector (D1, v1, ..., Dk, vk) followed by rowMajor bool.";
+    } else if (nout > 1) {
+        status_code = -3;
+        return "Too many outputs requested. Function has a single output argument.";
+    } else {
+        // All ok.
+        status_code = 0;
+        return "";
     }
 }
 
@@ -51,43 +144,44 @@ void diagProductMultScalar(const size_t n, const double* v1, const double* D1,
     {
         const int nrhs = args.length();
         const int nlhs = nargout;
-        if (nrhs == 0) {
-            if (nlhs > 0) {
-                error("Cannot give outputs with no inputs.");
-            }
-            // We are being called through compilation testing. Just do nothing. 
-            // If the binary was actually called, we are good to go.
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            error(msg);
+        }else if (status_code == 1){
+            // Early return
             return octave_value_list();
         }
-        // D, v, B, w, rowMajor
-
-        // Matrices
-        const NDArray D_nd = args(0).array_value();
-        const NDArray B_nd = args(2).array_value();
-        // Vectors
-        const NDArray v_nd = args(1).array_value();
-        const NDArray w_nd = args(3).array_value();
-
-        // D
-        int m = D_nd.rows();
-        int n = D_nd.cols();
-        // D+B ptrs
-        const double * d_ptr = D_nd.data();
-        const double * b_ptr = B_nd.data();
-        // v+w ptrs
-        const double* v_ptr = v_nd.data();
-        const double* w_ptr = w_nd.data();
-
-        bool rowMajor = args(4).scalar_value();
-
+        // D1, v1, ..., Dk, vk, rowMajor
+        const int k = (nrhs - 1) / 2;
+        bool rowMajor = args(nrhs - 1).scalar_value();
         if (!rowMajor) {
             error("Column major not supported for this mex file.");
         }
-
+        // Keep the arrays alive while we hold pointers into them
+        std::vector<NDArray> D_nd(k), v_nd(k);
+        std::vector<const double*> d_ptr(k), v_ptr(k);
+        for (int r = 0; r < k; r++) {
+            D_nd[r] = args(2*r).array_value();
+            v_nd[r] = args(2*r + 1).array_value();
+            d_ptr[r] = D_nd[r].data();
+            v_ptr[r] = v_nd[r].data();
+        }
+        int m = D_nd[0].rows();
+        int n = D_nd[0].cols();
+        for (int r = 0; r < k; r++) {
+            if (D_nd[r].rows() != m || D_nd[r].cols() != n) {
+                error("All diagonals must have the same dimensions.");
+            }
+            if (v_nd[r].numel() != n) {
+                error("Vector length must match the number of columns in the diagonal.");
+            }
+        }
         NDArray output({m, n});
         double * out_ptr = output.fortran_vec();
 
-        diagProductMult(n, m, v_ptr, d_ptr, w_ptr, b_ptr, out_ptr);
+        diagProductMultMain(n, m, k, v_ptr.data(), d_ptr.data(), out_ptr);
         return octave_value (output);
     }
 #else
@@ -95,31 +189,42 @@ void diagProductMultScalar(const size_t n, const double* v1, const double* D1,
         int nrhs, const mxArray* prhs[])
 
     {
-        if (nrhs == 0) {
-            if (nlhs > 0) {
-                mexErrMsgTxt("Cannot give outputs with no inputs.");
-            }
-            // We are being called through compilation testing. Just do nothing. 
-            // If the binary was actually called, we are good to go.
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            mexErrMsgTxt(msg);
+        }else if (status_code == 1){
+            // Early return
             return;
         }
-        // In: diagonal (m x nc), v (nc x 1)
+        // In: diagonal (m x nc), v (nc x 1), repeated k times, then rowMajor
+        const int k = (nrhs - 1) / 2;
         int n = mxGetN(prhs[0]);
         int m = mxGetM(prhs[0]);
-        bool rowMajor = mxGetScalar(prhs[4]);
+        bool rowMajor = mxGetScalar(prhs[nrhs - 1]);
 
         if (!rowMajor) {
             mexErrMsgTxt("Column major not supported for this mex file.");
         }
-        const double* v_ptr = mxGetPr(prhs[1]);
-        const double* w_ptr = mxGetPr(prhs[3]);
-
-        double* d_ptr = mxGetPr(prhs[0]);
-        double* b_ptr = mxGetPr(prhs[2]);
-
+        std::vector<const double*> d_ptr(k), v_ptr(k);
+        for (int r = 0; r < k; r++) {
+            const mxArray* D = prhs[2*r];
+            const mxArray* v = prhs[2*r + 1];
+            if (mxGetM(D) != m || mxGetN(D) != n) {
+                mexErrMsgTxt("All diagonals must have the same dimensions.");
+            }
+            if (mxGetNumberOfElements(v) != n) {
+                mexErrMsgTxt("Vector length must match the number of columns in the diagonal.");
+            }
+            if (!mxIsDouble(D) || !mxIsDouble(v)) {
+                mexErrMsgTxt("Diagonals and vectors must be double.");
+            }
+            d_ptr[r] = mxGetPr(D);
+            v_ptr[r] = mxGetPr(v);
+        }
         plhs[0] = mxCreateUninitNumericMatrix(m, n, mxDOUBLE_CLASS, mxREAL);
         double* out_ptr = mxGetPr(plhs[0]);
-        diagProductMult(n, m, v_ptr, d_ptr, w_ptr, b_ptr, out_ptr);
+        diagProductMultMain(n, m, k, v_ptr.data(), d_ptr.data(), out_ptr);
     };
 #endif
-
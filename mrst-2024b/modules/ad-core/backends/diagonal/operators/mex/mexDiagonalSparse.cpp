@@ -8,36 +8,9 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "kernels/jacToSparse.h"
 /* MEX gateway */
 
-template <bool rowMajor, typename indexType>
-void jac_to_sparse(const int l, const int n, const int m, const double* diagonal, const double* subset,
-    double* pr, indexType* ir, indexType* jc) {
-#pragma omp parallel for
-    for (int index = 0; index < l * n; index++) {
-        mwIndex ji, ii;
-        double d;
-        if (rowMajor) {
-            ji = index;
-            ii = index % m;
-            int der = index / m;
-            d = diagonal[ii * n + der];
-        } else {
-            ji = index;
-            ii = index % m;
-            d = diagonal[index];
-        }
-        // One entry per column
-        jc[index] = ji;
-        // Column index
-        ir[index] = ii;
-        // Actual derivative
-        pr[index] = d;
-    }
-    // Final entry, one per column
-    jc[l*n] = l*n;
-}
-
 void mexFunction( int nlhs, mxArray *plhs[], 
 		  int nrhs, const mxArray *prhs[] )
      
@@ -13,6 +13,7 @@
 #include <omp.h>
 #endif
 #include <iostream>
+#include "mexOperatorPolicy.h"
 #include <chrono>
 #include <vector>
 
@@ -29,7 +30,8 @@ void divergenceJacBlock(const int nf, const int nc, const int njac,
     double* pr, idx_type * ir, idx_type * jc) {
     int mv = facePos[nc];
     int jac_val_width = nder * njac;
-    #pragma omp parallel for
+    const OperatorThreads threads((long)(mv + nc) * jac_val_width);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
     for (int cell = 0; cell < nc; cell++) {
         // Each cell has number of connections equal to the number of half-
         // faces for that cell plus itself multiplied by the block size
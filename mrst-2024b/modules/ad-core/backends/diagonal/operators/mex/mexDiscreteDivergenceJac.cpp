@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "kernels/divergenceJac.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -48,243 +49,6 @@ const char* inputCheck(const int nin, const int nout, int & status_code){
     }
 }
 
-template <bool colMajor, bool lower, class index_t>
-void copyFaceData(const int c, const int nf, const int m, const int diag, const int passed, 
-                const int sparse_mult, const int cell_offset, const int f, const int fl, const double* diagonal, double* pr, index_t* ir, index_t* jc) {
-    for (int der = 0; der < m; der++) {
-        double v;
-        int sparse_offset = der * sparse_mult + cell_offset;
-        if (lower) { // c < 0
-            // Low entry, corresponding to N(f, 1)
-            if (colMajor) {
-                v = -diagonal[der * nf + f];
-            }
-            else {
-                v = -diagonal[f * 2 * m + der];
-            }
-            ir[sparse_offset + fl + passed] = -c;
-        }
-        else {
-            // High entry, corresponding to N(f, 2)
-            if (colMajor) {
-                v = diagonal[der * nf + f + m * nf];
-            }
-            else {
-                v = diagonal[(f * 2 + 1) * m + der];
-            }
-            // Set row entry
-            ir[sparse_offset + fl + passed] = c;
-        }
-        pr[sparse_offset + fl + passed] = v;
-        // Set corresponding diagonal entry
-        pr[sparse_offset + diag] -= v;
-    }
-}
-
-template <bool has_accumulation, bool colMajor, class index_t>
-void divergenceJac(const int nf, const int nc, const int m,
-    const double* N, const double* facePos, const double* faces,
-    const double* cells, const double* cells_ix,
-    const double* accumulation, const double* diagonal,
-    double* pr, index_t* ir, index_t* jc) {
-    int mv = facePos[nc];
-    #pragma omp parallel for
-    for (int cell = 0; cell < nc; cell++) {
-        // Each cell has number of connections equal to the number of half-
-        // faces for that cell plus itself multiplied by the block size
-        int f_offset = facePos[cell];
-        int n_local_hf = facePos[cell + 1] - f_offset;
-        int diag = cells_ix[cell];
-        int cell_offset = f_offset + cell;
-        for (int der = 0; der < m; der++) {
-            int ix = cell + der * nc;
-            // Base offset taking into account how far we have come
-            int base = der * (mv + nc) + cell_offset;
-            jc[cell + der * nc + 1] = base + n_local_hf + 1;
-            // Set diagonal entries
-            int dpos = base + cells_ix[cell];
-            ir[dpos] = cell;
-            if (has_accumulation) {
-                if (colMajor) {
-                    pr[dpos] = accumulation[der * nc + cell];
-                }
-                else {
-                    pr[dpos] = accumulation[cell * m + der];
-                }
-            }
-            else {
-                /* Not sure if this bit is needed - but the Matlab docs
-                   are vague on memory initialization for sparse arrays */
-                pr[dpos] = 0.0; 
-            }
-        }
-
-        for (int fl = 0; fl < n_local_hf; fl++) {
-            // Loop over entire column
-            // Diagonal entry can be skipped - we handle this later
-            // Check if we have passed diagonal entry
-            int passed = (double)(fl >= diag);
-            // Global face index
-            int f = faces[f_offset + fl];
-            // Global cell index
-            int c = cells[f_offset + fl];
-            // Iterate over derivatives
-            int sparse_mult = mv + nc;
-            // Copy the data from face jacobian stored in diagonal
-            if (c < 0) {
-                copyFaceData<colMajor, true>(c+1, nf, m, diag, passed, sparse_mult, cell_offset, f, fl, diagonal, pr, ir, jc);
-            }
-            else {
-                copyFaceData<colMajor, false>(c-1, nf, m, diag, passed, sparse_mult, cell_offset, f, fl, diagonal, pr, ir, jc);
-            }
-        }
-    }
-}
-
-template <int m, bool has_accumulation, bool colMajor, class index_t>
-void divergenceJac(const int nf, const int nc,
-    const double* N, const double* facePos, const double* faces,
-    const double* cells, const double* cells_ix,
-    const double* accumulation, const double* diagonal,
-    double* pr, index_t* ir, index_t* jc) {
-        divergenceJac<has_accumulation, colMajor>(nf, nc, m, N, facePos, faces, cells, cells_ix, accumulation, diagonal, pr, ir, jc);
-}
-
-
-template <bool has_accumulation, bool colMajor, class index_t>
-void divergenceJacMain(const int nf, const int nc, const int m,
-    const double* N, const double* facePos, const double* faces,
-    const double* cells, const double* cells_ix,
-    const double* accumulation, const double* diagonal,
-    double* pr, index_t* ir, index_t* jc){
-    switch (m) {
-    case 1:
-        divergenceJac<1, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 2:
-        divergenceJac<2, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 3:
-        divergenceJac<3, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 4:
-        divergenceJac<4, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 5:
-        divergenceJac<5, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 6:
-        divergenceJac<6, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 7:
-        divergenceJac<7, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 8:
-        divergenceJac<8, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 9:
-        divergenceJac<9, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 10:
-        divergenceJac<10, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 11:
-        divergenceJac<11, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 12:
-        divergenceJac<12, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 13:
-        divergenceJac<13, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 14:
-        divergenceJac<14, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 15:
-        divergenceJac<15, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 16:
-        divergenceJac<16, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 17:
-        divergenceJac<17, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 18:
-        divergenceJac<18, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 19:
-        divergenceJac<19, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 20:
-        divergenceJac<20, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 21:
-        divergenceJac<21, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 22:
-        divergenceJac<22, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 23:
-        divergenceJac<23, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 24:
-        divergenceJac<24, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 25:
-        divergenceJac<25, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 26:
-        divergenceJac<26, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 27:
-        divergenceJac<27, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 28:
-        divergenceJac<28, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 29:
-        divergenceJac<29, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    case 30:
-        divergenceJac<30, has_accumulation, colMajor>(nf, nc, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-        break;
-    default:
-        divergenceJac<has_accumulation, colMajor>(nf, nc, m, N, facePos, faces, cells, cells_ix,
-            accumulation, diagonal, pr, ir, jc);
-}
-
-}
-
 #ifdef MRST_OCTEXT
     /* OCT gateway */
     DEFUN_DLD (mexDiscreteDivergenceJac, args, nargout,
@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "mexOperatorPolicy.h"
 #include <chrono>
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
@@ -45,7 +46,8 @@ const char* inputCheck(const int nin, const int nout, int & status_code){
 template <bool has_accumulation> // nc, accumulation, flux, faces, facePos, N, result
 void divergenceVal(const int nc, const double * accumulation, const double * flux, const double * faces,
                    const double * facePos, const double * N, double * result){
-    #pragma omp parallel for
+    const OperatorThreads threads((long)facePos[nc] + nc);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
     for (int cell = 0; cell < (int)nc; cell++) {
         // Each cell has number of connections equal to the number of half-
         // faces for that cell plus itself multiplied by the block size
@@ -0,0 +1,255 @@
+//
+// include necessary system headers
+//
+#include <cmath>
+#include <vector>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+#include <iostream>
+#include "mexOperatorPolicy.h"
+#ifdef MRST_OCTEXT
+    #include <octave/oct.h>
+    #include <octave/dMatrix.h>
+    #include <octave/Cell.h>
+#else
+    #include <mex.h>
+#endif
+
+// INPUTS:
+//  - values{np}            Cell array of cell values<double> [nc x d_p]
+//  - diagonals{nd}         Cell array of cell diagonals<double> [nc x m_q] if column major or [m_q x nc] if row major
+//  - N<double>             [nf x 2]
+//  - nc<double>            [scalar]
+//  - rowMajor<bool>        [scalar]
+// OUTPUT:
+//  - face_values{np}       Cell array of face values<double> [nf x d_p]
+//  - face_diagonals{nd}    Cell array of face diagonals<double> [nf x 2*m_q] if column major or [2*m_q x nf] if row major
+//
+// All quantities are averaged in the same sweep over the faces, so N is
+// only streamed through once regardless of the number of phases.
+struct AverageValue {
+    const double * value;
+    double * result;
+    int dim;
+};
+
+struct AverageDiagonal {
+    const double * diagonal;
+    double * result;
+    int m;
+};
+
+const char* inputCheck(const int nin, const int nout, int & status_code){
+    if (nin == 0) {
+        if (nout > 0) {
+            status_code = -1;
+            return "Cannot give outputs with no inputs.";
+        }
+        // We are being called through compilation testing. Just do nothing.
+        // If the binary was actually called, we are good to go.
+        status_code = 1;
+        return "";
+    } else if (nin != 5) {
+        status_code = -2;
+        return "5 input arguments required: Values, diagonals, N, number of cells and rowMajor bool";
+    } else if (nout > 2) {
+        status_code = -3;
+        return "Too many outputs requested. Out: Face values and face diagonals";
+    } else {
+        // All ok.
+        status_code = 0;
+        return "";
+    }
+}
+
+template <bool rowMajor>
+void faceAverageBatch(const int nf, const int nc, const std::vector<AverageValue> & values,
+                      const std::vector<AverageDiagonal> & diagonals, const double * N) {
+    const int np = values.size();
+    const int nd = diagonals.size();
+    long width = 0;
+    for (int p = 0; p < np; p++) {
+        width += values[p].dim;
+    }
+    for (int q = 0; q < nd; q++) {
+        width += 2 * diagonals[q].m;
+    }
+    const OperatorThreads threads(nf * width);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int face = 0; face < nf; face++) {
+        const int left = N[face] - 1;
+        const int right = N[face + nf] - 1;
+        for (int p = 0; p < np; p++) {
+            const AverageValue & v = values[p];
+            for (int j = 0; j < v.dim; j++) {
+                v.result[face + nf * j] = 0.5 * (v.value[left + nc * j] + v.value[right + nc * j]);
+            }
+        }
+        for (int q = 0; q < nd; q++) {
+            const AverageDiagonal & d = diagonals[q];
+            const int m = d.m;
+            for (int der = 0; der < m; der++) {
+                if (rowMajor) {
+                    d.result[2 * m * face + der] = 0.5 * d.diagonal[m * left + der];
+                    d.result[2 * m * face + der + m] = 0.5 * d.diagonal[m * right + der];
+                } else {
+                    d.result[der * nf + face] = 0.5 * d.diagonal[nc * der + left];
+                    d.result[der * nf + face + m * nf] = 0.5 * d.diagonal[nc * der + right];
+                }
+            }
+        }
+    }
+}
+
+#ifdef MRST_OCTEXT
+    /* OCT gateway */
+    DEFUN_DLD (mexFaceAverageBatch, args, nargout,
+               "Batched face average operator for MRST - values and diagonal Jacobians.")
+    {
+        const int nrhs = args.length();
+        const int nlhs = nargout;
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            error(msg);
+        }else if (status_code == 1){
+            // Early return
+            return octave_value_list();
+        }
+        const Cell value_c = args(0).cell_value();
+        const Cell diagonal_c = args(1).cell_value();
+        const NDArray N_nd = args(2).array_value();
+        int nc = args(3).scalar_value();
+        bool rowMajor = args(4).scalar_value();
+
+        const double * N = N_nd.data();
+        int nf = N_nd.rows();
+        int np = value_c.numel();
+        int nd = diagonal_c.numel();
+        // Keep the arrays alive while we hold pointers into them
+        std::vector<NDArray> value_nd(np), value_out(np);
+        std::vector<NDArray> diagonal_nd(nd), diagonal_out(nd);
+        std::vector<AverageValue> values(np);
+        std::vector<AverageDiagonal> diagonals(nd);
+
+        Cell value_result(np, 1);
+        Cell diagonal_result(nd, 1);
+        for (int p = 0; p < np; p++) {
+            value_nd[p] = value_c(p).array_value();
+            if (value_nd[p].rows() != nc) {
+                error("Values must be double matrices with one row per cell.");
+            }
+            int dim = value_nd[p].cols();
+            value_out[p] = NDArray(dim_vector(nf, dim));
+            values[p].value = value_nd[p].data();
+            values[p].result = value_out[p].fortran_vec();
+            values[p].dim = dim;
+        }
+        for (int q = 0; q < nd; q++) {
+            diagonal_nd[q] = diagonal_c(q).array_value();
+            if ((rowMajor ? diagonal_nd[q].cols() : diagonal_nd[q].rows()) != nc) {
+                error("Diagonals must be double matrices with one entry per cell.");
+            }
+            int m = rowMajor ? diagonal_nd[q].rows() : diagonal_nd[q].cols();
+            if (rowMajor) {
+                diagonal_out[q] = NDArray(dim_vector(2 * m, nf));
+            } else {
+                diagonal_out[q] = NDArray(dim_vector(nf, 2 * m));
+            }
+            diagonals[q].diagonal = diagonal_nd[q].data();
+            diagonals[q].result = diagonal_out[q].fortran_vec();
+            diagonals[q].m = m;
+        }
+        if (rowMajor) {
+            faceAverageBatch<true>(nf, nc, values, diagonals, N);
+        } else {
+            faceAverageBatch<false>(nf, nc, values, diagonals, N);
+        }
+        for (int p = 0; p < np; p++) {
+            value_result(p) = octave_value(value_out[p]);
+        }
+        for (int q = 0; q < nd; q++) {
+            diagonal_result(q) = octave_value(diagonal_out[q]);
+        }
+        octave_value_list retval;
+        retval(0) = octave_value(value_result);
+        retval(1) = octave_value(diagonal_result);
+        return retval;
+    }
+#else
+    /* MEX gateway */
+    void mexFunction( int nlhs, mxArray *plhs[],
+              int nrhs, const mxArray *prhs[] )
+
+    {
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            mexErrMsgTxt(msg);
+        }else if (status_code == 1){
+            // Early return
+            return;
+        }
+        if (!mxIsCell(prhs[0]) || !mxIsCell(prhs[1])) {
+            mexErrMsgTxt("Values and diagonals must be given as cell arrays.");
+        }
+        const double * N = mxGetPr(prhs[2]);
+        int nc = mxGetScalar(prhs[3]);
+        bool rowMajor = mxGetScalar(prhs[4]);
+
+        int nf = mxGetM(prhs[2]);
+        int np = mxGetNumberOfElements(prhs[0]);
+        int nd = mxGetNumberOfElements(prhs[1]);
+        std::vector<AverageValue> values(np);
+        std::vector<AverageDiagonal> diagonals(nd);
+
+        plhs[0] = mxCreateCellMatrix(np, 1);
+        for (int p = 0; p < np; p++) {
+            const mxArray * value = mxGetCell(prhs[0], p);
+            if (value == NULL || !mxIsDouble(value) || mxIsSparse(value) || mxGetM(value) != static_cast<size_t>(nc)) {
+                mexErrMsgTxt("Values must be double matrices with one row per cell.");
+            }
+            int dim = mxGetN(value);
+            mxArray * result = mxCreateUninitNumericMatrix(nf, dim, mxDOUBLE_CLASS, mxREAL);
+            mxSetCell(plhs[0], p, result);
+            values[p].value = mxGetPr(value);
+            values[p].result = mxGetPr(result);
+            values[p].dim = dim;
+        }
+        mxArray * diagonal_result = mxCreateCellMatrix(nd, 1);
+        for (int q = 0; q < nd; q++) {
+            const mxArray * diagonal = mxGetCell(prhs[1], q);
+            if (diagonal == NULL || !mxIsDouble(diagonal) || mxIsSparse(diagonal) ||
+                (rowMajor ? mxGetN(diagonal) : mxGetM(diagonal)) != static_cast<size_t>(nc)) {
+                mexErrMsgTxt("Diagonals must be double matrices with one entry per cell.");
+            }
+            int m;
+            mxArray * result;
+            if (rowMajor) {
+                m = mxGetM(diagonal);
+                result = mxCreateUninitNumericMatrix(2 * m, nf, mxDOUBLE_CLASS, mxREAL);
+            } else {
+                m = mxGetN(diagonal);
+                result = mxCreateUninitNumericMatrix(nf, 2 * m, mxDOUBLE_CLASS, mxREAL);
+            }
+            mxSetCell(diagonal_result, q, result);
+            diagonals[q].diagonal = mxGetPr(diagonal);
+            diagonals[q].result = mxGetPr(result);
+            diagonals[q].m = m;
+        }
+        if (rowMajor) {
+            faceAverageBatch<true>(nf, nc, values, diagonals, N);
+        } else {
+            faceAverageBatch<false>(nf, nc, values, diagonals, N);
+        }
+        if (nlhs > 1) {
+            plhs[1] = diagonal_result;
+        } else {
+            mxDestroyArray(diagonal_result);
+        }
+        return;
+    }
+#endif
@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "mexOperatorPolicy.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -58,7 +59,8 @@ const char* dimensionCheck(const int nc, const int nrows, const int ncols, int &
 /* Templated function for main operation */
 template <bool rowMajor>
 void faceAverageJac(const int nf, const int nc, const int m, const double* diagonal, const double* N, double* result) {
-#pragma omp parallel for
+    const OperatorThreads threads(2L * nf * m);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
     for (int face = 0; face < nf; face++) {
         int left = N[face] - 1;
         int right = N[face + nf] - 1;
@@ -0,0 +1,108 @@
+#ifndef MRST_MEX_OPERATOR_POLICY_H
+#define MRST_MEX_OPERATOR_POLICY_H
+//
+// Runtime threading policy shared by the diagonal AD operators.
+//
+// The policy is read from the environment once, the first time a MEX file
+// runs a kernel, and kept for as long as that MEX file stays loaded.
+// setMexOperatorThreadPolicy sets the variables and clears the MEX files so
+// that the next call picks up the new values:
+//  - MRST_AD_MEX_THREADS   Upper bound on threads per call (0: OpenMP default)
+//  - MRST_AD_MEX_MIN_WORK  Work size (entries) below which kernels run serially
+//  - MRST_AD_MEX_SCHEDULE  Loop schedule, either "static" (default) or "guided"
+//
+// Kernels use it as
+//     const OperatorThreads threads(work);
+//     #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+//
+// The OpenMP run-sched-var is only changed for the lifetime of the
+// OperatorThreads object and restored afterwards, so the schedule of other
+// OpenMP code in the process is left alone.
+//
+#include <cstdlib>
+#include <cstring>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+// Also read by setMexOperatorThreadPolicy.m
+#define MRST_AD_MEX_DEFAULT_MIN_WORK 8192
+
+struct OperatorPolicy {
+    int max_threads;
+    long min_work;
+    bool guided;
+};
+
+inline OperatorPolicy readOperatorPolicy() {
+    OperatorPolicy policy;
+    policy.max_threads = 0;
+    policy.min_work = MRST_AD_MEX_DEFAULT_MIN_WORK;
+    policy.guided = false;
+
+    const char * threads = std::getenv("MRST_AD_MEX_THREADS");
+    if (threads != NULL && *threads != '\0') {
+        policy.max_threads = std::atoi(threads);
+    }
+    const char * min_work = std::getenv("MRST_AD_MEX_MIN_WORK");
+    if (min_work != NULL && *min_work != '\0') {
+        policy.min_work = std::atol(min_work);
+    }
+    const char * schedule = std::getenv("MRST_AD_MEX_SCHEDULE");
+    if (schedule != NULL) {
+        policy.guided = std::strcmp(schedule, "guided") == 0;
+    }
+    return policy;
+}
+
+inline const OperatorPolicy & getOperatorPolicy() {
+    static const OperatorPolicy policy = readOperatorPolicy();
+    return policy;
+}
+
+// Number of threads to use for a kernel touching roughly `work` entries,
+// with the policy schedule in effect for schedule(runtime) loops in scope.
+class OperatorThreads {
+public:
+    int count;
+
+    explicit OperatorThreads(const long work) : count(1) {
+#ifdef _OPENMP
+        const OperatorPolicy & policy = getOperatorPolicy();
+        scheduled = false;
+        if (work < policy.min_work) {
+            return;
+        }
+        count = omp_get_max_threads();
+        if (policy.max_threads > 0 && policy.max_threads < count) {
+            count = policy.max_threads;
+        }
+        if (count > 1) {
+            omp_get_schedule(&kind, &chunk);
+            omp_set_schedule(policy.guided ? omp_sched_guided : omp_sched_static, 0);
+            scheduled = true;
+        }
+#else
+        (void) work;
+#endif
+    }
+
+    ~OperatorThreads() {
+#ifdef _OPENMP
+        if (scheduled) {
+            omp_set_schedule(kind, chunk);
+        }
+#endif
+    }
+
+private:
+#ifdef _OPENMP
+    bool scheduled;
+    omp_sched_t kind;
+    int chunk;
+#endif
+    OperatorThreads(const OperatorThreads &);
+    OperatorThreads & operator=(const OperatorThreads &);
+};
+
+#endif // MRST_MEX_OPERATOR_POLICY_H
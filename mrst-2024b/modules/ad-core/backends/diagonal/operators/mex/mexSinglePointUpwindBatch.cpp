@@ -0,0 +1,318 @@
+//
+// include necessary system headers
+//
+#include <cmath>
+#include <vector>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+#include <iostream>
+#include "mexOperatorPolicy.h"
+#ifdef MRST_OCTEXT
+    #include <octave/oct.h>
+    #include <octave/dMatrix.h>
+    #include <octave/Cell.h>
+#else
+    #include <mex.h>
+#endif
+
+// INPUTS:
+//  - values{np}            Cell array of cell values<double> [nc x d_p]
+//  - diagonals{nd}         Cell array of cell diagonals<double> [nc x m_q] if column major or [m_q x nc] if row major
+//  - owner<double>         [nd x 1] One-based index of the value/flag each diagonal belongs to
+//  - N<double>             [nf x 2]
+//  - flags{np}             Cell array of upwind flags<bool> [nf x 1]
+//  - nc<double>            [scalar]
+//  - rowMajor<bool>        [scalar]
+// OUTPUT:
+//  - face_values{np}       Cell array of face values<double> [nf x d_p]
+//  - face_diagonals{nd}    Cell array of face diagonals<double> [nf x 2*m_q] if column major or [2*m_q x nf] if row major
+//
+// All quantities are upwinded in the same sweep over the faces, so N is
+// only streamed through once regardless of the number of phases.
+struct UpwindValue {
+    const double * value;
+    double * result;
+    int dim;
+};
+
+template <class logic_type>
+struct UpwindDiagonal {
+    const double * diagonal;
+    double * result;
+    const logic_type * flag;
+    int m;
+};
+
+const char* inputCheck(const int nin, const int nout, int & status_code){
+    if (nin == 0) {
+        if (nout > 0) {
+            status_code = -1;
+            return "Cannot give outputs with no inputs.";
+        }
+        // We are being called through compilation testing. Just do nothing.
+        // If the binary was actually called, we are good to go.
+        status_code = 1;
+        return "";
+    } else if (nin != 7) {
+        status_code = -2;
+        return "7 input arguments required: Values, diagonals, diagonal owners, N, flags, number of cells and rowMajor bool";
+    } else if (nout > 2) {
+        status_code = -3;
+        return "Too many outputs requested. Out: Face values and face diagonals";
+    } else {
+        // All ok.
+        status_code = 0;
+        return "";
+    }
+}
+
+template <bool rowMajor, class logic_type>
+void upwindBatch(const int nf, const int nc,
+                 const std::vector<UpwindValue> & values, const std::vector<const logic_type *> & flags,
+                 const std::vector<UpwindDiagonal<logic_type> > & diagonals, const double * N) {
+    const int np = values.size();
+    const int nd = diagonals.size();
+    long width = 0;
+    for (int p = 0; p < np; p++) {
+        width += values[p].dim;
+    }
+    for (int q = 0; q < nd; q++) {
+        width += 2 * diagonals[q].m;
+    }
+    const OperatorThreads threads(nf * width);
+    #pragma omp parallel for schedule(runtime) num_threads(threads.count)
+    for (int face = 0; face < nf; face++) {
+        const int left = N[face] - 1;
+        const int right = N[face + nf] - 1;
+        for (int p = 0; p < np; p++) {
+            const UpwindValue & v = values[p];
+            const int cell = flags[p][face] ? left : right;
+            for (int j = 0; j < v.dim; j++) {
+                v.result[face + nf * j] = v.value[cell + nc * j];
+            }
+        }
+        for (int q = 0; q < nd; q++) {
+            const UpwindDiagonal<logic_type> & d = diagonals[q];
+            const int m = d.m;
+            // We are working with uninitialized arrays so we need to set both zero and value.
+            if (rowMajor) {
+                int copy_offset, zero_offset, cell;
+                if (d.flag[face]) {
+                    copy_offset = 0;
+                    zero_offset = m;
+                    cell = left;
+                } else {
+                    copy_offset = m;
+                    zero_offset = 0;
+                    cell = right;
+                }
+                for (int der = 0; der < m; der++) {
+                    d.result[2 * m * face + copy_offset + der] = d.diagonal[m * cell + der];
+                    d.result[2 * m * face + zero_offset + der] = 0;
+                }
+            } else {
+                if (d.flag[face]) {
+                    for (int der = 0; der < m; der++) {
+                        d.result[der * nf + face] = d.diagonal[nc * der + left];
+                        d.result[der * nf + m * nf + face] = 0;
+                    }
+                } else {
+                    for (int der = 0; der < m; der++) {
+                        d.result[der * nf + m * nf + face] = d.diagonal[nc * der + right];
+                        d.result[der * nf + face] = 0;
+                    }
+                }
+            }
+        }
+    }
+}
+
+#ifdef MRST_OCTEXT
+    /* OCT gateway */
+    DEFUN_DLD (mexSinglePointUpwindBatch, args, nargout,
+               "Batched single point upwind operator for MRST - values and diagonal Jacobians.")
+    {
+        const int nrhs = args.length();
+        const int nlhs = nargout;
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            error(msg);
+        }else if (status_code == 1){
+            // Early return
+            return octave_value_list();
+        }
+        const Cell value_c = args(0).cell_value();
+        const Cell diagonal_c = args(1).cell_value();
+        const NDArray owner_nd = args(2).array_value();
+        const NDArray N_nd = args(3).array_value();
+        const Cell flag_c = args(4).cell_value();
+        int nc = args(5).scalar_value();
+        bool rowMajor = args(6).scalar_value();
+
+        const double * N = N_nd.data();
+        int nf = N_nd.rows();
+        int np = value_c.numel();
+        int nd = diagonal_c.numel();
+        if (flag_c.numel() != np) {
+            error("Number of flags must match the number of values.");
+        }
+        if (owner_nd.numel() != nd) {
+            error("Number of diagonal owners must match the number of diagonals.");
+        }
+        // Keep the arrays alive while we hold pointers into them
+        std::vector<NDArray> value_nd(np), flag_nd(np), value_out(np);
+        std::vector<NDArray> diagonal_nd(nd), diagonal_out(nd);
+        std::vector<UpwindValue> values(np);
+        std::vector<const double *> flags(np);
+        std::vector<UpwindDiagonal<double> > diagonals(nd);
+
+        Cell value_result(np, 1);
+        Cell diagonal_result(nd, 1);
+        for (int p = 0; p < np; p++) {
+            value_nd[p] = value_c(p).array_value();
+            if (value_nd[p].rows() != nc) {
+                error("Values must be double matrices with one row per cell.");
+            }
+            flag_nd[p] = flag_c(p).array_value();
+            if (flag_nd[p].numel() != nf) {
+                error("Flags must be logical vectors with one entry per face.");
+            }
+            int dim = value_nd[p].cols();
+            value_out[p] = NDArray(dim_vector(nf, dim));
+            values[p].value = value_nd[p].data();
+            values[p].result = value_out[p].fortran_vec();
+            values[p].dim = dim;
+            flags[p] = flag_nd[p].data();
+        }
+        for (int q = 0; q < nd; q++) {
+            int owner = owner_nd(q) - 1;
+            if (owner < 0 || owner >= np) {
+                error("Diagonal owner index out of range.");
+            }
+            diagonal_nd[q] = diagonal_c(q).array_value();
+            if ((rowMajor ? diagonal_nd[q].cols() : diagonal_nd[q].rows()) != nc) {
+                error("Diagonals must be double matrices with one entry per cell.");
+            }
+            int m = rowMajor ? diagonal_nd[q].rows() : diagonal_nd[q].cols();
+            if (rowMajor) {
+                diagonal_out[q] = NDArray(dim_vector(2 * m, nf));
+            } else {
+                diagonal_out[q] = NDArray(dim_vector(nf, 2 * m));
+            }
+            diagonals[q].diagonal = diagonal_nd[q].data();
+            diagonals[q].result = diagonal_out[q].fortran_vec();
+            diagonals[q].flag = flags[owner];
+            diagonals[q].m = m;
+        }
+        if (rowMajor) {
+            upwindBatch<true, double>(nf, nc, values, flags, diagonals, N);
+        } else {
+            upwindBatch<false, double>(nf, nc, values, flags, diagonals, N);
+        }
+        for (int p = 0; p < np; p++) {
+            value_result(p) = octave_value(value_out[p]);
+        }
+        for (int q = 0; q < nd; q++) {
+            diagonal_result(q) = octave_value(diagonal_out[q]);
+        }
+        octave_value_list retval;
+        retval(0) = octave_value(value_result);
+        retval(1) = octave_value(diagonal_result);
+        return retval;
+    }
+#else
+    /* MEX gateway */
+    void mexFunction( int nlhs, mxArray *plhs[],
+            int nrhs, const mxArray *prhs[] )
+
+    {
+        int status_code = 0;
+        auto msg = inputCheck(nrhs, nlhs, status_code);
+        if(status_code < 0){
+            // Some kind of error
+            mexErrMsgTxt(msg);
+        }else if (status_code == 1){
+            // Early return
+            return;
+        }
+        if (!mxIsCell(prhs[0]) || !mxIsCell(prhs[1]) || !mxIsCell(prhs[4])) {
+            mexErrMsgTxt("Values, diagonals and flags must be given as cell arrays.");
+        }
+        const double * owner = mxGetPr(prhs[2]);
+        const double * N = mxGetPr(prhs[3]);
+        int nc = mxGetScalar(prhs[5]);
+        bool rowMajor = mxGetScalar(prhs[6]);
+
+        int nf = mxGetM(prhs[3]);
+        int np = mxGetNumberOfElements(prhs[0]);
+        int nd = mxGetNumberOfElements(prhs[1]);
+        if (mxGetNumberOfElements(prhs[4]) != np) {
+            mexErrMsgTxt("Number of flags must match the number of values.");
+        }
+        if (mxGetNumberOfElements(prhs[2]) != nd) {
+            mexErrMsgTxt("Number of diagonal owners must match the number of diagonals.");
+        }
+        std::vector<UpwindValue> values(np);
+        std::vector<const mxLogical *> flags(np);
+        std::vector<UpwindDiagonal<mxLogical> > diagonals(nd);
+
+        plhs[0] = mxCreateCellMatrix(np, 1);
+        for (int p = 0; p < np; p++) {
+            const mxArray * value = mxGetCell(prhs[0], p);
+            const mxArray * flag = mxGetCell(prhs[4], p);
+            if (flag == NULL || !mxIsLogical(flag) || mxGetNumberOfElements(flag) != nf) {
+                mexErrMsgTxt("Flags must be logical vectors with one entry per face.");
+            }
+            if (value == NULL || !mxIsDouble(value) || mxIsSparse(value) || mxGetM(value) != static_cast<size_t>(nc)) {
+                mexErrMsgTxt("Values must be double matrices with one row per cell.");
+            }
+            int dim = mxGetN(value);
+            mxArray * result = mxCreateUninitNumericMatrix(nf, dim, mxDOUBLE_CLASS, mxREAL);
+            mxSetCell(plhs[0], p, result);
+            values[p].value = mxGetPr(value);
+            values[p].result = mxGetPr(result);
+            values[p].dim = dim;
+            flags[p] = mxGetLogicals(flag);
+        }
+        mxArray * diagonal_result = mxCreateCellMatrix(nd, 1);
+        for (int q = 0; q < nd; q++) {
+            const mxArray * diagonal = mxGetCell(prhs[1], q);
+            if (diagonal == NULL || !mxIsDouble(diagonal) || mxIsSparse(diagonal) ||
+                (rowMajor ? mxGetN(diagonal) : mxGetM(diagonal)) != static_cast<size_t>(nc)) {
+                mexErrMsgTxt("Diagonals must be double matrices with one entry per cell.");
+            }
+            int o = owner[q] - 1;
+            if (o < 0 || o >= np) {
+                mexErrMsgTxt("Diagonal owner index out of range.");
+            }
+            int m;
+            mxArray * result;
+            if (rowMajor) {
+                m = mxGetM(diagonal);
+                result = mxCreateUninitNumericMatrix(2 * m, nf, mxDOUBLE_CLASS, mxREAL);
+            } else {
+                m = mxGetN(diagonal);
+                result = mxCreateUninitNumericMatrix(nf, 2 * m, mxDOUBLE_CLASS, mxREAL);
+            }
+            mxSetCell(diagonal_result, q, result);
+            diagonals[q].diagonal = mxGetPr(diagonal);
+            diagonals[q].result = mxGetPr(result);
+            diagonals[q].flag = flags[o];
+            diagonals[q].m = m;
+        }
+        if (rowMajor) {
+            upwindBatch<true, mxLogical>(nf, nc, values, flags, diagonals, N);
+        } else {
+            upwindBatch<false, mxLogical>(nf, nc, values, flags, diagonals, N);
+        }
+        if (nlhs > 1) {
+            plhs[1] = diagonal_result;
+        } else {
+            mxDestroyArray(diagonal_result);
+        }
+        return;
+    }
+#endif
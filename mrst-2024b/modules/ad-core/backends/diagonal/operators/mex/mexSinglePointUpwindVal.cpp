@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "kernels/upwind.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -17,24 +18,6 @@
 // In: Cell value (nc x d), N (nf x 2), flag (nf x 1) bool
 // Out: Face value of (nf x d)
 
-template <class logic_type> 
-void upwind(const int nf, const int nc, const int dim, const double* value, const double* N, const logic_type * flag, double* result) {
-    #pragma omp parallel for
-    for(int i=0;i<nf;i++){
-        int fpos = i + nf;
-        if(flag[i]){
-            fpos = i;
-        }
-        else{
-            fpos = i + nf;
-        }
-        int cell_inx = N[fpos] - 1;
-        for(int j =0; j<dim; j++){
-            result[i+nf*j] = value[cell_inx + nc*j];
-        }
-    }
-}
-
 const char* inputCheck(const int nin, const int nout, int & status_code){
     if (nin == 0) {
         if (nout > 0) {
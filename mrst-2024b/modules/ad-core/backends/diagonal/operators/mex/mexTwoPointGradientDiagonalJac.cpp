@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "kernels/gradientJac.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -54,132 +55,6 @@ const char* dimensionCheck(const int nc, const int nrows, const int ncols, int &
 }
 
 
-/* Templated function for main operation */
-template <bool rowMajor>
-void gradientJac(const int nf, const int nc, const int m, const double * diagonal, const double * N, double * result){
-    #pragma omp parallel for
-    for (int i = 0; i < nf; i++) {
-        int left = N[i] - 1;
-        int right = N[i + nf] - 1;
-        for (int j = 0; j < m; j++) {
-            if (rowMajor) {
-                result[i * 2 * m + j] = -diagonal[m * left + j];
-                result[i * 2 * m + j + m] = diagonal[m * right + j];
-
-            } else {
-                result[j * nf + i]      = -diagonal[nc * j + left];
-                result[j * nf + i + m*nf] =  diagonal[nc * j + right];
-            }
-        }
-    }
-    return;
-}
-
-template <int m, bool rowMajor>
-void gradientJac(const int nf, const int nc, const double* diagonal, const double* N, double* result) {
-    gradientJac<rowMajor>(nf, nc, m, diagonal, N, result);
-}
-
-template <bool rowMajor>
-void gradientJacMain(const int m, const int nf, const int nc, const double * diagonal, const double * N, double * result){
-    switch (m) {
-        case 1:
-            gradientJac<1, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 2:
-            gradientJac<2, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 3:
-            gradientJac<3, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 4:
-            gradientJac<4, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 5:
-            gradientJac<5, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 6:
-            gradientJac<6, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 7:
-            gradientJac<7, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 8:
-            gradientJac<8, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 9:
-            gradientJac<9, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 10:
-            gradientJac<10, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 11:
-            gradientJac<11, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 12:
-            gradientJac<12, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 13:
-            gradientJac<13, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 14:
-            gradientJac<14, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 15:
-            gradientJac<15, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 16:
-            gradientJac<16, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 17:
-            gradientJac<17, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 18:
-            gradientJac<18, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 19:
-            gradientJac<19, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 20:
-            gradientJac<20, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 21:
-            gradientJac<21, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 22:
-            gradientJac<22, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 23:
-            gradientJac<23, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 24:
-            gradientJac<24, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 25:
-            gradientJac<25, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 26:
-            gradientJac<26, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 27:
-            gradientJac<27, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 28:
-            gradientJac<28, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 29:
-            gradientJac<29, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        case 30:
-            gradientJac<30, rowMajor>(nf, nc, diagonal, N, result);
-            break;
-        default:
-            gradientJac<rowMajor>(nf, nc, m, diagonal, N, result);
-    }
-}
-
-
-
 #ifdef MRST_OCTEXT
     /* OCT gateway */
     DEFUN_DLD (mexTwoPointGradientDiagonalJac, args, nargout,
@@ -7,6 +7,7 @@
     #include <omp.h>
 #endif
 #include <iostream>
+#include "mexOperatorPolicy.h"
 #ifdef MRST_OCTEXT
     #include <octave/oct.h>
     #include <octave/dMatrix.h>
@@ -15,7 +16,8 @@
 #endif
 
 void faceGradient(const int nf, const int nc, const int dim, const double* value, const double* N, double* result) {
-     #pragma omp parallel for
+     const OperatorThreads threads((long)nf * dim);
+     #pragma omp parallel for schedule(runtime) num_threads(threads.count)
      for(int i=0;i<nf;i++){
          int left = N[i] - 1;
          int right = N[i + nf] - 1;
@@ -0,0 +1,110 @@
+function policy = setMexOperatorThreadPolicy(varargin)
+%Set threading policy for the diagonal AD MEX operators
+%
+% SYNOPSIS:
+%   setMexOperatorThreadPolicy('threads', 4, 'minWork', 2e4, 'schedule', 'guided')
+%   policy = setMexOperatorThreadPolicy()
+%
+% DESCRIPTION:
+%   All MEX operators in this folder read their OpenMP policy from
+%   environment variables the first time they run (see mexOperatorPolicy.h).
+%   This function sets those variables and clears the operator MEX files
+%   from memory, so the new policy takes effect on the next call without
+%   rebuilding anything. Useful to avoid oversubscription when several
+%   MATLAB workers share a node, and to keep small problems serial.
+%
+% OPTIONAL PARAMETERS:
+%   threads  - Maximum number of threads per call. Zero means that the
+%              OpenMP default (e.g. OMP_NUM_THREADS) is used.
+%   minWork  - Number of entries a kernel must touch before it runs in
+%              parallel. Smaller problems are computed serially.
+%   schedule - Loop schedule, either 'static' or 'guided'.
+%   reset    - Restore defaults before applying other options.
+%
+% RETURNS:
+%   policy   - Struct with the current policy.
+%
+% SEE ALSO:
+%   buildMexOperators
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    opt = struct('threads', [], 'minWork', [], 'schedule', [], 'reset', false);
+    opt = merge_options(opt, varargin{:});
+    if opt.reset
+        setenv('MRST_AD_MEX_THREADS', '');
+        setenv('MRST_AD_MEX_MIN_WORK', '');
+        setenv('MRST_AD_MEX_SCHEDULE', '');
+    end
+    if ~isempty(opt.threads)
+        assert(opt.threads >= 0, 'Thread count must be non-negative.');
+        setenv('MRST_AD_MEX_THREADS', sprintf('%d', round(opt.threads)));
+    end
+    if ~isempty(opt.minWork)
+        assert(opt.minWork >= 0, 'Minimum work must be non-negative.');
+        setenv('MRST_AD_MEX_MIN_WORK', sprintf('%d', round(opt.minWork)));
+    end
+    if ~isempty(opt.schedule)
+        schedule = lower(opt.schedule);
+        assert(any(strcmp(schedule, {'static', 'guided'})), ...
+            'Schedule must be either ''static'' or ''guided''.');
+        setenv('MRST_AD_MEX_SCHEDULE', schedule);
+    end
+    changed = opt.reset || ~isempty(opt.threads) || ...
+              ~isempty(opt.minWork) || ~isempty(opt.schedule);
+    if changed
+        % The policy is cached in each loaded MEX file
+        clearOperatorMex();
+    end
+    policy = struct('threads',  readNumber('MRST_AD_MEX_THREADS', 0), ...
+                    'minWork',  readNumber('MRST_AD_MEX_MIN_WORK', defaultMinWork()), ...
+                    'schedule', getenv('MRST_AD_MEX_SCHEDULE'));
+    if isempty(policy.schedule)
+        policy.schedule = 'static';
+    end
+end
+
+function v = readNumber(name, default)
+    v = str2double(getenv(name));
+    if isnan(v)
+        v = default;
+    end
+end
+
+function clearOperatorMex()
+    d = dir(fullfile(fileparts(mfilename('fullpath')), 'mex*.cpp'));
+    for i = 1:numel(d)
+        [~, name] = fileparts(d(i).name);
+        clear(name);
+    end
+end
+
+function n = defaultMinWork()
+    % Single source for the default: the definition in mexOperatorPolicy.h
+    persistent v
+    if isempty(v)
+        hdr = fileread(fullfile(fileparts(mfilename('fullpath')), ...
+                                'mexOperatorPolicy.h'));
+        tok = regexp(hdr, 'define\s+MRST_AD_MEX_DEFAULT_MIN_WORK\s+(\d+)', ...
+                     'tokens', 'once');
+        v = str2double(tok{1});
+    end
+    n = v;
+end
@@ -77,6 +77,18 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
     f_sparse = @(varargin) fn(cell_value_sparse, 2*cell_value_sparse, 3*cell_value_sparse);
     [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, 'cellmult', 'Multiply and add (cell)', opt, results);
 
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    %   Test fused product sum    %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    f_prod = @(useMex) productSum(cell_value, 2*cell_value, 3*cell_value, useMex);
+    [f_mex, f_matlab] = genFunctions(f_prod);
+    f_sparse = @(varargin) cell_value_sparse.*(2*cell_value_sparse).*(3*cell_value_sparse);
+    [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, 'productsum', 'Triple product (cell)', opt, results);
+
+    f_multi = @(useMex) multiTimes(cell_value, 2*cell_value, 3*cell_value);
+    [f_mex, f_matlab] = genFunctions(f_multi);
+    [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, 'multitimes', 'Triple product, multiTimes (cell)', opt, results);
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     %       Test diagonal subsets %
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -109,6 +121,24 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
     [f_mex, f_matlab] = genFunctions(upw);
     [face_value, face_value_mex, face_value_sparse, results] = testFunction(f_mex, f_matlab, f_sparse, 'upwind', 'Single-point upwind', opt, results);
 
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    %  Test batched face operators%
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    batch_flags = {flag, ~flag};
+    for k = 1:2
+        upw_batch = @(useMex) takeOutput(singlePointUpwindBatch(batch_flags, N, opt.nc, {cell_value, 2*cell_value}, useMex), k);
+        f_sparse = @(varargin) ops_sparse.faceUpstr(batch_flags{k}, k*cell_value_sparse);
+        [f_mex, f_matlab] = genFunctions(upw_batch);
+        [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, sprintf('upwind_batch%d', k), ...
+                                          sprintf('Single-point upwind (batched, output %d)', k), opt, results);
+
+        avg_batch = @(useMex) takeOutput(faceAverageBatch(N, opt.nc, {cell_value, 2*cell_value}, useMex), k);
+        f_sparse = @(varargin) ops_sparse.faceAvg(k*cell_value_sparse);
+        [f_mex, f_matlab] = genFunctions(avg_batch);
+        [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, sprintf('faceavg_batch%d', k), ...
+                                          sprintf('Face average (batched, output %d)', k), opt, results);
+    end
+
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
     %      Test gradient          %
     %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -188,6 +218,18 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
     f_mex = @() V_mex.sparse();
     f_matlab = @() V_matlab.sparse();
     [~, ~, ~, results] = testFunction(f_mex, f_matlab, f_sparse, 'sparse', 'Class -> Sparse', opt, results);
+
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    %    Test Morton ordering    %
+    %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+    if opt.testMex && isfield(G.cells, 'centroids')
+        o_mex = getDiagonalOperatorOrdering(G, 'type', 'morton', 'useMex', true);
+        o_matlab = getDiagonalOperatorOrdering(G, 'type', 'morton', 'useMex', false);
+        assert(isequal(o_mex.cells, o_matlab.cells) && ...
+               isequal(o_mex.faces, o_matlab.faces), ...
+               'MEX and MATLAB Morton orderings differ.');
+        dispif(opt.print, 'Morton ordering: MEX and MATLAB orderings are identical\n');
+    end
     dispif(opt.print, '**********************************************************************\n');
 end
 
@@ -263,6 +305,31 @@ function [out, t] = perform_benchmark(fn, opt)
     end
 end
 
+function out = productSum(x, y, z, useMex)
+    % Product x.*y.*z with Jacobian evaluated as a single sum of diagonal
+    % products: d(xyz) = yz dx + xz dy + xy dz
+    vx = value(x);
+    vy = value(y);
+    vz = value(z);
+    out = x;
+    out.val = vx.*vy.*vz;
+    for i = 1:numel(x.jac)
+        J = {x.jac{i}, y.jac{i}, z.jac{i}};
+        for j = 1:numel(J)
+            if useMex && ~J{j}.rowMajor
+                J{j}.diagonal = J{j}.diagonal';
+                J{j}.rowMajor = true;
+            end
+            J{j}.useMex = useMex;
+        end
+        out.jac{i} = diagProductSum({vy.*vz, vx.*vz, vx.*vy}, J{:});
+    end
+end
+
+function v = takeOutput(v, k)
+    v = v{k};
+end
+
 function [f_mex, f_matlab] = genFunctions(fn)
     f_mex = @() fn(true);
     f_matlab = @() fn(false);
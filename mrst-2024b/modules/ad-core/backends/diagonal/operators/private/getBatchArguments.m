@@ -0,0 +1,40 @@
+function [vals, diagonals, owner, jacPos] = getBatchArguments(v, ix)
+%Gather values and nonzero diagonals for the batched face MEX kernels
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    nb = numel(ix);
+    vals = cell(nb, 1);
+    [diagonals, jacPos] = deal({});
+    owner = [];
+    for k = 1:nb
+        vi = v{ix(k)};
+        vals{k} = value(vi);
+        if isa(vi, 'GenericAD')
+            for j = 1:numel(vi.jac)
+                if ~vi.jac{j}.isZero
+                    diagonals{end+1, 1} = vi.jac{j}.diagonal; %#ok
+                    jacPos{end+1, 1} = [ix(k), j]; %#ok
+                    owner(end+1, 1) = k; %#ok
+                end
+            end
+        end
+    end
+end
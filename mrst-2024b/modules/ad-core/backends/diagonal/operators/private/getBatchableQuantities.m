@@ -0,0 +1,53 @@
+function [batch, rowMajor] = getBatchableQuantities(v)
+%Find quantities that can be treated by the batched face MEX kernels
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    % Quantities with only diagonal (or zero) Jacobians of a common memory
+    % layout can be treated in the batched kernel.
+    np = numel(v);
+    batch = false(1, np);
+    rowMajor = [];
+    for i = 1:np
+        vi = v{i};
+        if isnumeric(vi)
+            batch(i) = true;
+            continue
+        elseif ~isa(vi, 'GenericAD')
+            continue
+        end
+        ok = true;
+        for j = 1:numel(vi.jac)
+            jac = vi.jac{j};
+            if ~strcmp(class(jac), 'DiagonalJacobian')
+                ok = false;
+            elseif ~jac.isZero
+                if isempty(rowMajor)
+                    rowMajor = jac.rowMajor;
+                end
+                ok = ok && jac.rowMajor == rowMajor;
+            end
+        end
+        batch(i) = ok;
+    end
+    if isempty(rowMajor)
+        rowMajor = false;
+    end
+end
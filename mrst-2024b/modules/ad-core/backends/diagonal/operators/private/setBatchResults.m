@@ -0,0 +1,43 @@
+function v = setBatchResults(v, ix, N, faceVals, faceDiagonals, jacPos, useMex, rowMajor)
+%Store face values and diagonals from the batched face MEX kernels
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    nf = size(N, 1);
+    for k = 1:numel(ix)
+        i = ix(k);
+        if isa(v{i}, 'GenericAD')
+            v{i}.val = faceVals{k};
+            for j = 1:numel(v{i}.jac)
+                if v{i}.jac{j}.isZero
+                    v{i}.jac{j} = v{i}.jac{j}.toZero(nf);
+                end
+            end
+        else
+            v{i} = faceVals{k};
+        end
+    end
+    for q = 1:numel(faceDiagonals)
+        i = jacPos{q}(1);
+        j = jacPos{q}(2);
+        jac = v{i}.jac{j};
+        v{i}.jac{j} = FixedWidthJacobian(faceDiagonals{q}, jac.dim, N, [], jac.subset, useMex, rowMajor, 'interiorfaces');
+    end
+end
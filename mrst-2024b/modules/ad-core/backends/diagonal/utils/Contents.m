@@ -3,6 +3,7 @@
 % Files
 %   diagMult                         - Internal function for diagonal multiplication in AD code
 %   diagProductMult                  - Undocumented Utility Function
+%   diagProductSum                   - Internal function for sums of diagonal products in AD code
 %   double2GenericAD                 - Convert a double to GenericAD variable, using a sample GenericAD variable for dimensions
 %   getSparseArguments               - Get sparse matrix indices
 %   getSparseBlocks                  - Get sparse blocks
@@ -11,6 +12,7 @@
 %   initVariablesAD_diagonalRowMajor - Diagonal AD initializer
 %   initVariablesAD_oneBlock         - Initialize a set of automatic differentiation variables (single block)
 %   matrixDims                       - Overloadable version of size
+%   permuteGridCells                 - Renumber the cells and faces of a grid according to a given ordering
 
 %{
 Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
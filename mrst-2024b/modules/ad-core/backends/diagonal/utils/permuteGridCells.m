@@ -0,0 +1,110 @@
+function G = permuteGridCells(G, ordering)
+%Renumber the cells and faces of a grid according to a given ordering
+%
+% SYNOPSIS:
+%   G = permuteGridCells(G, ordering)
+%
+% DESCRIPTION:
+%   Apply a cell and face ordering (typically from
+%   getDiagonalOperatorOrdering) to a grid. Nodes are left unchanged.
+%   Internal faces are placed first in the order given by ordering.faces,
+%   followed by the boundary faces sorted by their renumbered cell. All
+%   cell and face fields with one row per cell/face (geometry, indexMap,
+%   cpnodes, tags) are permuted along with the topology, so the grid can
+%   be used for model setup as usual. Cell-wise input such as rock and
+%   initial state must be permuted with ordering.cells, and results can be
+%   mapped back to the original numbering with ordering.cellsInv.
+%
+% PARAMETERS:
+%   G        - Grid structure. Non-neighbouring connections (G.nnc) are
+%              not supported.
+%   ordering - Struct with fields 'cells' and 'faces' as returned by
+%              getDiagonalOperatorOrdering for the same grid.
+%
+% RETURNS:
+%   G        - Renumbered grid.
+%
+% EXAMPLE:
+%   ordering = getDiagonalOperatorOrdering(G, 'type', 'rcm');
+%   G        = permuteGridCells(G, ordering);
+%   rock     = makeRock(G, rock.perm(ordering.cells, :), ...
+%                          rock.poro(ordering.cells));
+%   % ... simulate ...
+%   p        = states{end}.pressure(ordering.cellsInv);
+%
+% SEE ALSO:
+%   getDiagonalOperatorOrdering
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    assert(numel(G) == 1, 'Cannot permute more than one grid at a time.');
+    assert(~isfield(G, 'nnc') || isempty(G.nnc), ...
+        'Grids with non-neighbouring connections are not supported.');
+    nc = G.cells.num;
+    nf = G.faces.num;
+    cells = reshape(ordering.cells, [], 1);
+    assert(numel(cells) == nc, 'Ordering does not match number of cells.');
+    cellsInv = zeros(nc + 1, 1);
+    cellsInv(cells + 1) = 1:nc;
+
+    % Full face ordering: internal faces as given, then boundary faces
+    internal = find(all(G.faces.neighbors > 0, 2));
+    assert(numel(ordering.faces) == numel(internal), ...
+        'Ordering does not match number of internal faces.');
+    boundary = find(~all(G.faces.neighbors > 0, 2));
+    bcell = cellsInv(sum(G.faces.neighbors(boundary, :), 2) + 1);
+    [~, bix] = sort(bcell);
+    faces = [internal(ordering.faces); boundary(bix)];
+    facesInv = zeros(nf, 1);
+    facesInv(faces) = 1:nf;
+
+    ix = @(p, i) mcolon(double(p(i)), double(p(i+1)) - 1);
+    pos = @(n) cumsum([1; double(reshape(n, [], 1))]);
+
+    % Cell topology
+    numFaces = diff(G.cells.facePos);
+    cellFaces = G.cells.faces(ix(G.cells.facePos, cells), :);
+    cellFaces(:, 1) = facesInv(cellFaces(:, 1));
+    G.cells.facePos = pos(numFaces(cells));
+    G.cells.faces = cellFaces;
+
+    % Face topology
+    numNodes = diff(G.faces.nodePos);
+    G.faces.nodes = G.faces.nodes(ix(G.faces.nodePos, faces));
+    G.faces.nodePos = pos(numNodes(faces));
+    G.faces.neighbors = reshape(cellsInv(G.faces.neighbors(faces, :) + 1), [], 2);
+
+    % Remaining entity-wise fields (geometry, indexMap, cpnodes, tags, ...)
+    G.cells = permuteFields(G.cells, cells, {'num', 'facePos', 'faces'});
+    G.faces = permuteFields(G.faces, faces, {'num', 'nodePos', 'nodes', 'neighbors'});
+
+    G.type = [G.type, { mfilename }];
+end
+
+function s = permuteFields(s, order, skip)
+    n = numel(order);
+    flds = setdiff(fieldnames(s), skip);
+    for i = 1:numel(flds)
+        f = flds{i};
+        if size(s.(f), 1) == n
+            s.(f) = s.(f)(order, :);
+        end
+    end
+end
@@ -25,6 +25,10 @@ function [state0, model, schedule, nonlinear] = initEclipseProblemAD(deck, varar
 %   getInitialState    - Create initial state from deck (EQUIL or direct
 %                        assignment of initial conditions)
 %   splitDisconnected  - Passed onto processGRDECL.
+%   cacheGrid          - Read grid and geometry from a binary cache keyed
+%                        by the corner-point input if possible, storing
+%                        them on first use.  See cachedEclipseGrid.
+%                        Default: false.
 %   useLegacyModels    - Whether or not to construct the original,
 %                        monolithic physical models.  Stop-gap solution
 %                        until all examples have been ported to the
@@ -96,6 +100,7 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
                  'getInitialState',      true,  ...
                  'SplitDisconnected',    false, ...
                  'PreserveCpNodes',      true,  ...
+                 'cacheGrid',            false, ...
                  'useLegacyModels',      false);
     [opt, extra] = merge_options(opt, varargin{:});
     if ~isempty(opt.deckfn)
@@ -184,10 +189,16 @@ function model = initializeModel(deck, opt)
         perm_ok = any(rock.perm > opt.permTolerance, 2);
         deck.GRID.ACTNUM = double(deck.GRID.ACTNUM > 0 & pv > 0 & perm_ok);
 
-        G = initEclipseGrid(deck, 'SplitDisconnected', opt.SplitDisconnected, ...
-                                  'useMex', opt.useMexProcessGrid, ...
-                                  'PreserveCpNodes', ...
-                                  ~opt.useMexProcessGrid && opt.PreserveCpNodes);
+        gopt = {'SplitDisconnected', opt.SplitDisconnected, ...
+                'useMex', opt.useMexProcessGrid, ...
+                'PreserveCpNodes', ...
+                ~opt.useMexProcessGrid && opt.PreserveCpNodes};
+        if opt.cacheGrid
+            G = cachedEclipseGrid(deck, 'useMexGeometry', opt.useMexGeometry, ...
+                                  gopt{:});
+        else
+            G = initEclipseGrid(deck, gopt{:});
+        end
         if numel(G) > 1
             warning('Multiple disconnected grids found. Picking largest.');
             G = G(1);
@@ -46,7 +46,7 @@ classdef GenericComponent < StateFunctionDependent
             % Iterate over phases and weight by pore-volume and saturation
             for i = 1:numel(mass)
                 if ~isempty(mass{i})
-                    mass{i} = s{i}.*pv.*mass{i};
+                    mass{i} = multiTimes(s{i}, pv, mass{i});
                 end
             end
         end
@@ -52,6 +52,7 @@
 %   interpolateIDW                        - Undocumented Utility Function
 %   makeScheduleConsistent                - Ensure that a schedule is consistent in terms of well counts/perforations
 %   mergeOrderedArrays                    - Merge two sets of cells that are similar in that they may contain
+%   multiTimes                            - Element-wise product of several factors
 %   numelData                             - Alias for numel. Useful for writing code which handles either
 %   numelValue                            - Undocumented Utility Function
 %   padRatesAndCompi                      - Pad one/two/threephase values with zeros corresponding to missing phases.
@@ -0,0 +1,38 @@
+function h = multiTimes(varargin)
+%Element-wise product of several factors
+%
+% SYNOPSIS:
+%   h = multiTimes(a, b, c, ...)
+%
+% DESCRIPTION:
+%   Equivalent to a.*b.*c.*...  The GenericAD class overloads this function
+%   to form the Jacobian of the product in a single pass over the diagonal
+%   Jacobians rather than one pass per pairwise product.
+%
+% SEE ALSO:
+%   `GenericAD`, `diagProductSum`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+    h = varargin{1};
+    for i = 2:numel(varargin)
+        h = h.*varargin{i};
+    end
+end
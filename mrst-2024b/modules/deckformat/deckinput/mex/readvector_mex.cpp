@@ -0,0 +1,367 @@
+/*
+  Input vector of floating point numbers from ECLIPSE input file.
+
+  SYNOPSIS:
+    [v, pos] = readvector_mex(fname, pos, nel)
+
+  Parses the keyword vector that starts at byte offset 'pos' in the file
+  'fname' (typically FOPEN(fid) and FTELL(fid)) up to the terminating '/'
+  or end of file.  Repeat counts of the form N*value are expanded, comment
+  lines and trailing comments introduced by '--' are skipped, and
+  Fortran-style exponents (1.2D+3) are accepted.  'nel' is the expected
+  number of elements (INF if unknown); more or fewer values are returned
+  as found, as in readVector_textscan.
+
+  Returns the values as a column vector and the byte offset of the
+  terminating '/' (or of the end of file).
+
+  The file is memory mapped, and large vectors are split on line
+  boundaries and parsed concurrently when built with OpenMP.  Do not
+  build with -ffast-math; the number parser relies on IEEE arithmetic.
+*/
+
+/*
+  Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+  This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+  MRST is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  MRST is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <mex.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "mappedfile.h"
+
+namespace {
+
+
+
+    inline bool is_space(char c)
+    {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+    }
+
+    inline bool is_digit(char c)
+    {
+        return (c >= '0') && (c <= '9');
+    }
+
+    inline bool is_comment(const char *p, const char *e)
+    {
+        return (p + 1 < e) && (p[0] == '-') && (p[1] == '-');
+    }
+
+    inline const char *skip_line(const char *p, const char *e)
+    {
+        const void *nl = std::memchr(p, '\n', e - p);
+        return (nl != 0) ? static_cast<const char *>(nl) + 1 : e;
+    }
+
+    // Position of the vector terminator, or e if there is none.
+    const char *find_terminator(const char *p, const char *e)
+    {
+        while (p < e) {
+            if (is_space(*p))       { ++p; }
+            else if (*p == '/')     { return p; }
+            else if (is_comment(p, e)) { p = skip_line(p, e); }
+            else {
+                while ((p < e) && ! is_space(*p) && (*p != '/')) { ++p; }
+            }
+        }
+        return e;
+    }
+
+
+    // Exact powers of ten representable as doubles.
+    const double pow10[] = {
+        1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 ,
+        1e8 , 1e9 , 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+
+    // Fallback for the cases the fast path cannot round correctly, and
+    // for NaN/Inf.  The token is copied since it is not terminated.
+    bool parse_slow(const char *b, const char *e, double &x)
+    {
+        char buf[128];
+        const std::size_t n = static_cast<std::size_t>(e - b);
+
+        if (n + 1 > sizeof buf) { return false; }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            buf[i] = ((b[i] == 'd') || (b[i] == 'D')) ? 'e' : b[i];
+        }
+        buf[n] = '\0';
+
+        char *end;
+        x = std::strtod(buf, &end);
+
+        return end == buf + n;
+    }
+
+
+    // Parse [b, e) as a floating point number.  Decimal mantissas of at
+    // most 19 digits with a value below 2^53 are exact in double
+    // precision, and so are the powers 10^0 ... 10^22, so one
+    // multiplication or division gives the correctly rounded result
+    // (Clinger's fast path).  Other inputs go through strtod().
+    bool parse_double(const char *b, const char *e, double &x)
+    {
+        const char *p   = b;
+        bool        neg = false;
+
+        if ((p < e) && ((*p == '+') || (*p == '-'))) {
+            neg = *p == '-';
+            ++p;
+        }
+
+        unsigned long long m = 0;
+        int  ndig = 0, nsig = 0, e10 = 0;
+        bool overflow = false;
+
+        for (; (p < e) && is_digit(*p); ++p, ++ndig) {
+            if (nsig < 19) {
+                m = 10*m + (*p - '0');
+                nsig += (m != 0);
+            }
+            else {
+                overflow = true; ++e10;
+            }
+        }
+        if ((p < e) && (*p == '.')) {
+            for (++p; (p < e) && is_digit(*p); ++p, ++ndig) {
+                if (nsig < 19) {
+                    m = 10*m + (*p - '0');
+                    nsig += (m != 0);
+                    --e10;
+                }
+                else {
+                    overflow = true;
+                }
+            }
+        }
+        if (ndig == 0) {
+            return parse_slow(b, e, x);   // NaN, Inf or garbage
+        }
+
+        if ((p < e) && ((*p == 'e') || (*p == 'E') ||
+                        (*p == 'd') || (*p == 'D')))
+        {
+            const char *q    = p + 1;
+            bool        eneg = false;
+            int         ev   = 0;
+
+            if ((q < e) && ((*q == '+') || (*q == '-'))) {
+                eneg = *q == '-';
+                ++q;
+            }
+            if ((q == e) || ! is_digit(*q)) { return false; }
+
+            for (; (q < e) && is_digit(*q); ++q) {
+                if (ev < 100000) { ev = 10*ev + (*q - '0'); }
+            }
+            e10 += eneg ? -ev : ev;
+            p    = q;
+        }
+
+        if (p != e) { return false; }
+
+        if (overflow || (m > (1ULL << 53)) || (e10 < -22) || (e10 > 22)) {
+            return parse_slow(b, e, x);
+        }
+
+        x = static_cast<double>(m);
+        x = (e10 < 0) ? x / pow10[-e10] : x * pow10[e10];
+        if (neg) { x = -x; }
+
+        return true;
+    }
+
+
+    // Values of [p, e), which holds complete lines of the vector.  On a
+    // malformed element, 'bad' is set to its start.
+    void parse_range(const char *p, const char *e,
+                     std::vector<double> &v, const char *&bad)
+    {
+        bad = 0;
+
+        while (p < e) {
+            if (is_space(*p))          { ++p; continue; }
+            if (is_comment(p, e))      { p = skip_line(p, e); continue; }
+
+            const char *b = p;
+            while ((p < e) && ! is_space(*p) && (*p != '/')) { ++p; }
+
+            // Optional repeat count 'N*'
+            const char *star = b;
+            while ((star < p) && is_digit(*star)) { ++star; }
+
+            double      x;
+            std::size_t n = 1;
+            const char *vb = b;
+
+            if ((star > b) && (star < p) && (*star == '*')) {
+                n  = std::strtoul(b, 0, 10);
+                vb = star + 1;
+            }
+
+            if ((vb == p) || ! parse_double(vb, p, x)) {
+                bad = b;
+                return;
+            }
+
+            v.insert(v.end(), n, x);
+        }
+    }
+
+
+    // Split [b, e) into about 'nchunk' pieces that end at line breaks.
+    std::vector<const char *>
+    split_lines(const char *b, const char *e, int nchunk)
+    {
+        std::vector<const char *> cut(1, b);
+        const std::size_t len = e - b;
+
+        for (int c = 1; c < nchunk; ++c) {
+            const char *p = b + (len * c) / nchunk;
+            if (p < cut.back()) { p = cut.back(); }
+            p = skip_line(p, e);
+            if (p < e) { cut.push_back(p); }
+        }
+        cut.push_back(e);
+
+        return cut;
+    }
+
+
+    std::string get_string(const mxArray *a)
+    {
+        char *s = mxArrayToString(a);
+        std::string r(s != 0 ? s : "");
+        mxFree(s);
+        return r;
+    }
+
+
+    // Read the vector at 'pos' of 'fname' into plhs.  Returns false with
+    // a message in 'msg' on failure.
+    bool read_vector(const std::string &fname, double pos, double nel,
+                     int nlhs, mxArray *plhs[], char *msg)
+    {
+        MappedFile file(fname.c_str(), true);
+
+        if (! file.is_open()) {
+            std::sprintf(msg, "Unable to open file '%.400s'", fname.c_str());
+            return false;
+        }
+        if (! (pos >= 0) || (pos > static_cast<double>(file.size()))) {
+            std::sprintf(msg, "Position %g outside file '%.400s'",
+                         pos, fname.c_str());
+            return false;
+        }
+
+        const char *begin = file.data();
+        const char *b     = begin + static_cast<std::size_t>(pos);
+        const char *e     = find_terminator(b, begin + file.size());
+
+        // About 1MB of text per chunk, a few chunks per thread.
+        int nchunk = 1;
+#if defined(_OPENMP)
+        nchunk = static_cast<int>((e - b) >> 20);
+        if (nchunk > 4 * omp_get_max_threads()) {
+            nchunk = 4 * omp_get_max_threads();
+        }
+        if (nchunk < 1) { nchunk = 1; }
+#endif
+
+        const std::vector<const char *> cut = split_lines(b, e, nchunk);
+        nchunk = static_cast<int>(cut.size()) - 1;
+
+        std::vector< std::vector<double> > part(nchunk);
+        std::vector<const char *>          bad (nchunk, static_cast<const char *>(0));
+
+        if ((nchunk == 1) && (nel > 0) && (nel < 1.0e12)) {   // nel may be Inf
+            part[0].reserve(static_cast<std::size_t>(nel));
+        }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int c = 0; c < nchunk; ++c) {
+            parse_range(cut[c], cut[c + 1], part[c], bad[c]);
+        }
+
+        std::size_t n = 0;
+        for (int c = 0; c < nchunk; ++c) {
+            if (bad[c] != 0) {
+                const char *t = bad[c];
+                while ((t < e) && ! is_space(*t) && (t - bad[c] < 40)) { ++t; }
+
+                std::sprintf(msg, "Invalid vector element '%.*s' "
+                             "('%.300s': %lu)",
+                             static_cast<int>(t - bad[c]), bad[c],
+                             fname.c_str(),
+                             static_cast<unsigned long>(bad[c] - begin));
+                return false;
+            }
+            n += part[c].size();
+        }
+
+        plhs[0] = mxCreateDoubleMatrix(n, 1, mxREAL);
+        double *v = mxGetPr(plhs[0]);
+        for (int c = 0; c < nchunk; ++c) {
+            if (! part[c].empty()) {
+                std::memcpy(v, &part[c][0], part[c].size() * sizeof *v);
+                v += part[c].size();
+            }
+        }
+
+        if (nlhs > 1) {
+            plhs[1] = mxCreateDoubleScalar(static_cast<double>(e - begin));
+        }
+
+        return true;
+    }
+}
+
+
+void
+mexFunction(int nlhs,       mxArray *plhs[],
+            int nrhs, const mxArray *prhs[])
+{
+    static char msg[512];
+
+    if ((nrhs != 3) || (nlhs > 2) || ! mxIsChar(prhs[0]) ||
+        ! mxIsDouble(prhs[1]) || ! mxIsDouble(prhs[2]))
+    {
+        mexErrMsgTxt("Syntax is [v, pos] = readvector_mex(fname, pos, nel)");
+    }
+
+    if (! read_vector(get_string(prhs[0]), mxGetScalar(prhs[1]),
+                      mxGetScalar(prhs[2]), nlhs, plhs, msg))
+    {
+        mexErrMsgTxt(msg);
+    }
+}
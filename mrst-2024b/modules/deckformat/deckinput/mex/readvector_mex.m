@@ -0,0 +1,74 @@
+function varargout = readvector_mex(varargin)
+%Input vector of floating point numbers from ECLIPSE input file (MEX)
+%
+% SYNOPSIS:
+%   [v, pos] = readvector_mex(fname, pos, nel)
+%
+% PARAMETERS:
+%   fname - Name of ECLIPSE input file, typically FOPEN(fid).
+%
+%   pos   - Byte offset of first vector element, typically FTELL(fid).
+%
+%   nel   - Expected number of vector elements.  INF if unknown.  Used
+%           for preallocation only.
+%
+% RETURNS:
+%   v     - Column vector of all elements up to the terminating slash
+%           character ('/') or end of file.  Repeat counts (N*value) are
+%           expanded and comments ('--') are skipped.
+%
+%   pos   - Byte offset of the terminating slash character, or of the end
+%           of file if the vector is not terminated.
+%
+% NOTE:
+%   Compiles and invokes MEX function of the same name on first call.
+%   Function 'readVector' uses the compiled MEX function if it exists.
+%
+% SEE ALSO:
+%   `readGRID`, `readGridBoxArray`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   % Note: We do not use mrstDefaultMexFlags here as the number parser
+   % must not be compiled with -ffast-math.
+   if ispc
+      CXXFLAGS = { 'COMPFLAGS=$COMPFLAGS /EHsc /openmp' };
+      LINK     = { };
+   else
+      CXXFLAGS = {'CXXFLAGS="$CXXFLAGS', '-fPIC', '-O3', '-std=c++11', ...
+                  '-fopenmp', '-Wall', '-Wextra', '-pedantic',         ...
+                  '-Wcast-align', '-Wpointer-arith', '-Wundef',        ...
+                  '-Wcast-qual', '-Wshadow', '-Wwrite-strings"'};
+      LINK     = {'LDFLAGS="$LDFLAGS', '-fopenmp"'};
+   end
+
+   % Shared memory-mapped file reader, mappedfile.h
+   d       = fileparts(mfilename('fullpath'));
+   INCLUDE = { ['-I', fullfile(d, '..', '..', 'mex')] };
+
+   OPTS = { '-O', '-largeArrayDims' };
+
+   SRC = { 'readvector_mex.cpp' };
+
+   buildmex(CXXFLAGS{:}, LINK{:}, INCLUDE{:}, OPTS{:}, SRC{:});
+
+   % Call MEX edition.
+   [varargout{1:nargout}] = readvector_mex(varargin{:});
+end
@@ -24,7 +24,7 @@ function vec = readVector(fid, field, nel)
 %           character.
 %
 % SEE ALSO:
-%   `fopen`, `fseek`, `textscan`.
+%   `fopen`, `fseek`, `textscan`, `readvector_mex`.
 
 %{
 Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
@@ -45,7 +45,10 @@ You should have received a copy of the GNU General Public License
 along with MRST.  If not, see <http://www.gnu.org/licenses/>.
 %}
 
-   if mrstPlatform('octave')
+   if exist('readvector_mex', 'file') == 3
+      % Compiled reader is available (run READVECTOR_MEX once to build).
+      vec = readVector_native(fid, field, nel);
+   elseif mrstPlatform('octave')
       % We're targeting Octave.  Use original (slow) rV impl.
       vec = readVectorOld(fid, field, nel);
    else
@@ -0,0 +1,72 @@
+function vec = readVector_native(fid, field, nel)
+%Input vector of floating point numbers from ECLIPSE input file (MEX)
+%
+% SYNOPSIS:
+%   v = readVector_native(fid, field, nel)
+%
+% PARAMETERS:
+%   fid   - File identifier (as defined by FOPEN) of ECLIPSE input file
+%           open for reading.  Assumed to point to a seekable (i.e.,
+%           physical) file on disk, not (e.g.) a POSIX pipe.
+%
+%   field - Name (string) identifying the keyword (field) currently being
+%           processed.  Used for error identification/messages only.
+%
+%   nel   - Number of elements to read from input stream.  As a special
+%           case, the caller may pass nel==INF (or nel=='inf') to read as
+%           much as possible.
+%
+% RETURNS:
+%   v     - Vector, length 'nel', of floating point numbers defining the
+%           contents of ECLIPSE keyword 'field'.
+%
+% NOTE:
+%   Same behaviour as function readVector_textscan, but the vector is
+%   parsed in compiled code by MEX function 'readvector_mex'.
+%
+% SEE ALSO:
+%   `readVector_textscan`, `readvector_mex`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   if isnan(nel)
+      error('Argument:Invalid', 'Element Count Cannot be NaN');
+   end
+
+   if ischar(nel) && strcmpi(nel, 'inf')
+      nel = inf;
+   end
+
+   [vec, pos] = readvector_mex(fopen(fid), ftell(fid), nel);
+
+   % Position stream at the terminator ('/') or at EOF.
+   fseek(fid, pos, 'bof');
+
+   if isfinite(nel) && (numel(vec) ~= nel)
+      % Leave terminator in the stream as readVector_textscan does.
+      if ~strcmp(field, 'TOPS')
+          warning('VectorSize:Mismatch', ...
+                  'Failed to Input Keyword Vector ''%s''', field);
+      end
+   else
+      % Skip terminator and the remainder of its line.
+      fgetl(fid);
+   end
+end
@@ -1,4 +1,5 @@
 % Files
+%   cachedEclipseGrid - Construct MRST grid with geometry from ECLIPSE GRID section, using a cache
 %   initEclipseGrid - Construct MRST grid from ECLIPSE GRID section.
 
 %{
@@ -0,0 +1,188 @@
+function G = cachedEclipseGrid(deck, varargin)
+%Construct MRST grid with geometry from ECLIPSE GRID section, using a cache
+%
+% SYNOPSIS:
+%   G = cachedEclipseGrid(deck)
+%   G = cachedEclipseGrid(deck, 'pn1', pv1, ...)
+%
+% PARAMETERS:
+%   deck - Raw input data in Deck form as defined by function
+%          'readEclipseDeck'.
+%
+% OPTIONAL PARAMETERS:
+%  'pn'/pv - List of 'key'/value pairs defining optional parameters.  The
+%            supported options are:
+%
+%            cacheDir       - Directory of cached grids.
+%                             DEFAULT: fullfile(mrstOutputDirectory(),
+%                                               'gridcache')
+%
+%            useMexGeometry - Compute geometry using 'mcomputeGeometry'
+%                             rather than 'computeGeometry'.
+%                             DEFAULT: false.
+%
+%            Verbose        - Whether or not to report cache hits and
+%                             misses.  DEFAULT: mrstVerbose().
+%
+%            All other options are passed on to 'initEclipseGrid'.
+%
+% RETURNS:
+%   G - Valid 'grid_structure', or array of such, with geometry.
+%
+% NOTE:
+%   Only corner-point grids (COORD/ZCORN) are cached.  The cache key is the
+%   MD5 hash of the COORD, ZCORN, ACTNUM, MAPAXES, NNC and PINCH keywords
+%   (and MULTZ, which scales the PINCH connections), the Cartesian
+%   dimensions and the processing options, including any 'Tolerance'.
+%   With option 'removeZeroPV' the PORO, PORV, NTG and MULTPV arrays,
+%   which decide the cells that are removed, are hashed too.  On a cache
+%   miss the grid is constructed by 'initEclipseGrid' and stored in a
+%   binary file named by the key.  On a hit the file is memory mapped and
+%   the grid structure reconstructed without any grid processing.
+%
+%   Remove the cache directory to reclaim disk space.  Other grid types
+%   are constructed directly.
+%
+% SEE ALSO:
+%   `initEclipseGrid`, `computeGeometry`, `mcomputeGeometry`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   opt = struct('cacheDir',       '',    ...
+                'useMexGeometry', false, ...
+                'Verbose',        mrstVerbose);
+   [opt, extra] = merge_options(opt, varargin{:});
+
+   if ~all(isfield(deck.GRID, {'COORD', 'ZCORN'}))
+      G = build_grid(deck, opt, extra);
+      return
+   end
+
+   if isempty(opt.cacheDir)
+      opt.cacheDir = fullfile(mrstOutputDirectory(), 'gridcache');
+   end
+
+   key = grid_key(deck, opt, extra);
+   fn  = fullfile(opt.cacheDir, [key, '.grid']);
+
+   G = [];
+   if exist(fn, 'file') == 2
+      G = read_cache(fn, key);
+   end
+
+   if ~isempty(G)
+      dispif(opt.Verbose, 'Grid read from cache file ''%s''\n', fn);
+      return
+   end
+
+   G = build_grid(deck, opt, extra);
+
+   write_cache(fn, key, G, opt);
+end
+
+%--------------------------------------------------------------------------
+
+function G = build_grid(deck, opt, extra)
+   G = initEclipseGrid(deck, extra{:});
+
+   if opt.useMexGeometry
+      mrstModule add libgeometry
+      geom = @mcomputeGeometry;
+   else
+      geom = @computeGeometry;
+   end
+
+   if ~isempty(G)
+      G = arrayfun(geom, G, 'UniformOutput', false);
+      G = reshape([G{:}], size(G));
+   end
+end
+
+%--------------------------------------------------------------------------
+
+function key = grid_key(deck, opt, extra)
+   % Bump version whenever grid processing changes its output, or when
+   % the grid starts to depend on other keywords.
+   version = 'gridcache-3';
+
+   % Every GRID keyword read by initEclipseGrid, processGRDECL and
+   % processPINCH for a corner-point grid.  MULTZ only enters through the
+   % PINCH connections.
+   kws = {'COORD', 'ZCORN', 'ACTNUM', 'MAPAXES', 'NNC', 'PINCH'};
+   if isfield(deck.GRID, 'PINCH')
+      kws = [kws, {'MULTZ'}];
+   end
+   if remove_zero_pv(extra)
+      kws = [kws, {'PORO', 'PORV', 'NTG', 'MULTPV'}];
+   end
+
+   grdecl = deck.GRID;
+   arrays = {};
+   for kw = kws
+      if isfield(grdecl, kw{1})
+         a = grdecl.(kw{1});
+         arrays = [arrays, { kw{1}, class(a), size(a), a }];  %#ok<AGROW>
+      end
+   end
+
+   key = md5sum({ version, grdecl.cartDims, arrays, extra, ...
+                  double(opt.useMexGeometry) });
+end
+
+%--------------------------------------------------------------------------
+
+function tf = remove_zero_pv(extra)
+   % Value of initEclipseGrid's 'removeZeroPV' option, last one wins.
+   tf = false;
+   for k = 1 : 2 : numel(extra) - 1
+      if ischar(extra{k}) && strcmpi(extra{k}, 'removeZeroPV')
+         tf = logical(extra{k + 1});
+      end
+   end
+end
+
+%--------------------------------------------------------------------------
+
+function G = read_cache(fn, key)
+   try
+      G = gridcache_mex('read', fn, key);
+   catch ME
+      warning('GridCache:ReadFailed', ...
+              'Unable to read grid cache file ''%s'': %s', fn, ME.message);
+      G = [];
+   end
+end
+
+%--------------------------------------------------------------------------
+
+function write_cache(fn, key, G, opt)
+   try
+      if exist(opt.cacheDir, 'dir') ~= 7
+         mkdir(opt.cacheDir);
+      end
+
+      gridcache_mex('write', fn, key, G);
+
+      dispif(opt.Verbose, 'Grid stored in cache file ''%s''\n', fn);
+   catch ME
+      warning('GridCache:WriteFailed', ...
+              'Unable to cache grid in ''%s'': %s', fn, ME.message);
+   end
+end
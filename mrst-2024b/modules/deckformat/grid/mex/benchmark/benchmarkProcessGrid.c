@@ -0,0 +1,265 @@
+/*
+ * Standalone benchmark for corner-point grid processing.
+ *
+ * Builds a synthetic faulted corner-point model (sloping pillars, layers
+ * with throws across a north-south and an east-west fault, a sprinkling
+ * of inactive cells) and times
+ *
+ *   - finduniquepoints(): sorting and uniquifying the z-coordinates
+ *     along every pillar and numbering the corner points, and
+ *   - process_grdecl(): the complete processing (with --full).
+ *
+ * Usage:
+ *   benchmarkProcessGrid [--dims 500x500x200] [--threads 1,2,4]
+ *                        [--reps 3] [--full]
+ *
+ * The default 500x500x200 model holds 5e7 cells; finduniquepoints needs
+ * about 9 GB and --full considerably more.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "preprocess.h"
+#include "uniquepoints.h"
+
+static double
+wall_time(void)
+{
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return ((double) clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+static void
+set_threads(int n)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(n);
+#else
+    (void) n;
+#endif
+}
+
+/* Fault throws: cells east of nx/2 alternate up and down by row of
+ * pillars, cells north of ny/3 by column of pillars. */
+static double
+corner_depth(int nx, int ny, int i, int j, int k)
+{
+    int    ci = i / 2, cj = j / 2, pi = (i + 1) / 2, pj = (j + 1) / 2;
+    double thr = 0.0;
+
+    if (ci >= nx / 2) { thr += 0.6  * ((pj % 2) ? 1 : -1); }
+    if (cj >= ny / 3) { thr += 0.45 * ((pi % 2) ? 1 : -1); }
+
+    return (k / 2 + k % 2) + thr + 0.05 * pi;
+}
+
+static int
+is_active(size_t c)
+{
+    return (c % 17) != 3;
+}
+
+struct model {
+    double       *coord;
+    double       *zcorn;
+    int          *actnum;
+    struct grdecl g;
+};
+
+static void
+allocate_model(int nx, int ny, int nz, struct model *m)
+{
+    size_t nc = (size_t) nx * ny * nz;
+    int    i, j;
+
+    m->coord  = malloc(6 * (size_t) (nx + 1) * (ny + 1) * sizeof *m->coord);
+    m->zcorn  = malloc(8 * nc * sizeof *m->zcorn);
+    m->actnum = malloc(nc * sizeof *m->actnum);
+    if ((m->coord == NULL) || (m->zcorn == NULL) || (m->actnum == NULL)) {
+        fprintf(stderr, "Could not allocate %lu cell model\n",
+                (unsigned long) nc);
+        exit(1);
+    }
+
+    for (j = 0; j <= ny; ++j) {
+        for (i = 0; i <= nx; ++i) {
+            double *p = m->coord + 6 * (i + (nx + 1) * (size_t) j);
+            p[0] = i;  p[1] = j;  p[2] = 0.0;
+            p[3] = i + 0.1 * j;  p[4] = j;  p[5] = 2.0 * nz;
+        }
+    }
+
+    m->g.dims[0] = nx;  m->g.dims[1] = ny;  m->g.dims[2] = nz;
+    m->g.coord   = m->coord;
+    m->g.zcorn   = m->zcorn;
+    m->g.actnum  = m->actnum;
+}
+
+/* ECLIPSE layout (i fastest), as read from a deck. */
+static void
+make_grdecl(int nx, int ny, int nz, struct model *m)
+{
+    size_t c, nc = (size_t) nx * ny * nz;
+    int    i, j, k;
+
+    allocate_model(nx, ny, nz, m);
+
+    for (k = 0; k < 2 * nz; ++k) {
+        for (j = 0; j < 2 * ny; ++j) {
+            for (i = 0; i < 2 * nx; ++i) {
+                m->zcorn[i + 2 * nx * (j + 2 * (size_t) ny * k)] =
+                    corner_depth(nx, ny, i, j, k);
+            }
+        }
+    }
+    for (c = 0; c < nc; ++c) { m->actnum[c] = is_active(c); }
+}
+
+/* Layout expected by finduniquepoints (k fastest), as prepared by
+ * process_grdecl. */
+static void
+make_permuted(int nx, int ny, int nz, struct model *m)
+{
+    int i, j, k;
+
+    allocate_model(nx, ny, nz, m);
+
+    for (j = 0; j < 2 * ny; ++j) {
+        for (i = 0; i < 2 * nx; ++i) {
+            for (k = 0; k < 2 * nz; ++k) {
+                m->zcorn[k + 2 * (size_t) nz * (i + 2 * (size_t) nx * j)] =
+                    corner_depth(nx, ny, i, j, k);
+            }
+        }
+    }
+    for (j = 0; j < ny; ++j) {
+        for (i = 0; i < nx; ++i) {
+            for (k = 0; k < nz; ++k) {
+                m->actnum[k + nz * (i + nx * (size_t) j)] =
+                    is_active(i + nx * (j + ny * (size_t) k));
+            }
+        }
+    }
+}
+
+static void
+free_model(struct model *m)
+{
+    free(m->coord);
+    free(m->zcorn);
+    free(m->actnum);
+}
+
+static void
+bench_unique_points(const struct grdecl *g, int reps)
+{
+    struct processed_grid out;
+    size_t        nc = (size_t) g->dims[0] * g->dims[1] * g->dims[2];
+    mrst_index_t *plist;
+    double        t, best = 1e100;
+    int           r;
+
+    plist = malloc(8 * (nc + (size_t) g->dims[0] * g->dims[1]) *
+                   sizeof *plist);
+    if (plist == NULL) {
+        fprintf(stderr, "Could not allocate point list\n");
+        exit(1);
+    }
+
+    memcpy(out.dimensions, g->dims, sizeof out.dimensions);
+    for (r = 0; r < reps; ++r) {
+        t = wall_time();
+        finduniquepoints(g, plist, 0.0, &out);
+        t = wall_time() - t;
+        if (t < best) { best = t; }
+        if (r + 1 < reps) { free(out.node_coordinates); }
+    }
+
+    printf("  finduniquepoints  %9.3f s   %lu pillar nodes\n",
+           best, (unsigned long) out.number_of_nodes_on_pillars);
+
+    free(out.node_coordinates);
+    free(plist);
+}
+
+static void
+bench_process_grdecl(const struct grdecl *g, int reps)
+{
+    struct processed_grid out;
+    double t, best = 1e100;
+    int    r;
+
+    for (r = 0; r < reps; ++r) {
+        t = wall_time();
+        process_grdecl(g, 0.0, &out);
+        t = wall_time() - t;
+        if (t < best) { best = t; }
+        if (r + 1 < reps) { free_processed_grid(&out); }
+    }
+
+    printf("  process_grdecl    %9.3f s   %lu faces, %lu nodes, %lu cells\n",
+           best, (unsigned long) out.number_of_faces,
+           (unsigned long) out.number_of_nodes,
+           (unsigned long) out.number_of_cells);
+
+    free_processed_grid(&out);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int   nx = 500, ny = 500, nz = 200, reps = 3, full = 0, a;
+    const char *threads = "1";
+    const char *p;
+    struct model  m;
+
+    for (a = 1; a < argc; ++a) {
+        if (!strcmp(argv[a], "--dims") && (a + 1 < argc)) {
+            if (sscanf(argv[++a], "%dx%dx%d", &nx, &ny, &nz) != 3) {
+                fprintf(stderr, "Dimensions must be NXxNYxNZ\n");
+                return 1;
+            }
+        } else if (!strcmp(argv[a], "--threads") && (a + 1 < argc)) {
+            threads = argv[++a];
+        } else if (!strcmp(argv[a], "--reps") && (a + 1 < argc)) {
+            reps = atoi(argv[++a]);
+        } else if (!strcmp(argv[a], "--full")) {
+            full = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--dims NXxNYxNZ] [--threads 1,2,4] "
+                    "[--reps N] [--full]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Faulted corner-point model %dx%dx%d\n", nx, ny, nz);
+
+    for (p = threads; p != NULL; p = strchr(p, ',')) {
+        int nt;
+
+        if (*p == ',') { ++p; }
+        nt = atoi(p);
+        set_threads(nt);
+        printf("threads %d\n", nt);
+
+        make_permuted(nx, ny, nz, &m);
+        bench_unique_points(&m.g, reps);
+        free_model(&m);
+
+        if (full) {
+            make_grdecl(nx, ny, nz, &m);
+            bench_process_grdecl(&m.g, reps);
+            free_model(&m);
+        }
+    }
+
+    return 0;
+}
@@ -60,14 +60,14 @@
 
 /* Determine face topology first, then compute intersection. */
 /* All intersections that occur are present in the final face geometry.*/
-static int *
-computeFaceTopology(const int *a1, const int *a2,
-                    const int *b1, const int *b2,
-                    int intersect[4], int *faces)
+static mrst_index_t *
+computeFaceTopology(const mrst_index_t *a1, const mrst_index_t *a2,
+                    const mrst_index_t *b1, const mrst_index_t *b2,
+                    mrst_index_t intersect[4], mrst_index_t *faces)
 {
-    int mask[8];
+    mrst_index_t mask[8];
     int k;
-    int *f;
+    mrst_index_t *f;
 
     for (k = 0; k < 8; k++) { mask[k] = -1; }
 
@@ -185,8 +185,8 @@ computeFaceTopology(const int *a1, const int *a2,
      ((a1 < b1) && (a2 > b2)))
 
 static int
-faceintersection(const int *a1, const int *a2,
-                 const int *b1, const int *b2)
+faceintersection(const mrst_index_t *a1, const mrst_index_t *a2,
+                 const mrst_index_t *b1, const mrst_index_t *b2)
 {
     return
         MAX(a1[0], b1[0]) < MIN(a1[1], b1[1]) ||
@@ -197,35 +197,40 @@ faceintersection(const int *a1, const int *a2,
 
 
 #define MEANINGFUL_FACE(i, j)                                   \
-    (! ((a1[i]   == INT_MIN) && (b1[j]   == INT_MIN)) &&        \
-     ! ((a1[i+1] == INT_MAX) && (b1[j+1] == INT_MAX)))
-
-
-/* work should be pointer to 2n ints initialised to zero . */
-void findconnections(int n, int *pts[4],
-                     int *intersectionlist,
-                     int *work,
-                     struct processed_grid *out)
+    (! ((a1[i]   == MRST_INDEX_MIN) && (b1[j]   == MRST_INDEX_MIN)) && \
+     ! ((a1[i+1] == MRST_INDEX_MAX) && (b1[j+1] == MRST_INDEX_MAX)))
+
+
+/* work should be pointer to 2n ints initialised to zero .  If out is
+   NULL, the faces, face nodes and intersections are only counted and
+   added to count[0], count[1] and count[2]. */
+static void connections(int n, mrst_index_t *pts[4],
+                        mrst_index_t *intersectionlist,
+                        mrst_index_t *work,
+                        struct processed_grid *out,
+                        mrst_index_t count[3])
 {
     /* vectors of point numbers for faces a(b) on pillar 1(2) */
-    int *a1 = pts[0];
-    int *a2 = pts[1];
-    int *b1 = pts[2];
-    int *b2 = pts[3];
+    mrst_index_t *a1 = pts[0];
+    mrst_index_t *a2 = pts[1];
+    mrst_index_t *b1 = pts[2];
+    mrst_index_t *b2 = pts[3];
 
     /* Intersection record for top line and bottomline of a */
-    int *itop    = work;
-    int *ibottom = work + n;
-    int *f       = out->face_nodes + out->face_ptr[out->number_of_faces];
-    int *c       = out->face_neighbors + 2*out->number_of_faces;
+    mrst_index_t *itop    = work;
+    mrst_index_t *ibottom = work + n;
+    mrst_index_t  face[8];
+    mrst_index_t *f       = out != NULL ? out->face_nodes + out->face_ptr[out->number_of_faces] : face;
+    mrst_index_t *c       = out != NULL ? out->face_neighbors + 2*out->number_of_faces : NULL;
+    mrst_index_t  nodes   = out != NULL ? out->number_of_nodes : 0;
 
     int k1  = 0;
     int k2  = 0;
 
     int i,j=0;
-    int intersect[4];
-    int *tmp;
-    int zn;
+    mrst_index_t intersect[4];
+    mrst_index_t *tmp;
+    mrst_index_t zn;
     /* for (i=0; i<2*n; work[i++]=-1); */
 
     for (i = 0; i < 4; i++) { intersect[i] = -1; }
@@ -268,7 +273,11 @@ void findconnections(int n, int *pts[4],
                         int cell_a = i%2 != 0 ? (i-1)/2 : -1;
                         int cell_b = j%2 != 0 ? (j-1)/2 : -1;
 
-                        if (cell_a != -1 || cell_b != -1){
+                        if ((cell_a != -1 || cell_b != -1) && out == NULL){
+                            count[0] += 1;
+                            count[1] += 2 + (a2[i+1] - a2[i]) + (a1[i+1] - a1[i]);
+                        }
+                        else if (cell_a != -1 || cell_b != -1){
                             *c++ = cell_a;
                             *c++ = cell_b;
 
@@ -307,13 +316,15 @@ void findconnections(int n, int *pts[4],
                     /* Find new intersection */
                     if (LINE_INTERSECTION(a1[i+1], a2[i+1],
                                           b1[j+1], b2[j+1])) {
-                        itop[j+1] = out->number_of_nodes++;
+                        itop[j+1] = nodes++;
 
                         /* store point numbers of intersecting lines */
-                        *intersectionlist++ = a1[i+1];
-                        *intersectionlist++ = a2[i+1];
-                        *intersectionlist++ = b1[j+1];
-                        *intersectionlist++ = b2[j+1];
+                        if (out != NULL) {
+                            *intersectionlist++ = a1[i+1];
+                            *intersectionlist++ = a2[i+1];
+                            *intersectionlist++ = b1[j+1];
+                            *intersectionlist++ = b2[j+1];
+                        }
 
 
                     }else{
@@ -327,8 +338,8 @@ void findconnections(int n, int *pts[4],
                     intersect[3] = itop[j+1];     /* i+1 x j+1 */
 
 
-                    /* Add face to list of faces if no INT_MIN or
-                     * INT_MAX appear in a or b. */
+                    /* Add face to list of faces if no MRST_INDEX_MIN or
+                     * MRST_INDEX_MAX appear in a or b. */
                     if (MEANINGFUL_FACE(i,j)) {
 
                         /*
@@ -340,7 +351,12 @@ void findconnections(int n, int *pts[4],
 
 
 
-                        if (cell_a != -1 || cell_b != -1){
+                        if ((cell_a != -1 || cell_b != -1) && out == NULL){
+                            count[0] += 1;
+                            count[1] += (mrst_index_t) (computeFaceTopology(a1+i, a2+i, b1+j, b2+j,
+                                                                   intersect, face) - face);
+                        }
+                        else if (cell_a != -1 || cell_b != -1){
                             *c++ = cell_a;
                             *c++ = cell_b;
 
@@ -374,6 +390,30 @@ void findconnections(int n, int *pts[4],
         /* Set j to appropriate start position for next i */
         j = MIN(k1, k2);
     }
+
+    if (out != NULL) {
+        out->number_of_nodes = nodes;
+    }
+    else {
+        count[2] += nodes;
+    }
+}
+
+
+void findconnections(int n, mrst_index_t *pts[4],
+                     mrst_index_t *intersectionlist,
+                     mrst_index_t *work,
+                     struct processed_grid *out)
+{
+    connections(n, pts, intersectionlist, work, out, NULL);
+}
+
+
+void countconnections(int n, mrst_index_t *pts[4],
+                      mrst_index_t *work,
+                      mrst_index_t count[3])
+{
+    connections(n, pts, NULL, work, NULL, count);
 }
 
 /* Local Variables:    */
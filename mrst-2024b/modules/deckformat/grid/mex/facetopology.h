@@ -36,11 +36,17 @@
 #define OPM_FACETOPOLOGY_HEADER
 
 
-void findconnections(int n, int *pts[4],
-                     int *intersectionlist,
-                     int *work,
+void findconnections(int n, mrst_index_t *pts[4],
+                     mrst_index_t *intersectionlist,
+                     mrst_index_t *work,
                      struct processed_grid *out);
 
+/* Add the number of faces, face nodes and new intersection points that
+ * findconnections() would produce to count[0], count[1] and count[2]. */
+void countconnections(int n, mrst_index_t *pts[4],
+                      mrst_index_t *work,
+                      mrst_index_t count[3]);
+
 #endif /* OPM_FACETOPOLOGY_HEADER */
 
 /* Local Variables:    */
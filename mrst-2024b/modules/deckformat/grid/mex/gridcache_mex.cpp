@@ -0,0 +1,446 @@
+/*
+  Binary cache of processed grids.
+
+  SYNOPSIS:
+         gridcache_mex('write', fname, key, G)
+    G  = gridcache_mex('read',  fname, key)
+
+  'write' stores the grid structure G (or any nesting of structs, cell
+  arrays and real full numeric, logical or character arrays) in file
+  'fname', tagged by the character string 'key'.  The file is written to
+  a temporary name and renamed on completion.
+
+  'read' memory maps 'fname' and rebuilds the structure.  It returns []
+  if the file does not exist, was written by a different format version
+  or on a machine of different byte order, is truncated, or was tagged
+  by another key.
+
+  Used by function cachedEclipseGrid.
+*/
+
+/*
+  Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+  This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+  MRST is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  MRST is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <mex.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "mappedfile.h"
+
+namespace {
+
+    typedef unsigned int       u32;
+    typedef unsigned long long u64;
+
+    /*
+      File layout (native byte order, all items 8-byte aligned):
+
+        header   magic, format version, byte order mark, key, file size
+        node     kind, class, number of dimensions, number of fields,
+                 dimensions (u64 each), then
+                   array:  element data
+                   struct: field names (u32 length, characters), then
+                           the field values element by element
+                   cell:   the elements
+    */
+    const char MAGIC[8]   = { 'M', 'R', 'S', 'T', 'G', 'R', 'I', 'D' };
+    const u32  VERSION    = 1;
+    const u32  ORDER_MARK = 0x01020304u;
+    const int  KEY_LEN    = 64;
+
+    struct Header {
+        char magic[8];
+        u32  version;
+        u32  byte_order;
+        char key[KEY_LEN];
+        u64  size;
+    };
+
+    enum Kind { ARRAY = 0, STRUCT = 1, CELL = 2 };
+
+    struct NodeHeader {
+        u32 kind;
+        u32 cls;
+        u32 ndims;
+        u32 nfields;
+    };
+
+    inline u64 aligned(u64 n) { return (n + 7) & ~u64(7); }
+
+
+    // ------------------------------------------------------------------
+    // Writing
+    // ------------------------------------------------------------------
+
+    class Writer
+    {
+    public:
+        explicit Writer(std::FILE *fp) : fp_(fp), pos_(0), ok_(true) {}
+
+        void put(const void *p, u64 n)
+        {
+            if (ok_ && (n > 0)) {
+                ok_ = std::fwrite(p, 1, n, fp_) == n;
+            }
+            pos_ += n;
+
+            static const char zero[8] = { 0 };
+            const u64 pad = aligned(pos_) - pos_;
+            if (ok_ && (pad > 0)) {
+                ok_ = std::fwrite(zero, 1, pad, fp_) == pad;
+            }
+            pos_ += pad;
+        }
+
+        u64  position() const { return pos_; }
+        bool ok()       const { return ok_; }
+
+    private:
+        std::FILE *fp_;
+        u64        pos_;
+        bool       ok_;
+    };
+
+
+    bool is_plain_array(const mxArray *a)
+    {
+        return (mxIsNumeric(a) || mxIsLogical(a) || mxIsChar(a))
+            && ! mxIsSparse(a) && ! mxIsComplex(a);
+    }
+
+
+    bool write_empty(Writer &w);
+
+    // Returns false for content that cannot be stored.
+    bool write_node(Writer &w, const mxArray *a)
+    {
+        NodeHeader h;
+        h.kind    = mxIsStruct(a) ? STRUCT : (mxIsCell(a) ? CELL : ARRAY);
+        h.cls     = static_cast<u32>(mxGetClassID(a));
+        h.ndims   = static_cast<u32>(mxGetNumberOfDimensions(a));
+        h.nfields = mxIsStruct(a) ? static_cast<u32>(mxGetNumberOfFields(a)) : 0;
+
+        if ((h.kind == ARRAY) && ! is_plain_array(a)) {
+            return false;
+        }
+
+        std::vector<u64> dims(h.ndims);
+        for (u32 d = 0; d < h.ndims; ++d) {
+            dims[d] = mxGetDimensions(a)[d];
+        }
+
+        w.put(&h, sizeof h);
+        w.put(&dims[0], dims.size() * sizeof dims[0]);
+
+        const std::size_t n = mxGetNumberOfElements(a);
+
+        if (h.kind == ARRAY) {
+            w.put(mxGetData(a), u64(n) * mxGetElementSize(a));
+        }
+        else if (h.kind == STRUCT) {
+            for (u32 f = 0; f < h.nfields; ++f) {
+                const char *name = mxGetFieldNameByNumber(a, f);
+                const u32   len  = static_cast<u32>(std::strlen(name));
+
+                w.put(&len, sizeof len);
+                w.put(name, len);
+            }
+            for (std::size_t e = 0; e < n; ++e) {
+                for (u32 f = 0; f < h.nfields; ++f) {
+                    const mxArray *v = mxGetFieldByNumber(a, e, f);
+                    if ((v == 0) ? ! write_empty(w) : ! write_node(w, v)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        else {
+            for (std::size_t e = 0; e < n; ++e) {
+                const mxArray *v = mxGetCell(a, e);
+                if ((v == 0) ? ! write_empty(w) : ! write_node(w, v)) {
+                    return false;
+                }
+            }
+        }
+
+        return w.ok();
+    }
+
+
+    // Unset struct fields and cell elements are stored as [].
+    bool write_empty(Writer &w)
+    {
+        mxArray *e  = mxCreateDoubleMatrix(0, 0, mxREAL);
+        const bool ok = write_node(w, e);
+        mxDestroyArray(e);
+
+        return ok;
+    }
+
+
+    bool write_cache(const std::string &fname, const std::string &key,
+                     const mxArray *G, char *msg)
+    {
+        char suffix[32];
+        std::sprintf(suffix, ".tmp%d", static_cast<int>(getpid()));
+        const std::string tmp = fname + suffix;
+
+        std::FILE *fp = std::fopen(tmp.c_str(), "wb");
+        if (fp == 0) {
+            std::sprintf(msg, "Unable to create cache file '%.400s'",
+                         tmp.c_str());
+            return false;
+        }
+
+        Header h;
+        std::memset(&h, 0, sizeof h);
+        std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+        h.version    = VERSION;
+        h.byte_order = ORDER_MARK;
+        std::strncpy(h.key, key.c_str(), KEY_LEN - 1);
+
+        Writer w(fp);
+        w.put(&h, sizeof h);
+
+        const bool stored = write_node(w, G);
+
+        // Record the final size last so that truncated files are rejected.
+        h.size = w.position();
+        bool ok = stored && w.ok()
+            && (std::fseek(fp, 0, SEEK_SET) == 0)
+            && (std::fwrite(&h, sizeof h, 1, fp) == 1);
+
+        ok = (std::fclose(fp) == 0) && ok;
+
+        if (ok) {
+#if defined(_WIN32)
+            std::remove(fname.c_str());
+#endif
+            ok = std::rename(tmp.c_str(), fname.c_str()) == 0;
+        }
+
+        if (! ok) {
+            std::remove(tmp.c_str());
+            std::sprintf(msg, stored
+                         ? "Unable to write cache file '%.400s'"
+                         : "Cannot cache '%.400s': Only structs, cell arrays "
+                           "and real, full numeric, logical or char arrays "
+                           "are supported",
+                         fname.c_str());
+        }
+
+        return ok;
+    }
+
+
+    // ------------------------------------------------------------------
+    // Reading
+    // ------------------------------------------------------------------
+
+    class Reader
+    {
+    public:
+        Reader(const char *p, u64 n) : p_(p), end_(p + n) {}
+
+        u64 remaining() const { return static_cast<u64>(end_ - p_); }
+
+        // Pointer to the next n bytes, or null if the file is too short.
+        const char *get(u64 n)
+        {
+            const u64 step = aligned(n);
+            if ((step < n) || (step > remaining())) { return 0; }
+
+            const char *q = p_;
+            p_ += step;
+            return q;
+        }
+
+    private:
+        const char *p_, *end_;
+    };
+
+
+    // Returns null on malformed input.
+    mxArray *read_node(Reader &r)
+    {
+        const NodeHeader *h = reinterpret_cast<const NodeHeader *>
+            (r.get(sizeof(NodeHeader)));
+        if ((h == 0) || (h->ndims < 2) || (h->ndims > 64)) { return 0; }
+
+        const u64 *d = reinterpret_cast<const u64 *>
+            (r.get(h->ndims * sizeof(u64)));
+        if (d == 0) { return 0; }
+
+        // Every element occupies at least one byte of the remaining file.
+        std::vector<mwSize> dims(h->ndims);
+        u64 n = 1;
+        for (u32 k = 0; k < h->ndims; ++k) {
+            if ((d[k] > 0) && (n > r.remaining() / d[k])) { return 0; }
+
+            dims[k] = static_cast<mwSize>(d[k]);
+            n      *= d[k];
+        }
+
+        mxArray *a = 0;
+
+        if (h->kind == ARRAY) {
+            const mxClassID cls = static_cast<mxClassID>(h->cls);
+
+            if (cls == mxCHAR_CLASS) {
+                a = mxCreateCharArray(h->ndims, &dims[0]);
+            }
+            else if (cls == mxLOGICAL_CLASS) {
+                a = mxCreateLogicalArray(h->ndims, &dims[0]);
+            }
+            else if ((cls >= mxDOUBLE_CLASS) && (cls <= mxUINT64_CLASS)) {
+                a = mxCreateNumericArray(h->ndims, &dims[0], cls, mxREAL);
+            }
+            else {
+                return 0;
+            }
+
+            const u64   nb  = n * mxGetElementSize(a);
+            const char *src = r.get(nb);
+            if (src == 0) { mxDestroyArray(a); return 0; }
+
+            if (nb > 0) { std::memcpy(mxGetData(a), src, nb); }
+        }
+        else if (h->kind == STRUCT) {
+            std::vector<std::string>  names(h->nfields);
+            std::vector<const char *> cnames(h->nfields);
+
+            for (u32 f = 0; f < h->nfields; ++f) {
+                const u32  *len = reinterpret_cast<const u32 *>(r.get(sizeof(u32)));
+                const char *s   = (len != 0) ? r.get(*len) : 0;
+                if (s == 0) { return 0; }
+
+                names[f].assign(s, *len);
+                cnames[f] = names[f].c_str();
+            }
+
+            a = mxCreateStructArray(h->ndims, &dims[0], h->nfields,
+                                    h->nfields > 0 ? &cnames[0] : 0);
+
+            for (u64 e = 0; e < n; ++e) {
+                for (u32 f = 0; f < h->nfields; ++f) {
+                    mxArray *v = read_node(r);
+                    if (v == 0) { mxDestroyArray(a); return 0; }
+
+                    mxSetFieldByNumber(a, static_cast<mwIndex>(e), f, v);
+                }
+            }
+        }
+        else if (h->kind == CELL) {
+            a = mxCreateCellArray(h->ndims, &dims[0]);
+
+            for (u64 e = 0; e < n; ++e) {
+                mxArray *v = read_node(r);
+                if (v == 0) { mxDestroyArray(a); return 0; }
+
+                mxSetCell(a, static_cast<mwIndex>(e), v);
+            }
+        }
+
+        return a;
+    }
+
+
+    // Returns null if there is no valid cache entry for the key.
+    mxArray *read_cache(const std::string &fname, const std::string &key)
+    {
+        MappedFile file(fname.c_str());
+        if (file.size() < sizeof(Header)) { return 0; }
+
+        const Header *h = reinterpret_cast<const Header *>(file.data());
+        char k[KEY_LEN] = { 0 };
+        std::strncpy(k, key.c_str(), KEY_LEN - 1);
+
+        if ((std::memcmp(h->magic, MAGIC, sizeof MAGIC) != 0) ||
+            (h->version != VERSION) || (h->byte_order != ORDER_MARK) ||
+            (std::memcmp(h->key, k, KEY_LEN) != 0) ||
+            (h->size != file.size()))
+        {
+            return 0;
+        }
+
+        Reader r(file.data(), file.size());
+        r.get(sizeof(Header));
+
+        return read_node(r);
+    }
+
+
+    std::string get_string(const mxArray *a)
+    {
+        char *s = mxArrayToString(a);
+        std::string r(s != 0 ? s : "");
+        mxFree(s);
+        return r;
+    }
+}
+
+
+void
+mexFunction(int nlhs,       mxArray *plhs[],
+            int nrhs, const mxArray *prhs[])
+{
+    static char msg[512];
+
+    if ((nrhs < 3) || ! mxIsChar(prhs[0]) ||
+        ! mxIsChar(prhs[1]) || ! mxIsChar(prhs[2]))
+    {
+        mexErrMsgTxt("Syntax is gridcache_mex('write', fname, key, G) "
+                     "or G = gridcache_mex('read', fname, key)");
+    }
+
+    const std::string cmd   = get_string(prhs[0]);
+    const std::string fname = get_string(prhs[1]);
+    const std::string key   = get_string(prhs[2]);
+
+    if (key.size() >= static_cast<std::size_t>(KEY_LEN)) {
+        mexErrMsgTxt("Cache key must be shorter than 64 characters");
+    }
+
+    if ((cmd == "write") && (nrhs == 4) && (nlhs == 0)) {
+        if (! write_cache(fname, key, prhs[3], msg)) {
+            mexErrMsgTxt(msg);
+        }
+    }
+    else if ((cmd == "read") && (nrhs == 3) && (nlhs <= 1)) {
+        plhs[0] = read_cache(fname, key);
+        if (plhs[0] == 0) {
+            plhs[0] = mxCreateDoubleMatrix(0, 0, mxREAL);
+        }
+    }
+    else {
+        mexErrMsgTxt("Syntax is gridcache_mex('write', fname, key, G) "
+                     "or G = gridcache_mex('read', fname, key)");
+    }
+}
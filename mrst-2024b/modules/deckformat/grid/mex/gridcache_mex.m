@@ -0,0 +1,69 @@
+function varargout = gridcache_mex(varargin)
+%Store or retrieve processed grid in binary cache file (MEX)
+%
+% SYNOPSIS:
+%       gridcache_mex('write', fname, key, G)
+%   G = gridcache_mex('read',  fname, key)
+%
+% PARAMETERS:
+%   fname - Name of cache file.
+%
+%   key   - Character string, shorter than 64 characters, identifying the
+%           input from which 'G' was constructed.  Typically an MD5 hash.
+%
+%   G     - Grid structure.  Any nesting of structures, cell arrays and
+%           real, full numeric, logical or character arrays is supported.
+%
+% RETURNS:
+%   G     - Grid structure stored by 'write', or [] if 'fname' does not
+%           exist, was not stored with the same 'key' and file format
+%           version or is otherwise invalid.
+%
+% NOTE:
+%   Compiles and invokes MEX function of the same name on first call.
+%   Function 'cachedEclipseGrid' is the intended user of this function.
+%
+% SEE ALSO:
+%   `cachedEclipseGrid`, `md5sum`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   if ispc
+      CXXFLAGS = { 'COMPFLAGS=$COMPFLAGS /EHsc' };
+   else
+      CXXFLAGS = {'CXXFLAGS="$CXXFLAGS', '-fPIC', '-O2', '-Wall',  ...
+                  '-Wextra', '-pedantic', '-Wcast-align',          ...
+                  '-Wpointer-arith', '-Wundef', '-Wcast-qual',     ...
+                  '-Wshadow', '-Wwrite-strings"'};
+   end
+
+   % Shared memory-mapped file reader, mappedfile.h
+   d       = fileparts(mfilename('fullpath'));
+   INCLUDE = { ['-I', fullfile(d, '..', '..', 'mex')] };
+
+   OPTS = { '-O', '-largeArrayDims' };
+
+   SRC = { 'gridcache_mex.cpp' };
+
+   buildmex(CXXFLAGS{:}, INCLUDE{:}, OPTS{:}, SRC{:});
+
+   % Call MEX edition.
+   [varargout{1:nargout}] = gridcache_mex(varargin{:});
+end
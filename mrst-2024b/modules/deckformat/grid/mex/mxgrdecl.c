@@ -47,8 +47,8 @@
 /*-------------------------------------------------------*/
 void mx_init_grdecl(struct grdecl *g, const mxArray *s)
 {
-    int i,n;
-    size_t numel;
+    int i;
+    size_t n, numel;
     mxArray *cartdims=NULL, *actnum=NULL, *coord=NULL, *zcorn=NULL;
 
     if (!mxIsStruct(s)
@@ -80,12 +80,12 @@ void mx_init_grdecl(struct grdecl *g, const mxArray *s)
     }
 
     n = g->dims[0];
-    for (i = 1; i < 3; i++) { n *= g->dims[ i ]; }
+    for (i = 1; i < 3; i++) { n *= (size_t) g->dims[ i ]; }
 
 
     if ((actnum = mxGetField(s, 0, "ACTNUM")) != NULL) {
         numel = mxGetNumberOfElements(actnum);
-        if ((! mxIsInt32(actnum)) || (numel != (size_t)(n))) {
+        if ((! mxIsInt32(actnum)) || (numel != n)) {
             mexErrMsgTxt("ACTNUM field must be nx*ny*nz numbers int32");
         }
         g->actnum = mxGetData(actnum);
@@ -97,7 +97,7 @@ void mx_init_grdecl(struct grdecl *g, const mxArray *s)
 
     numel = mxGetNumberOfElements(coord);
     if ((! mxIsDouble(coord)) ||
-        numel != (size_t)(6*(g->dims[0]+1)*(g->dims[1]+1))) {
+        numel != 6*((size_t) g->dims[0]+1)*(g->dims[1]+1)) {
         mexErrMsgTxt("COORD field must have 6*(nx+1)*(ny+1) doubles.");
     }
     g->coord = mxGetPr(coord);
@@ -105,7 +105,7 @@ void mx_init_grdecl(struct grdecl *g, const mxArray *s)
 
     numel = mxGetNumberOfElements(zcorn);
     if ((! mxIsDouble(zcorn)) ||
-        numel != (size_t)(8*g->dims[0]*g->dims[1]*g->dims[2])) {
+        numel != 8*n) {
         mexErrMsgTxt("ZCORN field must have 8*nx*ny*nz doubles.");
     }
     g->zcorn = mxGetPr(zcorn);
@@ -48,24 +48,15 @@
 #define MAX(i,j) ((i)>(j) ? (i) : (j))
 
 static void
-compute_cell_index(const int dims[3], int i, int j, int *neighbors, int len);
-
-static int
-checkmemory(int nz, struct processed_grid *out, int **intersections);
-
-static void
-process_vertical_faces(int direction,
-                       int **intersections,
-                       int *plist, int *work,
-                       struct processed_grid *out);
+compute_cell_index(const int dims[3], int i, int j,
+                   mrst_index_t *neighbors, mrst_index_t len);
 
 static void
-process_horizontal_faces(int **intersections,
-                         int *plist,
-                         struct processed_grid *out);
+process_faces(mrst_index_t *plist, mrst_index_t **intersections,
+              struct processed_grid *out);
 
-static int
-linearindex(const int dims[3], int i, int j, int k)
+static mrst_index_t
+linearindex(const int dims[3], int i, int j, mrst_index_t k)
 {
     assert (0 <= i);
     assert (0 <= j);
@@ -85,12 +76,12 @@ linearindex(const int dims[3], int i, int j, int k)
   (i-1, j-1, 0), (i-1, j, 0), (i, j-1, 0) and (i, j, 0) elements of
   field.  */
 static void
-igetvectors(int dims[3], int i, int j, int *field, int *v[])
+igetvectors(int dims[3], int i, int j, mrst_index_t *field, mrst_index_t *v[])
 {
-    int im = MAX(1,       i  ) - 1;
-    int ip = MIN(dims[0], i+1) - 1;
-    int jm = MAX(1,       j  ) - 1;
-    int jp = MIN(dims[1], j+1) - 1;
+    mrst_index_t im = MAX(1,       i  ) - 1;
+    mrst_index_t ip = MIN(dims[0], i+1) - 1;
+    mrst_index_t jm = MAX(1,       j  ) - 1;
+    mrst_index_t jp = MIN(dims[1], j+1) - 1;
 
     v[0] = field + dims[2]*(im + dims[0]* jm);
     v[1] = field + dims[2]*(im + dims[0]* jp);
@@ -112,9 +103,9 @@ igetvectors(int dims[3], int i, int j, int *field, int *v[])
 */
 static void
 compute_cell_index(const int dims[3], int i, int j,
-                   int *neighbors, int len)
+                   mrst_index_t *neighbors, mrst_index_t len)
 {
-    int k;
+    mrst_index_t k;
 
     if (((i < 0) || (i >= dims[0])) || /* 'i' outside [0, dims[0]) */
         ((j < 0) || (j >= dims[1]))) { /* 'j' outside [0, dims[1]) */
@@ -134,184 +125,161 @@ compute_cell_index(const int dims[3], int i, int j,
 
 
 /*-----------------------------------------------------------------
-  Ensure there's sufficient memory */
-static int
-checkmemory(int nz, struct processed_grid *out, int **intersections)
-{
-    int r, m, n, ok;
-
-    /* Ensure there is enough space to manage the (pathological) case
-     * of every single cell on one side of a fault connecting to all
-     * cells on the other side of the fault (i.e., an all-to-all cell
-     * connectivity pairing). */
-    r = (2*nz + 2) * (2*nz + 2);
-    m = out->m;
-    n = out->n;
-
-    if (out->number_of_faces +  r > m) {
-        m += MAX(m / 2,  2 * r);
-    }
-    if (out->face_ptr[out->number_of_faces] + 6*r > n) {
-        n += MAX(n / 2, 12 * r);
-    }
-
-    ok = m == out->m;
-    if (! ok) {
-        void *p1, *p2, *p3, *p4;
-
-        p1 = realloc(*intersections     , 4*m   * sizeof **intersections);
-        p2 = realloc(out->face_neighbors, 2*m   * sizeof *out->face_neighbors);
-        p3 = realloc(out->face_ptr      , (m+1) * sizeof *out->face_ptr);
-        p4 = realloc(out->face_tag      , 1*m   * sizeof *out->face_tag);
-
-        if (p1 != NULL) { *intersections      = p1; }
-        if (p2 != NULL) { out->face_neighbors = p2; }
-        if (p3 != NULL) { out->face_ptr       = p3; }
-        if (p4 != NULL) { out->face_tag       = p4; }
-
-        ok = (p1 != NULL) && (p2 != NULL) && (p3 != NULL) && (p4 != NULL);
-
-        if (ok) { out->m = m; }
-    }
-
-    if (ok && (n != out->n)) {
-        void *p1;
-
-        p1 = realloc(out->face_nodes, n * sizeof *out->face_nodes);
-
-        ok = p1 != NULL;
-
-        if (ok) {
-            out->face_nodes = p1;
-            out->n          = n;
-        }
-    }
-
-    return ok;
-}
-
-/*-----------------------------------------------------------------
-  For each vertical face (i.e. i or j constant),
+  For each vertical face (i.e. i or j constant) between the pillar
+  pairs of row j,
   -find point numbers for the corners and
   -cell neighbors.
   -new points on faults defined by two intgersecting lines.
 
   direction == 0 : constant-i faces.
   direction == 1 : constant-j faces.
+
+  The faces are appended to out, which must have room for them (see
+  count_vertical_row()).  New points are numbered from
+  out->number_of_nodes and the lines defining point p are stored in
+  intersections[4*(p - number_of_nodes_on_pillars) ...].
 */
 static void
-process_vertical_faces(int direction,
-                       int **intersections,
-                       int *plist, int *work,
-                       struct processed_grid *out)
+process_vertical_row(int direction, int j,
+                     mrst_index_t *intersections,
+                     mrst_index_t *plist, mrst_index_t *work,
+                     struct processed_grid *out)
 {
-    int i,j;
-    int *cornerpts[4];
+    int i;
+    mrst_index_t *cornerpts[4];
     int d[3];
-    int f;
+    mrst_index_t f;
     enum face_tag tag[] = { LEFT, BACK };
-    int *tmp;
+    mrst_index_t *tmp;
     int nx = out->dimensions[0];
-    int ny = out->dimensions[1];
     int nz = out->dimensions[2];
-    int startface;
-    int num_intersections;
-    int *ptr;
-    int len;
+    mrst_index_t startface;
+    mrst_index_t num_intersections;
+    mrst_index_t *ptr;
+    mrst_index_t len;
 
     assert ((direction == 0) || (direction == 1));
 
     d[0] = 2 * (nx + 0);
-    d[1] = 2 * (ny + 0);
+    d[1] = 2 * (out->dimensions[1] + 0);
     d[2] = 2 * (nz + 1);
 
-    for (j = 0; j < ny + direction; ++j) {
-        for (i = 0; i < nx + (1 - direction); ++i) {
+    for (i = 0; i < nx + (1 - direction); ++i) {
+
+        /* Vectors of point numbers */
+        igetvectors(d, 2*i + direction, 2*j + (1 - direction),
+                    plist, cornerpts);
+
+        if (direction == 1) {
+            /* 1   3       0   1    */
+            /*       --->           */
+            /* 0   2       2   3    */
+            /* rotate clockwise     */
+            tmp          = cornerpts[1];
+            cornerpts[1] = cornerpts[0];
+            cornerpts[0] = cornerpts[2];
+            cornerpts[2] = cornerpts[3];
+            cornerpts[3] = tmp;
+        }
 
-            if (! checkmemory(nz, out, intersections)) {
-                fprintf(stderr,
-                        "Could not allocate enough space in "
-                        "process_vertical_faces()\n");
-                exit(1);
-            }
+        /* int startface = ftab->position; */
+        startface = out->number_of_faces;
+        /* int num_intersections = *npoints - npillarpoints; */
+        num_intersections = out->number_of_nodes -
+            out->number_of_nodes_on_pillars;
+
+        /* Establish new connections (faces) along pillar pair. */
+        findconnections(2*nz + 2, cornerpts,
+                        intersections + 4*num_intersections,
+                        work, out);
+
+        /* Start of ->face_neighbors[] for this set of connections. */
+        ptr = out->face_neighbors + 2*startface;
+
+        /* Total number of cells (both sides) connected by this
+         * set of connections (faces). */
+        len = 2*out->number_of_faces - 2*startface;
+
+        /* Derive inter-cell connectivity (i.e. ->face_neighbors)
+         * of global (uncompressed) cells for this set of
+         * connections (faces). */
+        compute_cell_index(out->dimensions, i-1+direction, j-direction, ptr    , len);
+        compute_cell_index(out->dimensions, i            , j          , ptr + 1, len);
+
+        /* Tag the new faces */
+        f = startface;
+        for (; f < out->number_of_faces; ++f) {
+            out->face_tag[f] = tag[direction];
+        }
+    }
+}
 
-            /* Vectors of point numbers */
-            igetvectors(d, 2*i + direction, 2*j + (1 - direction),
-                        plist, cornerpts);
-
-            if (direction == 1) {
-                /* 1   3       0   1    */
-                /*       --->           */
-                /* 0   2       2   3    */
-                /* rotate clockwise     */
-                tmp          = cornerpts[1];
-                cornerpts[1] = cornerpts[0];
-                cornerpts[0] = cornerpts[2];
-                cornerpts[2] = cornerpts[3];
-                cornerpts[3] = tmp;
-            }
 
-            /* int startface = ftab->position; */
-            startface = out->number_of_faces;
-            /* int num_intersections = *npoints - npillarpoints; */
-            num_intersections = out->number_of_nodes -
-                out->number_of_nodes_on_pillars;
-
-            /* Establish new connections (faces) along pillar pair. */
-            findconnections(2*nz + 2, cornerpts,
-                            *intersections + 4*num_intersections,
-                            work, out);
-
-            /* Start of ->face_neighbors[] for this set of connections. */
-            ptr = out->face_neighbors + 2*startface;
-
-            /* Total number of cells (both sides) connected by this
-             * set of connections (faces). */
-            len = 2*out->number_of_faces - 2*startface;
-
-            /* Derive inter-cell connectivity (i.e. ->face_neighbors)
-             * of global (uncompressed) cells for this set of
-             * connections (faces). */
-            compute_cell_index(out->dimensions, i-1+direction, j-direction, ptr    , len);
-            compute_cell_index(out->dimensions, i            , j          , ptr + 1, len);
-
-            /* Tag the new faces */
-            f = startface;
-            for (; f < out->number_of_faces; ++f) {
-                out->face_tag[f] = tag[direction];
-            }
+/*-----------------------------------------------------------------
+  Add the number of faces, face nodes and new points that
+  process_vertical_row() produces for row j to count[0], count[1]
+  and count[2]. */
+static void
+count_vertical_row(int direction, int j,
+                   mrst_index_t *plist, mrst_index_t *work,
+                   const int dims[3],
+                   mrst_index_t count[4])
+{
+    int i;
+    mrst_index_t *cornerpts[4];
+    int d[3];
+    mrst_index_t *tmp;
+
+    d[0] = 2 * (dims[0] + 0);
+    d[1] = 2 * (dims[1] + 0);
+    d[2] = 2 * (dims[2] + 1);
+
+    for (i = 0; i < dims[0] + (1 - direction); ++i) {
+
+        igetvectors(d, 2*i + direction, 2*j + (1 - direction),
+                    plist, cornerpts);
+
+        if (direction == 1) {
+            tmp          = cornerpts[1];
+            cornerpts[1] = cornerpts[0];
+            cornerpts[0] = cornerpts[2];
+            cornerpts[2] = cornerpts[3];
+            cornerpts[3] = tmp;
         }
+
+        countconnections(2*dims[2] + 2, cornerpts, work, count);
     }
 }
 
 
 /*-----------------------------------------------------------------
-  For each horizontal face (i.e. k constant),
+  For each horizontal face (i.e. k constant) of the cell columns in
+  row j,
   -find point numbers for the corners and
   -cell neighbors.
 
   Also define map from logically Cartesian
-  cell index to local cell index 0, ..., #<active cells>.   Exclude
+  cell index to local cell index *cellno, *cellno+1, ....   Exclude
   cells that are have collapsed coordinates. (This includes cells with
   ACTNUM==0)
 
 */
 static void
-process_horizontal_faces(int **intersections,
-                         int *plist,
-                         struct processed_grid *out)
+process_horizontal_row(int j,
+                       mrst_index_t *plist,
+                       mrst_index_t *cellno,
+                       struct processed_grid *out)
 {
-    int i,j,k;
+    int i,k;
 
     int nx = out->dimensions[0];
     int ny = out->dimensions[1];
     int nz = out->dimensions[2];
 
-    int *cell  = out->local_cell_index;
-    int cellno = 0;
-    int *f, *n, *c[4];
-    int prevcell, thiscell;
-    int idx;
+    mrst_index_t *cell  = out->local_cell_index;
+    mrst_index_t *f, *n, *c[4];
+    mrst_index_t prevcell, thiscell;
+    mrst_index_t idx;
 
     /* dimensions of plist */
     int  d[3];
@@ -320,45 +288,53 @@ process_horizontal_faces(int **intersections,
     d[2] = 2+2*nz;
 
 
-    for(j=0; j<ny; ++j) {
-        for (i=0; i<nx; ++i) {
+    for (i=0; i<nx; ++i) {
 
+        f = out->face_nodes     + out->face_ptr[out->number_of_faces];
+        n = out->face_neighbors + 2*out->number_of_faces;
 
-            if (! checkmemory(nz, out, intersections)) {
-                fprintf(stderr,
-                        "Could not allocate enough space in "
-                        "process_horizontal_faces()\n");
-                exit(1);
-            }
 
+        /* Vectors of point numbers */
+        igetvectors(d, 2*i+1, 2*j+1, plist, c);
 
-            f = out->face_nodes     + out->face_ptr[out->number_of_faces];
-            n = out->face_neighbors + 2*out->number_of_faces;
+        prevcell = -1;
 
 
-            /* Vectors of point numbers */
-            igetvectors(d, 2*i+1, 2*j+1, plist, c);
+        for (k = 1; k<nz*2+1; ++k){
 
-            prevcell = -1;
+            /* Skip if space between face k and face k+1 is collapsed. */
+            /* Note that inactive cells (with ACTNUM==0) have all been  */
+            /* collapsed in finduniquepoints.                           */
+            if (c[0][k] == c[0][k+1] && c[1][k] == c[1][k+1] &&
+                c[2][k] == c[2][k+1] && c[3][k] == c[3][k+1]){
 
+                /* If the pinch is a cell: */
+                if (k%2){
+                    idx = linearindex(out->dimensions, i,j,(k-1)/2);
+                    cell[idx] = -1;
+                }
+            }
+            else{
 
-            for (k = 1; k<nz*2+1; ++k){
+                if (k%2){
+                    /* Add face */
+                    *f++ = c[0][k];
+                    *f++ = c[2][k];
+                    *f++ = c[3][k];
+                    *f++ = c[1][k];
 
-                /* Skip if space between face k and face k+1 is collapsed. */
-                /* Note that inactive cells (with ACTNUM==0) have all been  */
-                /* collapsed in finduniquepoints.                           */
-                if (c[0][k] == c[0][k+1] && c[1][k] == c[1][k+1] &&
-                    c[2][k] == c[2][k+1] && c[3][k] == c[3][k+1]){
+                    out->face_tag[  out->number_of_faces] = TOP;
+                    out->face_ptr[++out->number_of_faces] = f - out->face_nodes;
+
+                    thiscell = linearindex(out->dimensions, i,j,(k-1)/2);
+                    *n++ = prevcell;
+                    *n++ = prevcell = thiscell;
+
+                    cell[thiscell] = (*cellno)++;
 
-                    /* If the pinch is a cell: */
-                    if (k%2){
-                        idx = linearindex(out->dimensions, i,j,(k-1)/2);
-                        cell[idx] = -1;
-                    }
                 }
                 else{
-
-                    if (k%2){
+                    if (prevcell != -1){
                         /* Add face */
                         *f++ = c[0][k];
                         *f++ = c[2][k];
@@ -368,39 +344,231 @@ process_horizontal_faces(int **intersections,
                         out->face_tag[  out->number_of_faces] = TOP;
                         out->face_ptr[++out->number_of_faces] = f - out->face_nodes;
 
-                        thiscell = linearindex(out->dimensions, i,j,(k-1)/2);
                         *n++ = prevcell;
-                        *n++ = prevcell = thiscell;
+                        *n++ = prevcell = -1;
+                    }
+                }
+            }
+        }
+    }
+}
 
-                        cell[thiscell] = cellno++;
 
-                    }
-                    else{
-                        if (prevcell != -1){
-                            /* Add face */
-                            *f++ = c[0][k];
-                            *f++ = c[2][k];
-                            *f++ = c[3][k];
-                            *f++ = c[1][k];
-
-                            out->face_tag[  out->number_of_faces] = TOP;
-                            out->face_ptr[++out->number_of_faces] = f - out->face_nodes;
-
-                            *n++ = prevcell;
-                            *n++ = prevcell = -1;
-                        }
-                    }
+/*-----------------------------------------------------------------
+  Add the number of faces, face nodes and cells that
+  process_horizontal_row() produces for row j to count[0], count[1]
+  and count[3]. */
+static void
+count_horizontal_row(int j, mrst_index_t *plist, const int dims[3],
+                     mrst_index_t count[4])
+{
+    int i, k, prevcell;
+    mrst_index_t *c[4];
+    int d[3];
+
+    d[0] = 2*dims[0];
+    d[1] = 2*dims[1];
+    d[2] = 2+2*dims[2];
+
+    for (i = 0; i < dims[0]; ++i) {
+
+        igetvectors(d, 2*i+1, 2*j+1, plist, c);
+
+        prevcell = 0;
+        for (k = 1; k < dims[2]*2+1; ++k) {
+            if (! (c[0][k] == c[0][k+1] && c[1][k] == c[1][k+1] &&
+                   c[2][k] == c[2][k+1] && c[3][k] == c[3][k+1])) {
+
+                if (k%2) {
+                    count[0] += 1;
+                    count[3] += 1;
+                    prevcell  = 1;
+                }
+                else if (prevcell) {
+                    count[0] += 1;
+                    prevcell  = 0;
                 }
             }
         }
     }
-    out->number_of_cells = cellno;
+    count[1] = 4 * count[0];
+}
+
+
+/*-----------------------------------------------------------------
+  Faces are found row by row: first the constant-i faces of rows
+  0..ny-1, then the constant-j faces of rows 0..ny and last the
+  horizontal faces of rows 0..ny-1.  Row r of this sequence is
+  handled here, with count[0..3] the number of faces, face nodes,
+  new points and cells produced by rows 0..r-1.  ptr must have room
+  for the face pointers of the row. */
+static void
+process_row(int r, mrst_index_t *plist, mrst_index_t *work,
+            mrst_index_t *ptr, const mrst_index_t count[4],
+            mrst_index_t *intersections, struct processed_grid *out)
+{
+    struct processed_grid g;
+    int ny = out->dimensions[1];
+    mrst_index_t cellno;
+
+    /* View of the output positioned at the row's first face.  The
+     * face pointers are collected in ptr since the first one is shared
+     * with the preceding row. */
+    g                 = *out;
+    g.face_ptr        = ptr;
+    g.face_ptr[0]     = count[1];
+    g.face_neighbors  = out->face_neighbors + 2*count[0];
+    g.face_tag        = out->face_tag       +   count[0];
+    g.number_of_faces = 0;
+    g.number_of_nodes = out->number_of_nodes_on_pillars + count[2];
+
+    if (r < ny) {
+        process_vertical_row(0, r, intersections, plist, work, &g);
+    }
+    else if (r < 2*ny + 1) {
+        process_vertical_row(1, r - ny, intersections, plist, work, &g);
+    }
+    else {
+        cellno = count[3];
+        process_horizontal_row(r - 2*ny - 1, plist, &cellno, &g);
+        assert (cellno == count[4 + 3]);
+    }
+
+    assert (g.number_of_faces == count[4 + 0] - count[0]);
+    assert (g.number_of_nodes == out->number_of_nodes_on_pillars + count[4 + 2]);
+
+    memcpy(out->face_ptr + count[0] + 1, ptr + 1,
+           g.number_of_faces * sizeof *ptr);
+}
+
+
+/*-----------------------------------------------------------------
+  Counterpart of process_row() that only counts. */
+static void
+count_row(int r, mrst_index_t *plist, mrst_index_t *work,
+          const int dims[3], mrst_index_t count[4])
+{
+    int ny = dims[1];
+
+    if (r < ny) {
+        count_vertical_row(0, r, plist, work, dims, count);
+    }
+    else if (r < 2*ny + 1) {
+        count_vertical_row(1, r - ny, plist, work, dims, count);
+    }
+    else {
+        count_horizontal_row(r - 2*ny - 1, plist, dims, count);
+    }
+}
+
+
+/*-----------------------------------------------------------------
+  Find all faces and fault points in two passes over the rows of
+  pillars.  The first pass counts what each row produces, the second
+  writes it at its final position in arrays that are allocated once
+  with the exact sizes.  Rows are independent in both passes and are
+  processed in parallel when OpenMP is available; the numbering is
+  that of a serial sweep.  */
+static void
+process_faces(mrst_index_t *plist, mrst_index_t **intersections,
+              struct processed_grid *out)
+{
+    const int ny    = out->dimensions[1];
+    const int nrows = 3*ny + 1;
+    const int nw    = 2 * (2*out->dimensions[2] + 2);
+
+    int r, q;
+    mrst_index_t nf, nn, ni, maxfaces;
+    mrst_index_t *count;
+
+    /* count[4*r + (0..3)]: faces, face nodes, new points and cells of
+     * rows 0..r-1 after the prefix sum. */
+    count = calloc(4 * ((size_t) nrows + 1), sizeof *count);
+    if (count == NULL) {
+        fprintf(stderr, "Could not allocate space in process_faces()\n");
+        exit(1);
+    }
+
+#pragma omp parallel
+    {
+        int           k;
+        mrst_index_t *work = malloc(nw * sizeof *work);
+
+        if (work == NULL) {
+            fprintf(stderr, "Could not allocate work space\n");
+            exit(1);
+        }
+        for (k = 0; k < nw; k++) { work[k] = -1; }
+
+#pragma omp for schedule(dynamic)
+        for (r = 0; r < nrows; ++r) {
+            count_row(r, plist, work, out->dimensions, count + 4*(r + 1));
+        }
+
+        free(work);
+    }
+
+    maxfaces = 0;
+    for (r = 0; r < nrows; ++r) {
+        maxfaces = MAX(maxfaces, count[4*(r + 1)]);
+        for (q = 0; q < 4; ++q) {
+            count[4*(r + 1) + q] += count[4*r + q];
+        }
+    }
+
+    nf = count[4*nrows + 0];
+    nn = count[4*nrows + 1];
+    ni = count[4*nrows + 2];
+
+    out->m              = nf;
+    out->n              = nn;
+    out->face_nodes     = malloc(MAX(nn, 1)   * sizeof *out->face_nodes);
+    out->face_ptr       = malloc((nf + 1)     * sizeof *out->face_ptr);
+    out->face_neighbors = malloc(MAX(2*nf, 1) * sizeof *out->face_neighbors);
+    out->face_tag       = malloc(MAX(nf, 1)   * sizeof *out->face_tag);
+    *intersections      = malloc(MAX(4*ni, 1) * sizeof **intersections);
+
+    if ((out->face_nodes     == NULL) || (out->face_ptr == NULL) ||
+        (out->face_neighbors == NULL) || (out->face_tag == NULL) ||
+        (*intersections      == NULL)) {
+        fprintf(stderr, "Could not allocate space for %lu faces\n",
+                (unsigned long) nf);
+        exit(1);
+    }
+
+#pragma omp parallel
+    {
+        int           k;
+        mrst_index_t *work = malloc((nw + maxfaces + 1) * sizeof *work);
+        mrst_index_t *ptr  = work + nw;
+
+        if (work == NULL) {
+            fprintf(stderr, "Could not allocate work space\n");
+            exit(1);
+        }
+        for (k = 0; k < nw; k++) { work[k] = -1; }
+
+#pragma omp for schedule(dynamic)
+        for (r = 0; r < nrows; ++r) {
+            process_row(r, plist, work, ptr, count + 4*r,
+                        *intersections, out);
+        }
+
+        free(work);
+    }
+
+    out->face_ptr[0]     = 0;
+    out->number_of_faces = nf;
+    out->number_of_nodes = out->number_of_nodes_on_pillars + ni;
+    out->number_of_cells = count[4*nrows + 3];
+
+    free(count);
 }
 
 
 /*-----------------------------------------------------------------
   On input,
-  L points to 4 ints that indirectly refers to points in c.
+  L points to 4 indices that indirectly refers to points in c.
   c points to array of coordinates [x0,y0,z0,x1,y1,z1,...,xn,yn,zn].
   pt points to array of 3 doubles.
 
@@ -408,7 +576,8 @@ process_horizontal_faces(int **intersections,
   pt holds coordinates to intersection between lines given by point
   numbers L[0]-L[1] and L[2]-L[3].
 */
-static void approximate_intersection_pt(int *L, double *c, double *pt)
+static void approximate_intersection_pt(mrst_index_t *L, double *c,
+                                        double *pt)
 {
     double a;
     double z0, z1, z2, z3;
@@ -466,14 +635,14 @@ static void approximate_intersection_pt(int *L, double *c, double *pt)
   Compute x,y and z coordinates for points on each pillar.  Then,
   append x,y and z coordinates for extra points on faults.  */
 static void
-compute_intersection_coordinates(int                   *intersections,
+compute_intersection_coordinates(mrst_index_t          *intersections,
                                  struct processed_grid *out)
 {
-    int n  = out->number_of_nodes;
-    int np = out->number_of_nodes_on_pillars;
-    int    k;
-    double *pt;
-    int    *itsct = intersections;
+    mrst_index_t n  = out->number_of_nodes;
+    mrst_index_t np = out->number_of_nodes_on_pillars;
+    mrst_index_t  k;
+    double       *pt;
+    mrst_index_t *itsct = intersections;
     /* Make sure the space allocated for nodes match the number of
      * node. */
     void *p = realloc (out->node_coordinates, 3*n*sizeof(double));
@@ -502,7 +671,7 @@ static int*
 copy_and_permute_actnum(int nx, int ny, int nz, const int *in, int *out)
 /* ------------------------------------------------------------------ */
 {
-    int i,j,k;
+    mrst_index_t i,j,k;
     int *ptr = out;
 
     /* Permute actnum such that values of each vertical stack of cells
@@ -523,7 +692,7 @@ copy_and_permute_actnum(int nx, int ny, int nz, const int *in, int *out)
     }
     else {
         /* No explicit ACTNUM.  Assume all cells active. */
-        for (i = 0; i < nx * ny * nz; i++) {
+        for (i = 0; i < nx * ny * (mrst_index_t) nz; i++) {
             out[ i ] = 1;
         }
     }
@@ -537,7 +706,7 @@ copy_and_permute_zcorn(int nx, int ny, int nz, const double *in,
                        double sign, double *out)
 /* ------------------------------------------------------------------ */
 {
-    int i,j,k;
+    mrst_index_t i,j,k;
     double *ptr = out;
     /* Permute zcorn such that values of each vertical stack of cells
      * are adjacent in memory, i.e.,
@@ -572,10 +741,10 @@ get_zcorn_sign(int nx, int ny, int nz, const int *actnum,
        3) if (1) and (2) fails, return -1.0, and set *error = 1.
 
     */
-    int    sign;
-    int    i, j, k;
-    int    c1, c2;
-    double z1, z2;
+    int          sign;
+    mrst_index_t i, j, k;
+    mrst_index_t c1, c2;
+    double       z1, z2;
 
     for (sign = 1; sign>-2; sign = sign - 2)
     {
@@ -731,7 +900,7 @@ static void
 reverse_face_nodes(struct processed_grid *out)
 /* ---------------------------------------------------------------------- */
 {
-    int f, t, *i, *j;
+    mrst_index_t f, t, *i, *j;
 
     for (f = 0; f < out->number_of_faces; f++) {
         i = out->face_nodes + (out->face_ptr[f + 0] + 0);
@@ -762,41 +931,38 @@ void process_grdecl(const struct grdecl   *in,
 
     size_t i;
     int    sign, error, left_handed;
-    int    cellnum;
+    mrst_index_t cellnum;
 
-    int    *actnum, *iptr;
-    int    *global_cell_index;
+    int          *actnum;
+    mrst_index_t *iptr;
+    mrst_index_t *global_cell_index;
 
     double *zcorn;
 
-    const size_t BIGNUM = 64;
     const int    nx = in->dims[0];
     const int    ny = in->dims[1];
     const int    nz = in->dims[2];
     const size_t nc = ((size_t) nx) * ((size_t) ny) * ((size_t) nz);
 
     /* internal work arrays */
-    int    *work;
-    int    *plist;
-    int    *intersections;
+    mrst_index_t *plist;
+    mrst_index_t *intersections;
 
 
 
 
     /* -----------------------------------------------------------------*/
     /* Initialize output structure:
-       1) allocate space for grid topology (which may need to be
-          increased)
-       2) set Cartesian imensions
+       1) set Cartesian imensions
+       2) grid topology is allocated once its size is known
     */
-    out->m                = (int) (BIGNUM / 3);
-    out->n                = (int) BIGNUM;
+    out->m                = 0;
+    out->n                = 0;
 
-    out->face_neighbors   = malloc( BIGNUM      * sizeof *out->face_neighbors);
-    out->face_nodes       = malloc( out->n      * sizeof *out->face_nodes);
-    out->face_ptr         = malloc((out->m + 1) * sizeof *out->face_ptr);
-    out->face_tag         = malloc( out->m      * sizeof *out->face_tag);
-    out->face_ptr[0]      = 0;
+    out->face_neighbors   = NULL;
+    out->face_nodes       = NULL;
+    out->face_ptr         = NULL;
+    out->face_tag         = NULL;
 
     out->dimensions[0]    = in->dims[0];
     out->dimensions[1]    = in->dims[1];
@@ -835,8 +1001,8 @@ void process_grdecl(const struct grdecl   *in,
     g.coord   = in->coord;
 
 
-    /* allocate space for cornerpoint numbers plus INT_MIN (INT_MAX)
-     * padding */
+    /* allocate space for cornerpoint numbers plus MRST_INDEX_MIN
+     * (MRST_INDEX_MAX) padding */
     plist = malloc(8 * (nc + ((size_t)nx)*((size_t)ny)) * sizeof *plist);
 
     finduniquepoints(&g, plist, tolerance, out);
@@ -857,21 +1023,11 @@ void process_grdecl(const struct grdecl   *in,
     /* -----------------------------------------------------------------*/
     /* Find face topology and face-to-cell connections */
 
-    /* internal */
-    work = malloc(2 * ((size_t) (2*nz + 2)) * sizeof *work);
-    for(i = 0; i < ((size_t)4) * (nz + 1); ++i) { work[i] = -1; }
-
-    /* internal array to store intersections */
-    intersections = malloc(BIGNUM* sizeof(*intersections));
-
-
-
-    process_vertical_faces   (0, &intersections, plist, work, out);
-    process_vertical_faces   (1, &intersections, plist, work, out);
-    process_horizontal_faces (   &intersections, plist,       out);
+    /* Count, allocate and fill: constant-i, constant-j and
+     * horizontal faces plus the array of intersections */
+    process_faces(plist, &intersections, out);
 
     free (plist);
-    free (work);
 
     /* -----------------------------------------------------------------*/
     /* (re)allocate space for and compute coordinates of nodes that
@@ -890,7 +1046,7 @@ void process_grdecl(const struct grdecl   *in,
     cellnum = 0;
     for (i = 0; i < nc; ++i) {
         if (out->local_cell_index[i] != -1) {
-            global_cell_index[cellnum] = (int) i;
+            global_cell_index[cellnum] = (mrst_index_t) i;
             out->local_cell_index[i]   = cellnum;
             cellnum++;
         }
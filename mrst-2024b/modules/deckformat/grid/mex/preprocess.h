@@ -46,6 +46,28 @@
  * create_grid_cornerpoint().
  */
 
+#include <limits.h>
+#include <stddef.h>
+
+#ifndef MRST_INDEX_T_DEFINED
+#define MRST_INDEX_T_DEFINED
+/**
+ * Type of cell, face and node numbers, of counts and of offsets into
+ * index arrays.  Plain int by default, which halves the size of the
+ * topology arrays.  Define MRST_INDEX_64 when building to process
+ * models whose number of face nodes (about 24 per cell) exceeds INT_MAX.
+ * Must match the definition in mrst_api's grid.h.
+ */
+#ifdef MRST_INDEX_64
+typedef ptrdiff_t mrst_index_t;
+#define MRST_INDEX_MAX ((mrst_index_t) (((size_t) -1) >> 1))
+#else
+typedef int       mrst_index_t;
+#define MRST_INDEX_MAX INT_MAX
+#endif
+#define MRST_INDEX_MIN (-MRST_INDEX_MAX - 1)
+#endif /* MRST_INDEX_T_DEFINED */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -75,34 +97,40 @@ extern "C" {
      * a geological model in corner-point format.
      */
     struct processed_grid {
-        int m; /**< Upper bound on "number_of_faces".  For internal use in
-                    function process_grid()'s memory management. */
-        int n; /**< Upper bound on "number_of_nodes".  For internal use in
-                    function process_grid()'s memory management. */
+        mrst_index_t m; /**< Upper bound on "number_of_faces".  For internal
+                             use in function process_grid()'s memory
+                             management. */
+        mrst_index_t n; /**< Upper bound on "number_of_nodes".  For internal
+                             use in function process_grid()'s memory
+                             management. */
 
         int    dimensions[3];     /**< Cartesian box dimensions. */
 
-        int    number_of_faces;   /**< Total number of unique grid faces
-                                       (i.e., connections). */
-        int    *face_nodes;       /**< Node (vertex) numbers of each face,
-                                       stored sequentially. */
-        int    *face_ptr;         /**< Start position for each face's
-                                       `face_nodes'. */
-        int    *face_neighbors;   /**< Global cell numbers.  Two elements per
-                                       face, stored sequentially. */
+        mrst_index_t  number_of_faces;  /**< Total number of unique grid
+                                             faces (i.e., connections). */
+        mrst_index_t *face_nodes;       /**< Node (vertex) numbers of each
+                                             face, stored sequentially. */
+        mrst_index_t *face_ptr;         /**< Start position for each face's
+                                             `face_nodes'. */
+        mrst_index_t *face_neighbors;   /**< Global cell numbers.  Two
+                                             elements per face, stored
+                                             sequentially. */
         enum face_tag *face_tag;  /**< Classification of grid's individual
                                        connections (faces). */
 
-        int    number_of_nodes;   /**< Number of unique grid vertices. */
-        int    number_of_nodes_on_pillars; /**< Total number of unique cell
-                                                vertices that lie on pillars. */
+        mrst_index_t  number_of_nodes;  /**< Number of unique grid
+                                             vertices. */
+        mrst_index_t  number_of_nodes_on_pillars; /**< Total number of unique
+                                                       cell vertices that lie
+                                                       on pillars. */
         double *node_coordinates; /**< Vertex coordinates.  Three doubles
                                        (\f$x\f$, \f$y\f$, \f$z\f$) per vertex,
                                        stored sequentially. */
 
-        int    number_of_cells;   /**< Number of active grid cells. */
-        int    *local_cell_index; /**< Deceptively named local-to-global cell
-                                       index mapping. */
+        mrst_index_t  number_of_cells;  /**< Number of active grid cells. */
+        mrst_index_t *local_cell_index; /**< Deceptively named
+                                             local-to-global cell index
+                                             mapping. */
     };
 
 
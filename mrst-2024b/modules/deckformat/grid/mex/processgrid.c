@@ -47,6 +47,18 @@
 #include "mxgrdecl.h"
 
 
+/* Class of the index arrays of the grid structure.  Doubles represent
+ * all indices exactly in 64-bit builds, and are what mprocessGRDECL
+ * returns in any case. */
+#ifdef MRST_INDEX_64
+typedef double mx_index_t;
+#define mxINDEX_CLASS mxDOUBLE_CLASS
+#else
+typedef int    mx_index_t;
+#define mxINDEX_CLASS mxINT32_CLASS
+#endif
+
+
 /* ---------------------------------------------------------------------- */
 static mxArray *
 allocate_nodes(size_t nnodes)
@@ -113,9 +125,9 @@ allocate_faces(size_t nf, size_t nfacenodes)
     faces     = mxCreateStructMatrix(1, 1, nflds, fields);
 
     num       = mxCreateDoubleScalar (nf);
-    neighbors = mxCreateNumericMatrix(nf        , 2, mxINT32_CLASS, mxREAL);
-    nodePos   = mxCreateNumericMatrix(nf + 1    , 1, mxINT32_CLASS, mxREAL);
-    nodes     = mxCreateNumericMatrix(nfacenodes, 1, mxINT32_CLASS, mxREAL);
+    neighbors = mxCreateNumericMatrix(nf        , 2, mxINDEX_CLASS, mxREAL);
+    nodePos   = mxCreateNumericMatrix(nf + 1    , 1, mxINDEX_CLASS, mxREAL);
+    nodes     = mxCreateNumericMatrix(nfacenodes, 1, mxINDEX_CLASS, mxREAL);
     tag       = mxCreateNumericMatrix(nf        , 1, mxINT32_CLASS, mxREAL);
 
     if ((faces != NULL) && (num != NULL) && (neighbors != NULL) &&
@@ -147,7 +159,8 @@ fill_faces(mxArray *faces, struct processed_grid *grid)
 {
     size_t i, f, nf, nfn;
 
-    int *pi;
+    int        *pt;
+    mx_index_t *pi;
 
     nf = grid->number_of_faces;
 
@@ -156,31 +169,35 @@ fill_faces(mxArray *faces, struct processed_grid *grid)
     for (i = 0; i < 2; i++) {
         for (f = 0; f < nf; f++) {
             /* Add one for one-based indexing in M */
-            *pi++ = grid->face_neighbors[2*f + i] + 1;
+            *pi++ = (mx_index_t) (grid->face_neighbors[2*f + i] + 1);
         }
     }
 
     /* Fill faces.nodePos */
     pi = mxGetData(mxGetField(faces, 0, "nodePos"));
-    for (i = 0; i <= nf; i++) { pi[i] = grid->face_ptr[i] + 1; }
+    for (i = 0; i <= nf; i++) {
+        pi[i] = (mx_index_t) (grid->face_ptr[i] + 1);
+    }
 
     /* Fill faces.nodes */
     pi  = mxGetData(mxGetField(faces, 0, "nodes"));
     nfn = grid->face_ptr[nf];  /* Total number of face nodes */
-    for (i = 0; i < nfn; i++) { pi[i] = grid->face_nodes[i] + 1; }
+    for (i = 0; i < nfn; i++) {
+        pi[i] = (mx_index_t) (grid->face_nodes[i] + 1);
+    }
 
     /* Fill faces.tag */
-    pi = mxGetData(mxGetField(faces, 0, "tag"));
-    for (f = 0; f < nf; f++) { pi[f] = grid->face_tag[f] + 1; }
+    pt = mxGetData(mxGetField(faces, 0, "tag"));
+    for (f = 0; f < nf; f++) { pt[f] = grid->face_tag[f] + 1; }
 }
 
 
 /* ---------------------------------------------------------------------- */
 static size_t
-count_halffaces(size_t nf, const int *neighbors)
+count_halffaces(size_t nf, const mrst_index_t *neighbors)
 /* ---------------------------------------------------------------------- */
 {
-    int    c1, c2;
+    mrst_index_t c1, c2;
     size_t nhf, f;
 
     for (f = nhf = 0; f < nf; f++) {
@@ -210,9 +227,9 @@ allocate_cells(size_t nc, size_t ncf)
     cells    = mxCreateStructMatrix(1, 1, nflds, fields);
 
     num      = mxCreateDoubleScalar (nc);
-    facePos  = mxCreateNumericMatrix(nc + 1, 1, mxINT32_CLASS, mxREAL);
-    faces    = mxCreateNumericMatrix(ncf   , 2, mxINT32_CLASS, mxREAL);
-    indexMap = mxCreateNumericMatrix(nc    , 1, mxINT32_CLASS, mxREAL);
+    facePos  = mxCreateNumericMatrix(nc + 1, 1, mxINDEX_CLASS, mxREAL);
+    faces    = mxCreateNumericMatrix(ncf   , 2, mxINDEX_CLASS, mxREAL);
+    indexMap = mxCreateNumericMatrix(nc    , 1, mxINDEX_CLASS, mxREAL);
 
     if ((cells != NULL) && (num != NULL) && (facePos != NULL) &&
         (faces != NULL) && (indexMap != NULL)) {
@@ -241,36 +258,38 @@ fill_cells(mxArray *cells, struct processed_grid *grid)
 {
     size_t c, nc, f, nf, i;
 
-    int c1, c2, cf_tag, nhf;
-    int *pi1, *pi2;
+    int          cf_tag;
+    mrst_index_t c1, c2, nhf, *pos;
+    mx_index_t  *pi1, *pi2;
 
     nc = grid->number_of_cells;
     nf = grid->number_of_faces;
 
     /* Simultaneously fill cells.facePos and cells.faces by transposing the
-     * neighbours mapping. */
-    pi1 = mxGetData(mxGetField(cells, 0, "facePos"));
+     * neighbours mapping.  Positions are accumulated in 'pos' since the
+     * class of cells.facePos need not be an integer type. */
+    pos = mxMalloc((nc + 1) * sizeof *pos);
     pi2 = mxGetData(mxGetField(cells, 0, "faces"  ));
-    for (i = 0; i < nc + 1; i++) { pi1[i] = 0; }
+    for (i = 0; i < nc + 1; i++) { pos[i] = 0; }
 
     /* 1) Count connections (i.e., faces per cell). */
     for (f = 0; f < nf; f++) {
         c1 = grid->face_neighbors[2*f + 0];
         c2 = grid->face_neighbors[2*f + 1];
 
-        if (c1 >= 0) { pi1[c1 + 1] += 1; }
-        if (c2 >= 0) { pi1[c2 + 1] += 1; }
+        if (c1 >= 0) { pos[c1 + 1] += 1; }
+        if (c2 >= 0) { pos[c2 + 1] += 1; }
     }
 
     /* 2) Define start pointers (really, position *end* pointers at start). */
     for (c = 1; c <= nc; c++) {
-        pi1[0] += pi1[c];
-        pi1[c]  = pi1[0] - pi1[c];
+        pos[0] += pos[c];
+        pos[c]  = pos[0] - pos[c];
     }
 
     /* 3) Fill connection structure whilst advancing end pointers. */
-    nhf    = pi1[0];
-    pi1[0] = 0;
+    nhf    = pos[0];
+    pos[0] = 0;
 
     mxAssert (((size_t) nhf) == mxGetM(mxGetField(cells, 0, "faces")),
               "Number of half faces (SIZE(cells.faces,1)) incorrectly "
@@ -282,26 +301,31 @@ fill_cells(mxArray *cells, struct processed_grid *grid)
         c2     = grid->face_neighbors[2*f + 1];
 
         if (c1 >= 0) {
-            pi2[ pi1[ c1 + 1 ] + 0*nhf ] = f + 1;
-            pi2[ pi1[ c1 + 1 ] + 1*nhf ] = cf_tag + 1;  /* out */
+            pi2[ pos[ c1 + 1 ] + 0*nhf ] = (mx_index_t) (f + 1);
+            pi2[ pos[ c1 + 1 ] + 1*nhf ] = cf_tag + 1;  /* out */
 
-            pi1[ c1 + 1 ] += 1;
+            pos[ c1 + 1 ] += 1;
         }
         if (c2 >= 0) {
-            pi2[ pi1[ c2 + 1 ] + 0*nhf ] = f + 1;
-            pi2[ pi1[ c2 + 1 ] + 1*nhf ] = cf_tag + 0;  /* in */
+            pi2[ pos[ c2 + 1 ] + 0*nhf ] = (mx_index_t) (f + 1);
+            pi2[ pos[ c2 + 1 ] + 1*nhf ] = cf_tag + 0;  /* in */
 
-            pi1[ c2 + 1 ] += 1;
+            pos[ c2 + 1 ] += 1;
         }
     }
 
     /* Finally, adjust pointer array for one-based indexing in M. */
-    for (i = 0; i < nc + 1; i++) { pi1[i] += 1; }
+    pi1 = mxGetData(mxGetField(cells, 0, "facePos"));
+    for (i = 0; i < nc + 1; i++) { pi1[i] = (mx_index_t) (pos[i] + 1); }
+
+    mxFree(pos);
 
     /* Fill cells.indexMap.  Note that despite the name, 'local_cell_index'
      * really *is* the (zero-based) indexMap of the 'processed_grid'. */
     pi1 = mxGetData(mxGetField(cells, 0, "indexMap"));
-    for (c = 0; c < nc; c++) { pi1[c] = grid->local_cell_index[c] + 1; }
+    for (c = 0; c < nc; c++) {
+        pi1[c] = (mx_index_t) (grid->local_cell_index[c] + 1);
+    }
 }
 
 
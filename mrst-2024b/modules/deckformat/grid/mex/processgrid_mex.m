@@ -48,7 +48,7 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
 
    v = version;v = v([1,3]);
 
-   CFLAGS = {'CFLAGS="$CFLAGS', '-O3', '-Wall', '-Wextra', '-ansi', ...
+   CFLAGS = {'CFLAGS="$CFLAGS', '-O3', '-fopenmp', '-Wall', '-Wextra', '-ansi', ...
              '-pedantic', '-Wformat-nonliteral',  '-Wcast-align', ...
              '-Wpointer-arith', '-Wbad-function-cast', ...
              '-Wmissing-prototypes', '-Wstrict-prototypes', ...
@@ -57,6 +57,9 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
              '-Wconversion', '-Wwrite-strings', '-Wno-conversion', ...
              '-Wchar-subscripts', '-Wredundant-decls"'};
 
+   % Rows of pillars are processed in parallel if OpenMP is available.
+   LDFLAGS = {'LDFLAGS="$LDFLAGS', '-fopenmp"'};
+
    SRC = {'processgrid.c', 'preprocess.c', 'uniquepoints.c', ...
           'facetopology.c', 'mxgrdecl.c'};
 
@@ -65,7 +68,13 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
    OPTS = {'-output', 'processgrid_mex', ...
            '-largeArrayDims', ['-DMATLABVERSION=', v], '-O'};
 
-   buildmex(CFLAGS{:}, INCLUDE{:}, OPTS{:}, SRC{:})
+   % 64-bit cell/face/node numbering for very large models.  Must agree
+   % between processgrid_mex and the libgeometry gateways.
+   if ~isempty(getenv('MRST_INDEX_64')),
+      OPTS = [OPTS, { '-DMRST_INDEX_64' }];
+   end
+
+   buildmex(CFLAGS{:}, LDFLAGS{:}, INCLUDE{:}, OPTS{:}, SRC{:})
 
    % Call MEX edition.
    [varargout{1:nargout}] = processgrid_mex(varargin{:});
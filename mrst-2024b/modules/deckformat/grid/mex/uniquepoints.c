@@ -48,16 +48,108 @@
 #define MAX(i,j) (((i) > (j)) ? (i) : (j))
 
 /*-----------------------------------------------------------------
-  Compare function passed to qsortx  */
-static int compare(const void *a, const void *b)
+  Sort n doubles in increasing order.  Introsort: median-of-three
+  quicksort that switches to heapsort if the recursion gets too deep
+  and leaves short ranges to a final insertion sort.  Typed to avoid
+  qsort's comparator callback in the innermost loop.  */
+#define SORT_CUTOFF 16
+
+static void insertion_sort(double *v, size_t n)
+{
+    size_t i, j;
+    double x;
+
+    for (i = 1; i < n; ++i) {
+        x = v[i];
+        for (j = i; (j > 0) && (x < v[j-1]); --j) {
+            v[j] = v[j-1];
+        }
+        v[j] = x;
+    }
+}
+
+static void sift_down(double *v, size_t root, size_t n)
+{
+    size_t child;
+    double x = v[root];
+
+    while ((child = 2*root + 1) < n) {
+        if ((child + 1 < n) && (v[child] < v[child + 1])) {
+            child++;
+        }
+        if (!(x < v[child])) {
+            break;
+        }
+        v[root] = v[child];
+        root    = child;
+    }
+    v[root] = x;
+}
+
+static void heap_sort(double *v, size_t n)
+{
+    size_t i;
+    double x;
+
+    for (i = n / 2; i > 0; --i) {
+        sift_down(v, i - 1, n);
+    }
+    for (i = n; i > 1; --i) {
+        x = v[0];  v[0] = v[i-1];  v[i-1] = x;
+        sift_down(v, 0, i - 1);
+    }
+}
+
+static void introsort_loop(double *v, size_t n, int depth)
+{
+    size_t i, j;
+    double pivot, x;
+
+    while (n > SORT_CUTOFF) {
+        if (depth-- == 0) {
+            heap_sort(v, n);
+            return;
+        }
+
+        /* Median of three to v[0], sentinels at both ends. */
+        i = n / 2;
+        if (v[i]   < v[0]) { x = v[i];   v[i]   = v[0]; v[0] = x; }
+        if (v[n-1] < v[i]) { x = v[n-1]; v[n-1] = v[i]; v[i] = x;
+            if (v[i] < v[0]) { x = v[i]; v[i] = v[0]; v[0] = x; } }
+        x = v[i];  v[i] = v[1];  v[1] = x;
+        pivot = v[1];
+
+        /* Hoare partition of v[1..n-1] */
+        i = 1;  j = n - 1;
+        for (;;) {
+            do { ++i; } while (v[i] < pivot);
+            do { --j; } while (pivot < v[j]);
+            if (j < i) { break; }
+            x = v[i];  v[i] = v[j];  v[j] = x;
+        }
+        v[1] = v[j];  v[j] = pivot;
+
+        /* Recurse into smaller part, loop on larger. */
+        if (j < n - j - 1) {
+            introsort_loop(v, j, depth);
+            v += j + 1;  n -= j + 1;
+        } else {
+            introsort_loop(v + j + 1, n - j - 1, depth);
+            n = j;
+        }
+    }
+}
+
+static void sort_doubles(double *v, size_t n)
 {
-    const double a0 = *(const double*) a;
-    const double b0 = *(const double*) b;
+    int    depth = 0;
+    size_t m;
 
-    /*                { -1, a < b
-     * compare(a,b) = {  0, a = b
-     *                {  1, a > b */
-    return (a0 > b0) - (a0 < b0);
+    for (m = n; m > 1; m >>= 1) {
+        depth += 2;
+    }
+    introsort_loop(v, n, depth);
+    insertion_sort(v, n);
 }
 
 /*-----------------------------------------------------------------
@@ -74,7 +166,7 @@ static int createSortedList(double *list, int n, int m,
         }
     }
 
-    qsort(list, ptr-list, sizeof(double), compare);
+    sort_doubles(list, ptr-list);
     return ptr-list;
 }
 
@@ -121,18 +213,18 @@ static int uniquify(int n, double *list, double tolerance)
 
 /*-----------------------------------------------------------------
   Along single pillar: */
-static int assignPointNumbers(int    begin,
-                              int    end,
+static int assignPointNumbers(mrst_index_t  begin,
+                              int           len,
                               const double *zlist,
-                              int    n,
+                              int           n,
                               const double *zcorn,
                               const int    *actnum,
-                              int    *plist,
-                              double tolerance)
+                              mrst_index_t *plist,
+                              double        tolerance)
 {
     /* n     - number of cells */
-    /* zlist - list of len unique z-values */
-    /* start - number of unique z-values processed before. */
+    /* zlist - list of len unique z-values on this pillar */
+    /* begin - number of unique z-values on preceding pillars. */
 
     int i, k;
     /* All points should now be within tolerance of a listed point. */
@@ -140,10 +232,10 @@ static int assignPointNumbers(int    begin,
 
     const double *z = zcorn;
     const int    *a = actnum;
-    int    *p = plist;
+    mrst_index_t *p = plist;
 
-    k = begin;
-    *p++ = INT_MIN; /* Padding to ease processing of faults */
+    k = 0;
+    *p++ = MRST_INDEX_MIN; /* Padding to ease processing of faults */
     for (i=0; i<n; ++i){
 
         /* Skip inactive cells */
@@ -155,20 +247,18 @@ static int assignPointNumbers(int    begin,
         }
 
         /* Find next k such that zlist[k] < z[i] < zlist[k+1] */
-        while ((k < end) && (zlist[k] + tolerance < z[i])){
+        while ((k < len) && (zlist[k] + tolerance < z[i])){
             k++;
         }
 
         /* assert (k < len && z[i] - zlist[k] <= tolerance) */
-        if ((k == end) || ( zlist[k] + tolerance < z[i])){
-            fprintf(stderr, "Cannot associate  zcorn values with given list\n");
-            fprintf(stderr, "of z-coordinates to given tolerance\n");
+        if ((k == len) || ( zlist[k] + tolerance < z[i])){
             return 0;
         }
 
-        *p++ = k;
+        *p++ = begin + k;
     }
-    *p++ = INT_MAX;/* Padding to ease processing of faults */
+    *p++ = MRST_INDEX_MAX;/* Padding to ease processing of faults */
 
 
     return 1;
@@ -263,10 +353,15 @@ static void interpolate_pillar(const double *coord, double *pt)
 /*-----------------------------------------------------------------
   Assign point numbers p such that "zlist(p)==zcorn".  Assume that
   coordinate number is arranged in a sequence such that the natural
-  index is (k,i,j) */
+  index is (k,i,j).
+
+  Pillars are independent: each is sorted and uniquified in its own
+  fixed-size slot of zlist, rows of pillars in parallel when OpenMP
+  is available.  A prefix sum over the pillar lengths then gives the
+  serial point numbering.  */
 int finduniquepoints(const struct grdecl *g,
                      /* return values: */
-                     int           *plist, /* list of point numbers on
+                     mrst_index_t  *plist, /* list of point numbers on
                                             * each pillar*/
                      double tolerance,
                      struct processed_grid *out)
@@ -276,104 +371,131 @@ int finduniquepoints(const struct grdecl *g,
     const int nx = out->dimensions[0];
     const int ny = out->dimensions[1];
     const int nz = out->dimensions[2];
-    const int nc = g->dims[0]*g->dims[1]*g->dims[2];
-
-
-    /* zlist may need extra space temporarily due to simple boundary
-     * treatement  */
-    int            npillarpoints = 8*(nx+1)*(ny+1)*nz;
-    int            npillars      = (nx+1)*(ny+1);
-
-    double *zlist = malloc(npillarpoints*sizeof *zlist);
-    int     *zptr = malloc((npillars+1)*sizeof *zptr);
-
 
 
+    /* Each pillar borders at most four columns of 2*nz zcorn
+     * values, so slot pix of zlist starts at pix*pslot. */
+    size_t         pslot    = 8 * (size_t) nz;
+    size_t         npillars = ((size_t) nx+1) * (ny+1);
 
-    int     i,j,k;
+    double       *zlist = malloc(npillars*pslot*sizeof *zlist);
+    mrst_index_t *zptr  = malloc((npillars+1)*sizeof *zptr);
 
+    int     i,j;
     int     d1[3];
-    int     len    = 0;
-    double  *zout  = zlist;
-    int     pos    = 0;
-    double *pt;
-    const double *z[4];
-    const int *a[4];
-    int *p;
-    int pix, cix;
-    int zix;
-
-    const double *coord = g->coord;
+    int     nfail  = 0;
+    size_t  pix;
 
     d1[0] = 2*g->dims[0];
     d1[1] = 2*g->dims[1];
     d1[2] = 2*g->dims[2];
 
-    out->node_coordinates = malloc (3*8*nc*sizeof(*out->node_coordinates));
-
-    zptr[pos++] = zout - zlist;
-
-    pt    = out->node_coordinates;
+    if ((zlist == NULL) || (zptr == NULL)) {
+        fprintf(stderr, "Could not allocate space for pillar points\n");
+        exit(1);
+    }
 
     /* Loop over pillars, find unique points on each pillar */
+#pragma omp parallel for schedule(dynamic) private(i, pix)
     for (j=0; j < g->dims[1]+1; ++j){
+        const double *z[4];
+        const int    *a[4];
+        int           len;
+
         for (i=0; i < g->dims[0]+1; ++i){
+            pix = i + (g->dims[0]+1)*(size_t) j;
 
             /* Get positioned pointers for actnum and zcorn data */
             igetvectors(g->dims,   i,   j, g->actnum, a);
             dgetvectors(d1,      2*i, 2*j, g->zcorn,  z);
 
-            len = createSortedList(     zout, d1[2], 4, z, a);
-            len = uniquify        (len, zout, tolerance);
+            len = createSortedList(     zlist + pix*pslot, d1[2], 4, z, a);
+            len = uniquify        (len, zlist + pix*pslot, tolerance);
 
-            /* Assign unique points */
-            for (k=0; k<len; ++k){
-                pt[2] = zout[k];
-                interpolate_pillar(coord, pt);
-                pt += 3;
-            }
+            zptr[pix + 1] = len;
+        }
+    }
+
+    /* Sparse table of unique zcorn values */
+    zptr[0] = 0;
+    for (pix = 0; pix < npillars; ++pix) {
+        zptr[pix + 1] += zptr[pix];
+    }
+    out->number_of_nodes_on_pillars = zptr[npillars];
+    out->number_of_nodes            = zptr[npillars];
+
+    out->node_coordinates =
+        malloc(MAX(3 * (size_t) zptr[npillars], 1) *
+               sizeof *out->node_coordinates);
+    if (out->node_coordinates == NULL) {
+        fprintf(stderr, "Could not allocate space for %lu nodes\n",
+                (unsigned long) zptr[npillars]);
+        exit(1);
+    }
 
-            /* Increment pointer to sparse table of unique zcorn
-             * values */
-            zout        = zout + len;
-            zptr[pos++] = zout - zlist;
+    /* Assign unique points */
+#pragma omp parallel for schedule(dynamic) private(i, pix)
+    for (j=0; j < g->dims[1]+1; ++j){
+        const double *zl;
+        double       *pt;
+        mrst_index_t  k;
+
+        for (i=0; i < g->dims[0]+1; ++i){
+            pix = i + (g->dims[0]+1)*(size_t) j;
+            zl  = zlist + pix*pslot;
+            pt  = out->node_coordinates + 3*zptr[pix];
 
-            coord += 6;
+            for (k = 0; k < zptr[pix + 1] - zptr[pix]; ++k){
+                pt[2] = zl[k];
+                interpolate_pillar(g->coord + 6*pix, pt);
+                pt += 3;
+            }
         }
     }
-    out->number_of_nodes_on_pillars = zptr[pos-1];
-    out->number_of_nodes            = zptr[pos-1];
 
     /* Loop over all vertical sets of zcorn values, assign point
      * numbers */
-    p = plist;
+#pragma omp parallel for schedule(dynamic) private(i, pix) reduction(+:nfail)
     for (j=0; j < 2*g->dims[1]; ++j){
+        size_t        cix, zix;
+        mrst_index_t *p;
+
         for (i=0; i < 2*g->dims[0]; ++i){
 
             /* pillar index */
-            pix = (i+1)/2 + (g->dims[0]+1)*((j+1)/2);
+            pix = (i+1)/2 + (g->dims[0]+1)*(size_t) ((j+1)/2);
 
             /* cell column position */
-            cix = g->dims[2]*((i/2) + (j/2)*g->dims[0]);
+            cix = g->dims[2]*((i/2) + (j/2)*(size_t) g->dims[0]);
 
             /* zcorn column position */
-            zix = 2*g->dims[2]*(i+2*g->dims[0]*j);
+            zix = 2*g->dims[2]*(i+2*g->dims[0]*(size_t) j);
+
+            /* point number list position */
+            p = plist + (2 + 2*(size_t) g->dims[2]) *
+                (i + 2*g->dims[0]*(size_t) j);
 
-            if (!assignPointNumbers(zptr[pix], zptr[pix+1], zlist,
+            if (!assignPointNumbers(zptr[pix],
+                                    (int) (zptr[pix+1] - zptr[pix]),
+                                    zlist + pix*pslot,
                                     2*g->dims[2],
                                     g->zcorn  + zix, g->actnum + cix,
                                     p, tolerance)){
-                fprintf(stderr, "Something went wrong in assignPointNumbers");
-                return 0;
+                nfail++;
             }
-
-            p += 2 + 2*g->dims[2];
         }
     }
 
     free(zptr);
     free(zlist);
 
+    if (nfail > 0) {
+        fprintf(stderr, "Cannot associate  zcorn values with given list\n");
+        fprintf(stderr, "of z-coordinates to given tolerance\n");
+        fprintf(stderr, "Something went wrong in assignPointNumbers");
+        return 0;
+    }
+
     return 1;
 }
 
@@ -36,7 +36,7 @@
 #define OPM_UNIQUEPOINTS_HEADER
 
 int finduniquepoints(const struct grdecl *g,  /* input */
-                     int                 *p,  /* for each z0 in zcorn, z0 = z[p0] */
+                     mrst_index_t        *p,  /* for each z0 in zcorn, z0 = z[p0] */
                      double               t,  /* tolerance*/
                      struct processed_grid *out);
 
@@ -0,0 +1,135 @@
+/*
+  Read-only memory map of an entire file, shared by the MEX readers of the
+  deckformat module (readvector_mex, gridcache_mex and readecloutput_mex).
+
+  The contents are available both as characters (data(), for text input)
+  and as raw bytes (bytes(), for binary input).  A file that exists but is
+  empty is open with size() == 0 and null data.  Pass 'sequential' to hint
+  to the operating system that the file will be read front to back.
+
+  Build stubs add the directory of this file to the include path.
+*/
+
+/*
+  Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+  This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+  MRST is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  MRST is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MRST_DECKFORMAT_MAPPEDFILE_H_INCLUDED
+#define MRST_DECKFORMAT_MAPPEDFILE_H_INCLUDED
+
+#include <cstddef>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const char *fname, bool sequential = false)
+        : data_(0), size_(0), open_(false)
+#if defined(_WIN32)
+        , file_(INVALID_HANDLE_VALUE), map_(0)
+#endif
+    {
+#if defined(_WIN32)
+        file_ = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, 0,
+                            OPEN_EXISTING,
+                            sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                       : FILE_ATTRIBUTE_NORMAL, 0);
+        if (file_ == INVALID_HANDLE_VALUE) { return; }
+
+        LARGE_INTEGER sz;
+        if (! GetFileSizeEx(file_, &sz)) { return; }
+        if (sz.QuadPart == 0) { open_ = true; return; }
+
+        map_ = CreateFileMappingA(file_, 0, PAGE_READONLY, 0, 0, 0);
+        if (map_ == 0) { return; }
+
+        data_ = static_cast<const char *>
+            (MapViewOfFile(map_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ != 0) {
+            size_ = static_cast<std::size_t>(sz.QuadPart);
+            open_ = true;
+        }
+#else
+        const int fd = open(fname, O_RDONLY);
+        if (fd < 0) { return; }
+
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            if (st.st_size == 0) {
+                open_ = true;
+            }
+            else {
+                void *p = mmap(0, static_cast<std::size_t>(st.st_size),
+                               PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    data_ = static_cast<const char *>(p);
+                    size_ = static_cast<std::size_t>(st.st_size);
+                    open_ = true;
+#if defined(MADV_SEQUENTIAL)
+                    if (sequential) { madvise(p, size_, MADV_SEQUENTIAL); }
+#endif
+                }
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#if defined(_WIN32)
+        if (data_ != 0) { UnmapViewOfFile(data_); }
+        if (map_  != 0) { CloseHandle(map_); }
+        if (file_ != INVALID_HANDLE_VALUE) { CloseHandle(file_); }
+#else
+        if (data_ != 0) {
+            munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+    }
+
+    bool        is_open() const { return open_; }
+    const char *data()    const { return data_; }
+    std::size_t size()    const { return size_; }
+
+    const unsigned char *bytes() const
+    {
+        return reinterpret_cast<const unsigned char *>(data_);
+    }
+
+private:
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+
+    const char  *data_;
+    std::size_t  size_;
+    bool         open_;
+#if defined(_WIN32)
+    HANDLE file_, map_;
+#endif
+};
+
+#endif /* MRST_DECKFORMAT_MAPPEDFILE_H_INCLUDED */
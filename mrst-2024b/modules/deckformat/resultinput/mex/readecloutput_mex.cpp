@@ -0,0 +1,497 @@
+/*
+  Extract keywords from unformatted (binary) ECLIPSE result files.
+
+  SYNOPSIS:
+    [v, kw] = readecloutput_mex(fname)
+    [v, kw] = readecloutput_mex(fname, keywords)
+    [v, kw] = readecloutput_mex(fname, keywords, steps)
+    [v, kw] = readecloutput_mex(fname, keywords, steps, marker)
+    [v, kw] = readecloutput_mex(fname, keywords, steps, marker, nthreads)
+
+  The file, typically a unified restart (.UNRST) or summary (.UNSMRY)
+  file, is memory mapped and its record headers indexed in one pass.
+  The layout of a record's data blocks follows from its type and element
+  count, so only the pages holding headers are touched while indexing.
+  The index of the most recently read file is kept between calls and
+  reused while the file's size and modification time are unchanged.
+
+  Step 's' (one-based) consists of the records from the s-th occurrence
+  of keyword 'marker' (default 'SEQNUM', i.e., one report step of a
+  restart file) up to the next occurrence.  Use 'MINISTEP' for summary
+  files.  A file without any marker records is a single step.
+
+  Returns v, a numel(kw)-by-numel(steps) cell array in which v{i,j} holds
+  the values of keyword kw{i} in step steps(j), or [] if the keyword is
+  not present in that step.  If a keyword occurs more than once in a
+  step, the last occurrence is used.  INTE, REAL, DOUB and LOGI data are
+  returned as double column vectors and CHAR (and C0nn) data as column
+  cell arrays of strings with trailing blanks removed, as in
+  readEclipseRestartUnFmt.  Empty 'keywords' selects all keywords in
+  order of first appearance and empty 'steps' selects all steps.
+
+  Conversion from big-endian storage runs on 'nthreads' threads (default:
+  OpenMP default) when built with OpenMP.  The setting applies to this
+  call only.
+*/
+
+/*
+  Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+  This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+  MRST is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  MRST is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <mex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "mappedfile.h"
+
+namespace {
+
+
+
+    inline std::uint32_t be32(const unsigned char *p)
+    {
+        return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+               (std::uint32_t(p[2]) <<  8) |  std::uint32_t(p[3]);
+    }
+
+    inline std::uint64_t be64(const unsigned char *p)
+    {
+        return (std::uint64_t(be32(p)) << 32) | be32(p + 4);
+    }
+
+
+    enum DataType { INTE, REAL, DOUB, LOGI, CHAR, NONE };
+
+    // One keyword record.  The data follow the header as blocks of at
+    // most 'block' elements, each enclosed in 4-byte length markers.
+    struct Record
+    {
+        std::string name;
+        DataType    type;
+        std::size_t count;   // Number of elements
+        std::size_t esize;   // Bytes per element
+        std::size_t block;   // Elements per block
+        std::size_t data;    // Offset of first block's leading marker
+    };
+
+    struct Index
+    {
+        std::string         fname;
+        std::size_t         size;
+        double              mtime;
+        std::vector<Record> rec;
+    };
+
+
+    std::string trim(const unsigned char *p, std::size_t n)
+    {
+        while ((n > 0) && ((p[n - 1] == ' ') || (p[n - 1] == '\0'))) { --n; }
+        return std::string(reinterpret_cast<const char *>(p), n);
+    }
+
+
+    // Element size and block length of ECLIPSE type 't'.
+    bool type_info(const std::string &t, Record &r)
+    {
+        r.block = 1000;
+        if      (t == "INTE") { r.type = INTE; r.esize = 4; }
+        else if (t == "REAL") { r.type = REAL; r.esize = 4; }
+        else if (t == "LOGI") { r.type = LOGI; r.esize = 4; }
+        else if (t == "DOUB") { r.type = DOUB; r.esize = 8; }
+        else if (t == "CHAR") { r.type = CHAR; r.esize = 8; r.block = 105; }
+        else if ((t.size() == 4) && (t[0] == 'C') &&
+                 (t.find_first_not_of("0123456789", 1) == std::string::npos))
+        {
+            r.type  = CHAR;
+            r.esize = static_cast<std::size_t>(std::atoi(t.c_str() + 1));
+            r.block = 105;
+        }
+        else if ((t == "MESS") || (r.count == 0)) { r.type = NONE; r.esize = 0; }
+        else    { return false; }
+
+        return (r.type == NONE) || (r.esize > 0);
+    }
+
+
+    // Index all record headers of 'f'.
+    bool build_index(const MappedFile &f, Index &ix, char *msg)
+    {
+        const unsigned char *b = f.bytes();
+        const std::size_t    n = f.size();
+        std::size_t          p = 0;
+
+        ix.rec.clear();
+
+        while (p < n) {
+            if ((n - p < 24) || (be32(b + p) != 16) || (be32(b + p + 20) != 16)) {
+                std::sprintf(msg, "Malformed record header at offset %lu "
+                             "of '%.400s'", static_cast<unsigned long>(p),
+                             ix.fname.c_str());
+                return false;
+            }
+
+            Record r;
+            const std::int32_t cnt = static_cast<std::int32_t>(be32(b + p + 12));
+
+            r.name  = trim(b + p + 4, 8);
+            r.count = (cnt > 0) ? static_cast<std::size_t>(cnt) : 0;
+            r.data  = p + 24;
+
+            const std::string t(reinterpret_cast<const char *>(b + p + 16), 4);
+            if (! type_info(t, r)) {
+                std::sprintf(msg, "Unsupported type '%s' of keyword '%s' "
+                             "in '%.400s'", t.c_str(), r.name.c_str(),
+                             ix.fname.c_str());
+                return false;
+            }
+
+            p = r.data;
+            if ((r.type != NONE) && (r.count > 0)) {
+                const std::size_t nblk  = (r.count + r.block - 1) / r.block;
+                const std::size_t last  = r.count - (nblk - 1)*r.block;
+                const std::size_t bytes = r.count*r.esize + 8*nblk;
+
+                // Check the first and last block markers only; the others
+                // follow from the fixed block length.
+                if ((n - p < bytes) ||
+                    (be32(b + p) != std::min(r.count, r.block) * r.esize) ||
+                    (be32(b + p + bytes - 4) != last * r.esize))
+                {
+                    std::sprintf(msg, "Malformed data of keyword '%s' at "
+                                 "offset %lu of '%.400s'", r.name.c_str(),
+                                 static_cast<unsigned long>(p),
+                                 ix.fname.c_str());
+                    return false;
+                }
+                p += bytes;
+            }
+
+            ix.rec.push_back(r);
+        }
+
+        return true;
+    }
+
+
+    bool file_status(const std::string &fname, std::size_t &size, double &mtime)
+    {
+        struct stat st;
+        if (stat(fname.c_str(), &st) != 0) { return false; }
+
+        size  = static_cast<std::size_t>(st.st_size);
+        mtime = static_cast<double>(st.st_mtime);
+
+        return true;
+    }
+
+
+    // Convert 'n' elements of data block 'src' to double.
+    void convert_block(const Record &r, const unsigned char *src,
+                       std::size_t n, double *dst)
+    {
+        switch (r.type) {
+        case INTE:
+        case LOGI:
+            for (std::size_t i = 0; i < n; ++i, src += 4) {
+                dst[i] = static_cast<std::int32_t>(be32(src));
+            }
+            break;
+
+        case REAL:
+            for (std::size_t i = 0; i < n; ++i, src += 4) {
+                const std::uint32_t u = be32(src);
+                float x;
+                std::memcpy(&x, &u, sizeof x);
+                dst[i] = x;
+            }
+            break;
+
+        case DOUB:
+            for (std::size_t i = 0; i < n; ++i, src += 8) {
+                const std::uint64_t u = be64(src);
+                std::memcpy(&dst[i], &u, sizeof dst[i]);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+
+    // Contiguous range of data blocks of a single record.
+    struct Job
+    {
+        const Record *rec;
+        std::size_t   first, nblk;
+        double       *dst;
+    };
+
+
+    mxArray *string_values(const unsigned char *base, const Record &r)
+    {
+        mxArray *c = mxCreateCellMatrix(r.count, 1);
+
+        for (std::size_t i = 0; i < r.count; ++i) {
+            const std::size_t blk = i / r.block, k = i % r.block;
+            const unsigned char *s = base + r.data
+                + blk*(r.block*r.esize + 8) + 4 + k*r.esize;
+
+            mxSetCell(c, i, mxCreateString(trim(s, r.esize).c_str()));
+        }
+
+        return c;
+    }
+
+
+    std::vector<std::string> get_strings(const mxArray *a)
+    {
+        std::vector<std::string> s;
+
+        if (mxIsChar(a)) {
+            if (! mxIsEmpty(a)) {
+                char *p = mxArrayToString(a);
+                s.push_back(p);
+                mxFree(p);
+            }
+        }
+        else if (mxIsCell(a)) {
+            for (std::size_t i = 0; i < mxGetNumberOfElements(a); ++i) {
+                const mxArray *e = mxGetCell(a, i);
+                char *p = ((e != 0) && mxIsChar(e)) ? mxArrayToString(e) : 0;
+                s.push_back((p != 0) ? p : "");
+                mxFree(p);
+            }
+        }
+
+        return s;
+    }
+
+
+    Index cache;
+
+
+    bool read_output(int nrhs, const mxArray *prhs[],
+                     int nlhs, mxArray *plhs[], char *msg)
+    {
+        const std::vector<std::string> fn = get_strings(prhs[0]);
+        const std::string fname = fn.empty() ? std::string() : fn[0];
+
+        std::vector<std::string> kw;
+        if (nrhs > 1) { kw = get_strings(prhs[1]); }
+
+        std::string marker = "SEQNUM";
+        if ((nrhs > 3) && ! mxIsEmpty(prhs[3])) {
+            marker = get_strings(prhs[3])[0];
+        }
+
+#if defined(_OPENMP)
+        int nthreads = omp_get_max_threads();
+        if ((nrhs > 4) && (mxGetScalar(prhs[4]) >= 1)) {
+            nthreads = static_cast<int>(mxGetScalar(prhs[4]));
+        }
+#endif
+
+        MappedFile file(fname.c_str());
+        if (! file.is_open()) {
+            std::sprintf(msg, "Unable to open file '%.400s'", fname.c_str());
+            return false;
+        }
+
+        std::size_t size;
+        double      mtime;
+        if (! file_status(fname, size, mtime) || (size != file.size())) {
+            std::sprintf(msg, "Unable to stat file '%.400s'", fname.c_str());
+            return false;
+        }
+
+        if ((cache.fname != fname) || (cache.size != size) ||
+            (cache.mtime != mtime))
+        {
+            cache.fname = fname;
+            cache.size  = size;
+            cache.mtime = mtime;
+
+            if (! build_index(file, cache, msg)) {
+                cache.fname.clear();
+                return false;
+            }
+        }
+        const std::vector<Record> &rec = cache.rec;
+
+        // Step of each record; zero before the first marker.
+        std::vector<std::size_t> step(rec.size());
+        std::size_t nstep = 0;
+        for (std::size_t r = 0; r < rec.size(); ++r) {
+            nstep  += rec[r].name == marker;
+            step[r] = nstep;
+        }
+        if (nstep == 0) {
+            nstep = 1;
+            step.assign(rec.size(), 1);
+        }
+
+        // Selected steps.  Column j of the output is step sel[j].
+        std::vector<std::size_t> sel;
+        if ((nrhs > 2) && ! mxIsEmpty(prhs[2])) {
+            if (! mxIsDouble(prhs[2])) {
+                std::sprintf(msg, "Steps must be a DOUBLE array");
+                return false;
+            }
+            const double *s = mxGetPr(prhs[2]);
+            for (std::size_t j = 0; j < mxGetNumberOfElements(prhs[2]); ++j) {
+                if (! ((s[j] >= 1) && (s[j] <= nstep)) ||
+                    (s[j] != std::floor(s[j])))
+                {
+                    std::sprintf(msg, "Step %g outside range [1, %lu] of "
+                                 "'%.400s'", s[j],
+                                 static_cast<unsigned long>(nstep),
+                                 fname.c_str());
+                    return false;
+                }
+                sel.push_back(static_cast<std::size_t>(s[j]));
+            }
+        }
+        else {
+            for (std::size_t s = 1; s <= nstep; ++s) { sel.push_back(s); }
+        }
+        const std::size_t ncol = sel.size();
+
+        std::vector<bool> wanted(nstep + 1, false);
+        for (std::size_t j = 0; j < ncol; ++j) { wanted[sel[j]] = true; }
+
+        // Keyword rows.  All keywords of the selected steps if none given.
+        // pick[i*(nstep + 1) + s] is the last record of keyword i in step s.
+        std::map<std::string, std::size_t> row;
+        const bool all = kw.empty();
+        for (std::size_t i = 0; i < kw.size(); ++i) {
+            row.insert(std::make_pair(kw[i], i));
+        }
+
+        std::vector<const Record *> pick(kw.size() * (nstep + 1), 0);
+        for (std::size_t r = 0; r < rec.size(); ++r) {
+            if (! wanted[step[r]]) { continue; }
+
+            std::map<std::string, std::size_t>::const_iterator it =
+                row.find(rec[r].name);
+            if (it == row.end()) {
+                if (! all) { continue; }
+                it = row.insert(std::make_pair(rec[r].name, kw.size())).first;
+                kw.push_back(rec[r].name);
+                pick.resize(kw.size() * (nstep + 1), 0);
+            }
+            pick[it->second*(nstep + 1) + step[r]] = &rec[r];
+        }
+
+        // Allocate outputs; numeric data are converted below.
+        const std::size_t nkw = kw.size();
+        mxArray *v = mxCreateCellMatrix(nkw, ncol);
+        std::vector<Job> job;
+        std::size_t      bytes = 0;
+
+        for (std::size_t j = 0; j < ncol; ++j) {
+            for (std::size_t i = 0; i < nkw; ++i) {
+                const Record *r = pick[i*(nstep + 1) + sel[j]];
+                mxArray *a;
+
+                if ((r == 0) || (r->count == 0) || (r->type == NONE)) {
+                    a = mxCreateDoubleMatrix(0, 0, mxREAL);
+                }
+                else if (r->type == CHAR) {
+                    a = string_values(file.bytes(), *r);
+                }
+                else {
+                    a = mxCreateDoubleMatrix(r->count, 1, mxREAL);
+
+                    // About 64 blocks (256kB of REAL data) per job.
+                    const std::size_t nblk = (r->count + r->block - 1) / r->block;
+                    for (std::size_t b = 0; b < nblk; b += 64) {
+                        Job t = { r, b, std::min<std::size_t>(64, nblk - b),
+                                  mxGetPr(a) + b*r->block };
+                        job.push_back(t);
+                    }
+                    bytes += r->count * r->esize;
+                }
+                mxSetCell(v, i + nkw*j, a);
+            }
+        }
+
+        const long njob = static_cast<long>(job.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) \
+                         if (bytes > (1 << 20))
+#endif
+        for (long t = 0; t < njob; ++t) {
+            const Record &r = *job[t].rec;
+            const std::size_t stride = r.block*r.esize + 8;
+
+            for (std::size_t b = job[t].first; b < job[t].first + job[t].nblk; ++b) {
+                const std::size_t n = std::min(r.block, r.count - b*r.block);
+                convert_block(r, file.bytes() + r.data + b*stride + 4, n,
+                              job[t].dst + (b - job[t].first)*r.block);
+            }
+        }
+
+        plhs[0] = v;
+
+        if (nlhs > 1) {
+            plhs[1] = mxCreateCellMatrix(nkw, 1);
+            for (std::size_t i = 0; i < nkw; ++i) {
+                mxSetCell(plhs[1], i, mxCreateString(kw[i].c_str()));
+            }
+        }
+
+        return true;
+    }
+}
+
+
+void
+mexFunction(int nlhs,       mxArray *plhs[],
+            int nrhs, const mxArray *prhs[])
+{
+    static char msg[512];
+
+    if ((nrhs < 1) || (nrhs > 5) || (nlhs > 2) || ! mxIsChar(prhs[0]) ||
+        ((nrhs > 1) && ! mxIsEmpty(prhs[1]) &&
+         ! mxIsChar(prhs[1]) && ! mxIsCell(prhs[1])) ||
+        ((nrhs > 3) && ! mxIsEmpty(prhs[3]) && ! mxIsChar(prhs[3])))
+    {
+        mexErrMsgTxt("Syntax is [v, kw] = readecloutput_mex(fname, "
+                     "keywords, steps, marker, nthreads)");
+    }
+
+    if (! read_output(nrhs, prhs, nlhs, plhs, msg)) {
+        mexErrMsgTxt(msg);
+    }
+}
@@ -0,0 +1,81 @@
+function varargout = readecloutput_mex(varargin)
+%Extract keywords from unformatted ECLIPSE result files (MEX)
+%
+% SYNOPSIS:
+%   [v, kw] = readecloutput_mex(fname, keywords, steps, marker, nthreads)
+%
+% PARAMETERS:
+%   fname    - Name of unformatted ECLIPSE result file, typically a
+%              unified restart (.UNRST) or summary (.UNSMRY) file.
+%
+%   keywords - Cell array of keywords to extract.  All keywords if empty.
+%              OPTIONAL.
+%
+%   steps    - Steps (one-based) to extract.  All steps if empty.
+%              OPTIONAL.
+%
+%   marker   - Keyword starting a new step.  Default value 'SEQNUM' (report
+%              steps of a restart file).  Use 'MINISTEP' for summary files.
+%              OPTIONAL.
+%
+%   nthreads - Number of threads converting the data.  OPTIONAL.
+%
+% RETURNS:
+%   v        - Cell array, numel(kw)-by-numel(steps), of values.  v{i,j}
+%              holds keyword kw{i} of step steps(j) as a DOUBLE column
+%              vector (INTE, REAL, DOUB and LOGI data) or a cell array of
+%              strings (CHAR data), or [] if not present in that step.
+%
+%   kw       - Names of extracted keywords.
+%
+% NOTE:
+%   Compiles and invokes MEX function of the same name on first call.
+%   Functions 'readEclipseRestartUnFmt' and 'readEclipseSummaryUnFmt' use
+%   the compiled MEX function if it exists.
+%
+% SEE ALSO:
+%   `readEclipseRestartUnFmt`, `readEclipseSummaryUnFmt`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   if ispc
+      CXXFLAGS = { 'COMPFLAGS=$COMPFLAGS /EHsc /openmp' };
+      LINK     = { };
+   else
+      CXXFLAGS = {'CXXFLAGS="$CXXFLAGS', '-fPIC', '-O3', '-std=c++11', ...
+                  '-fopenmp', '-Wall', '-Wextra', '-pedantic',         ...
+                  '-Wcast-align', '-Wpointer-arith', '-Wundef',        ...
+                  '-Wcast-qual', '-Wshadow', '-Wwrite-strings"'};
+      LINK     = {'LDFLAGS="$LDFLAGS', '-fopenmp"'};
+   end
+
+   % Shared memory-mapped file reader, mappedfile.h
+   d       = fileparts(mfilename('fullpath'));
+   INCLUDE = { ['-I', fullfile(d, '..', '..', 'mex')] };
+
+   OPTS = { '-O', '-largeArrayDims' };
+
+   SRC = { 'readecloutput_mex.cpp' };
+
+   buildmex(CXXFLAGS{:}, LINK{:}, INCLUDE{:}, OPTS{:}, SRC{:});
+
+   % Call MEX edition.
+   [varargout{1:nargout}] = readecloutput_mex(varargin{:});
+end
@@ -91,6 +91,12 @@ else % use RSSPEC
     output = cell2struct(v, nms);
     
     % Read
+    if exist('readecloutput_mex', 'file') == 3
+        % Compiled reader is available (run READECLOUTPUT_MEX once to build).
+        output = readRestartNative(prefix, spec, steps, output);
+        return;
+    end
+
     if strcmp(spec.type, 'unified')
         fname = [prefix, '.UNRST'];
         [fid, msg] = fopen(fname, 'rb', 'ieee-be');
@@ -142,6 +148,29 @@ end
 
 %--------------------------------------------------------------------------
 
+function output = readRestartNative(prefix, spec, steps, output)
+    % Keywords of requested steps in order of first appearance.
+    kw = [spec.keywords{steps}];
+    [~, i] = unique(kw, 'first');
+    kw = kw(sort(i));
+
+    if strcmp(spec.type, 'unified')
+        v = readecloutput_mex([prefix, '.UNRST'], kw, steps, 'SEQNUM');
+    else
+        v = cell(numel(kw), numel(steps));
+        for ks = 1:numel(steps)
+            v(:, ks) = readecloutput_mex(spec.fnames{steps(ks)}, kw, 1, ...
+                                         'SEQNUM');
+        end
+    end
+
+    for kf = 1:numel(kw)
+        output.(fixVarName(kw{kf})) = v(kf, :);
+    end
+end
+
+%--------------------------------------------------------------------------
+
 function name = fixVarName(name)
     if ~isvarname(name)
         name = regexprep(name, {'+', '-'}, {'p', 'n'});
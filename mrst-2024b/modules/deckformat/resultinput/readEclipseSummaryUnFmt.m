@@ -178,7 +178,14 @@ ministeps = nan(1, estNum);
 curStep = 0;
 
 dispif(mrstVerbose, ['Reading info from roughly ', num2str(estNum), ' ministeps:      '])
+useNative = exist('readecloutput_mex', 'file') == 3;
 for f = reshape(smry_files, 1, [])
+    if useNative
+        % Compiled reader is available (run READECLOUTPUT_MEX once to build).
+        [data, ministeps, curStep] = ...
+           readSummaryNative(f{1}, rowInx, data, ministeps, curStep);
+        continue;
+    end
     [fid, msg] = fopen(f{1}, 'r', 'ieee-be');
     if fid < 0, error([f{1}, ': ', msg]); end
     % jump to start
@@ -221,6 +228,26 @@ end
 
 %--------------------------------------------------------------------------
 
+function [data, ministeps, curStep] = ...
+      readSummaryNative(fname, rowInx, data, ministeps, curStep)
+% MINISTEP and PARAMS records of all ministeps in one summary file.
+v = readecloutput_mex(fname, {'MINISTEP', 'PARAMS'}, [], 'MINISTEP');
+v = v(:, ~cellfun('isempty', v(1, :)));
+
+ix = curStep + (1 : size(v, 2));
+ministeps(ix) = [v{1, :}];
+
+hasParams = ~cellfun('isempty', v(2, :));
+if any(hasParams)
+    params = [v{2, hasParams}];
+    data(:, ix(hasParams)) = params(rowInx, :);
+end
+
+curStep = curStep + size(v, 2);
+end
+
+%--------------------------------------------------------------------------
+
 function smry = addSmryFuncs(smry)
 smry.get    = @(varargin)getData(smry, varargin{:});
 smry.getInx = @(nm,kw)getRowInx(smry,nm,kw);
@@ -28,21 +28,21 @@ norm(const double w[3])
 
 /* ------------------------------------------------------------------ */
 void
-compute_face_geometry(int ndims, double *coords, int nfaces,
-                      int *nodepos, int *facenodes, double *fnormals,
-                      double *fcentroids, double *fareas)
+compute_face_geometry(int ndims, double *coords, mrst_index_t nfaces,
+                      mrst_index_t *nodepos, mrst_index_t *facenodes,
+                      double *fnormals, double *fcentroids, double *fareas)
 /* ------------------------------------------------------------------ */
 {
 
    /* Assume 3D for now */
-   int f;
+   mrst_index_t f;
    double x[3];
    double u[3];
    double v[3];
    double w[3];
 
-   int i,k;
-   int node;
+   int i;
+   mrst_index_t k, node;
 
    double cface[3]  = {0};
    double n[3]  = {0};
@@ -113,16 +113,19 @@ compute_face_geometry(int ndims, double *coords, int nfaces,
 /* ------------------------------------------------------------------ */
 void
 compute_cell_geometry(int ndims, double *coords,
-                      int *nodepos, int *facenodes, int *neighbors,
+                      mrst_index_t *nodepos, mrst_index_t *facenodes,
+                      mrst_index_t *neighbors,
                       double *fnormals,
                       double *fcentroids,
-                      int ncells, int *facepos, int *cellfaces,
+                      mrst_index_t ncells, mrst_index_t *facepos,
+                      mrst_index_t *cellfaces,
                       double *ccentroids, double *cvolumes)
 /* ------------------------------------------------------------------ */
 {
 
-   int i,k, f,c;
-   int face,node;
+   int i;
+   mrst_index_t k, f, c;
+   mrst_index_t face, node;
    double x[3];
    double u[3];
    double v[3];
@@ -232,8 +235,8 @@ compute_cell_geometry(int ndims, double *coords,
 
       if (! (volume > 0.0)) {
           fprintf(stderr,
-                  "Internal error in mex_compute_geometry(%*d): "
-                  "negative volume\n", ndigits, c);
+                  "Internal error in mex_compute_geometry(%*lu): "
+                  "negative volume\n", ndigits, (unsigned long) c);
       }
 
       for (i=0; i<ndims; ++i) ccentroids[3*c+i] = xcell[i] + ccell[i]/volume;
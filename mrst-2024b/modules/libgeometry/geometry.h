@@ -5,15 +5,43 @@
 #ifndef MIMETIC_GEOMETRY_H_INCLUDED
 #define MIMETIC_GEOMETRY_H_INCLUDED
 
-void compute_face_geometry(int ndims, double *coords, int nfaces, 
-                           int *nodepos, int *facenodes, 
-                           double *fnormals, double *fcentroids, 
+#include "grid.h"            /* mrst_index_t */
+
+void compute_face_geometry(int ndims, double *coords, mrst_index_t nfaces,
+                           mrst_index_t *nodepos, mrst_index_t *facenodes,
+                           double *fnormals, double *fcentroids,
                            double *fareas);
 void compute_cell_geometry(int ndims, double *coords,
-                           int *nodepos, int *facenodes, int *neighbours,
-			   double *fnormals,
-                           double *fcentroids, int ncells, 
-                           int *facepos, int *cellfaces, 
+                           mrst_index_t *nodepos, mrst_index_t *facenodes,
+                           mrst_index_t *neighbours,
+                           double *fnormals,
+                           double *fcentroids, mrst_index_t ncells,
+                           mrst_index_t *facepos, mrst_index_t *cellfaces,
+                           double *ccentroids, double *cvolumes);
+
+/* Face and cell geometry (3D) in a single traversal of the cells.
+ * Returns zero if out of memory.  Implemented in geometry_para.c. */
+int  compute_geometry_fused(double *coords, mrst_index_t nfaces,
+                            mrst_index_t *nodepos, mrst_index_t *facenodes,
+                            mrst_index_t *neighbours, mrst_index_t ncells,
+                            mrst_index_t *facepos, mrst_index_t *cellfaces,
+                            double *fnormals, double *fcentroids,
+                            double *fareas,
+                            double *ccentroids, double *cvolumes);
+
+/* Recompute, in place, the geometry of faces 'updfaces' and cells
+ * 'updcells' after nodes have moved.  The cells must include all
+ * neighbours of the faces.  Returns zero if out of memory. */
+int  update_geometry_fused(double *coords,
+                           mrst_index_t *nodepos, mrst_index_t *facenodes,
+                           mrst_index_t *neighbours,
+                           mrst_index_t *facepos, mrst_index_t *cellfaces,
+                           mrst_index_t nupdfaces,
+                           const mrst_index_t *updfaces,
+                           mrst_index_t nupdcells,
+                           const mrst_index_t *updcells,
+                           double *fnormals, double *fcentroids,
+                           double *fareas,
                            double *ccentroids, double *cvolumes);
 
 #endif /* MIMETIC_GEOMETRY_H_INCLUDED */
@@ -5,6 +5,7 @@
 #include <omp.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "geometry.h"
 
 /* ------------------------------------------------------------------ */
@@ -29,21 +30,21 @@ norm(const double w[3])
 
 /* ------------------------------------------------------------------ */
 void
-compute_face_geometry(int ndims, double *coords, int nfaces,
-                      int *nodepos, int *facenodes, double *fnormals,
-                      double *fcentroids, double *fareas)
+compute_face_geometry(int ndims, double *coords, mrst_index_t nfaces,
+                      mrst_index_t *nodepos, mrst_index_t *facenodes,
+                      double *fnormals, double *fcentroids, double *fareas)
 /* ------------------------------------------------------------------ */
 {
 
    /* Assume 3D for now */
-   int f;
+   mrst_index_t f;
    double x[3];
    double u[3];
    double v[3];
    double w[3];
 
-   int i,k;
-   int node;
+   int i;
+   mrst_index_t k, node;
 
    double cface[3]  = {0};
    double n[3]  = {0};
@@ -124,16 +125,19 @@ compute_face_geometry(int ndims, double *coords, int nfaces,
 /* ------------------------------------------------------------------ */
 void
 compute_cell_geometry(int ndims, double *coords,
-                      int *nodepos, int *facenodes, int *neighbors,
+                      mrst_index_t *nodepos, mrst_index_t *facenodes,
+                      mrst_index_t *neighbors,
 		      double *fnormals,
 		      double *fcentroids,
-                      int ncells, int *facepos, int *cellfaces,
+                      mrst_index_t ncells, mrst_index_t *facepos,
+                      mrst_index_t *cellfaces,
                       double *ccentroids, double *cvolumes)
 /* ------------------------------------------------------------------ */
 {
 
-   int i,k, f,c;
-   int face,node;
+   int i;
+   mrst_index_t k, f, c;
+   mrst_index_t face, node;
    double x[3];
    double u[3];
    double v[3];
@@ -248,3 +252,409 @@ compute_cell_geometry(int ndims, double *coords,
       cvolumes[c] = volume;
    }
 }
+
+
+/*
+ * Fused face and cell geometry.
+ *
+ * A single parallel traversal of the cells in which every cell evaluates
+ * the triangle fans of its faces once, in the order of 'cellfaces'.  The
+ * fans provide both the face quantities and the cell's tetrahedra.  Each
+ * face is stored by its owner, the first cell in 'neighbors', so every
+ * output is written exactly once and the results are independent of the
+ * number of threads.  The results are identical to those of
+ * compute_face_geometry followed by compute_cell_geometry.
+ */
+
+/* One triangle of a face's fan: (unnormalised) normal and centroid. */
+struct fan_triangle {
+   double w[3];
+   double c[3];
+};
+
+/* One face of the current cell. */
+struct cell_face {
+   mrst_index_t face;
+   int          ntri;
+   double x[3];   /* Average of face nodes */
+   double n[3];   /* Face normal, scaled with face area */
+};
+
+/* Per-thread work space, grown on demand. */
+struct fused_work {
+   struct fan_triangle *tri;
+   struct cell_face    *faces;
+   int                  maxtri, maxfaces;
+};
+
+
+/* ------------------------------------------------------------------ */
+static int
+reserve_work(struct fused_work *work, int nfaces, int ntri)
+/* ------------------------------------------------------------------ */
+{
+   void *p;
+
+   if (nfaces > work->maxfaces) {
+      p = realloc(work->faces, nfaces * sizeof *work->faces);
+      if (p == NULL) { return 0; }
+
+      work->faces    = p;
+      work->maxfaces = nfaces;
+   }
+
+   if (ntri > work->maxtri) {
+      p = realloc(work->tri, ntri * sizeof *work->tri);
+      if (p == NULL) { return 0; }
+
+      work->tri    = p;
+      work->maxtri = ntri;
+   }
+
+   return 1;
+}
+
+
+/* ------------------------------------------------------------------ */
+static void
+face_fan_general(const double *coords, int nnodes, const mrst_index_t *nodes,
+                 struct cell_face *cf, struct fan_triangle *tri,
+                 double *cface, double *area)
+/* ------------------------------------------------------------------ */
+{
+   int          i, k;
+   mrst_index_t node;
+   double u[3], v[3], a;
+   double twothirds = 0.666666666666666666666666666667;
+
+   for (i=0; i<3; ++i) cf->x[i] = 0.0;
+   for (i=0; i<3; ++i) cf->n[i] = 0.0;
+   for (i=0; i<3; ++i) cface[i] = 0.0;
+
+   for (k=0; k<nnodes; ++k) {
+      node = nodes[k];
+      for (i=0; i<3; ++i) cf->x[i] += coords[3*node+i];
+   }
+   for (i=0; i<3; ++i) cf->x[i] /= nnodes;
+
+   node = nodes[nnodes-1];
+   for (i=0; i<3; ++i) u[i] = coords[3*node+i] - cf->x[i];
+
+   *area = 0;
+   for (k=0; k<nnodes; ++k) {
+      node = nodes[k];
+      for (i=0; i<3; ++i) v[i] = coords[3*node+i] - cf->x[i];
+
+      cross(u, v, tri[k].w);
+      a      = 0.5*norm(tri[k].w);
+      *area += a;
+
+      for (i=0; i<3; ++i) cf->n[i] += tri[k].w[i];
+      for (i=0; i<3; ++i) {
+         tri[k].c[i] = cf->x[i] + twothirds*0.5*(u[i]+v[i]);
+         cface[i]   += a*tri[k].c[i];
+      }
+
+      for (i=0; i<3; ++i) u[i] = v[i];
+   }
+}
+
+
+/* ------------------------------------------------------------------ */
+static void
+face_fan_quad(const double *coords, const mrst_index_t *nodes,
+              struct cell_face *cf, struct fan_triangle *tri,
+              double *cface, double *area)
+/* ------------------------------------------------------------------ */
+{
+   /*
+    * Quadrilateral faces, the common case on corner-point grids.  The
+    * four triangles are evaluated in structure-of-arrays form, one SIMD
+    * lane per triangle, while the sums are accumulated in the order of
+    * face_fan_general.
+    */
+   int    i, k;
+   double vx[4], vy[4], vz[4];
+   double ux[4], uy[4], uz[4];
+   double wx[4], wy[4], wz[4];
+   double a[4];
+   double twothirds = 0.666666666666666666666666666667;
+
+   for (i=0; i<3; ++i) {
+      cf->x[i] = 0.0;
+      cf->x[i] += coords[3*nodes[0]+i];
+      cf->x[i] += coords[3*nodes[1]+i];
+      cf->x[i] += coords[3*nodes[2]+i];
+      cf->x[i] += coords[3*nodes[3]+i];
+      cf->x[i] /= 4;
+   }
+
+   for (k=0; k<4; ++k) {
+      vx[k] = coords[3*nodes[k]+0] - cf->x[0];
+      vy[k] = coords[3*nodes[k]+1] - cf->x[1];
+      vz[k] = coords[3*nodes[k]+2] - cf->x[2];
+   }
+   for (k=0; k<4; ++k) {
+      ux[k] = vx[(k+3)%4];
+      uy[k] = vy[(k+3)%4];
+      uz[k] = vz[(k+3)%4];
+   }
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+   for (k=0; k<4; ++k) {
+      wx[k] = uy[k]*vz[k]-uz[k]*vy[k];
+      wy[k] = uz[k]*vx[k]-ux[k]*vz[k];
+      wz[k] = ux[k]*vy[k]-uy[k]*vx[k];
+      a [k] = 0.5*sqrt(wx[k]*wx[k] + wy[k]*wy[k] + wz[k]*wz[k]);
+   }
+
+   for (k=0; k<4; ++k) {
+      tri[k].w[0] = wx[k];
+      tri[k].w[1] = wy[k];
+      tri[k].w[2] = wz[k];
+      tri[k].c[0] = cf->x[0] + twothirds*0.5*(ux[k]+vx[k]);
+      tri[k].c[1] = cf->x[1] + twothirds*0.5*(uy[k]+vy[k]);
+      tri[k].c[2] = cf->x[2] + twothirds*0.5*(uz[k]+vz[k]);
+   }
+
+   *area = 0;
+   for (i=0; i<3; ++i) { cf->n[i] = 0.0; cface[i] = 0.0; }
+   for (k=0; k<4; ++k) {
+      *area += a[k];
+      for (i=0; i<3; ++i) {
+         cf->n[i] += tri[k].w[i];
+         cface[i] += a[k]*tri[k].c[i];
+      }
+   }
+}
+
+
+/* ------------------------------------------------------------------ */
+static mrst_index_t
+face_owner(const mrst_index_t *neighbors, mrst_index_t f)
+/* ------------------------------------------------------------------ */
+{
+   return (neighbors[2*f+0] >= 0) ? neighbors[2*f+0] : neighbors[2*f+1];
+}
+
+
+/* ------------------------------------------------------------------ */
+static void
+fused_cell(const double *coords, const mrst_index_t *nodepos,
+           const mrst_index_t *facenodes, const mrst_index_t *neighbors,
+           const mrst_index_t *facepos, const mrst_index_t *cellfaces,
+           mrst_index_t c, struct fused_work *work,
+           double *fnormals, double *fcentroids, double *fareas,
+           double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   int          i, j, k, nf, nn;
+   mrst_index_t f;
+   double cface[3], area, fc, fn[3];
+   double xcell[3], ccell[3], volume, tet_volume, subnormal_sign;
+
+   struct cell_face    *cf;
+   struct fan_triangle *tri;
+
+   nf = facepos[c+1] - facepos[c];
+
+   /*
+    * Face geometry from the triangle fans.  The fans are kept for the
+    * tetrahedra below.
+    */
+   for (i=0; i<3; ++i) xcell[i] = 0.0;
+
+   tri = work->tri;
+   for (j=0; j<nf; ++j) {
+      cf       = &work->faces[j];
+      cf->face = f = cellfaces[facepos[c] + j];
+      nn       = nodepos[f+1] - nodepos[f];
+      cf->ntri = nn;
+
+      if (nn == 4) {
+         face_fan_quad(coords, facenodes + nodepos[f], cf, tri,
+                       cface, &area);
+      } else {
+         face_fan_general(coords, nn, facenodes + nodepos[f], cf, tri,
+                          cface, &area);
+      }
+
+      for (i=0; i<3; ++i) {
+         fc        = cface[i]/area;
+         xcell[i] += fc;
+
+         if (face_owner(neighbors, f) == c) {
+            fnormals  [3*f+i] = 0.5*cf->n[i];
+            fcentroids[3*f+i] = fc;
+         }
+      }
+      if (face_owner(neighbors, f) == c) {
+         fareas[f] = area;
+      }
+
+      tri += nn;
+   }
+
+   for (i=0; i<3; ++i) xcell[i] /= nf;
+
+   /*
+    * For all faces, add tetrahedron's volume and centroid to 'cvolume'
+    * and 'ccentroid'.
+    */
+   for (i=0; i<3; ++i) ccell[i] = 0.0;
+   volume = 0;
+
+   tri = work->tri;
+   for (j=0; j<nf; ++j) {
+      cf = &work->faces[j];
+      for (i=0; i<3; ++i) fn[i] = 0.5*cf->n[i];
+
+      for (k=0; k<cf->ntri; ++k, ++tri) {
+         tet_volume = 0;
+         for (i=0; i<3; ++i) {
+            tet_volume += 0.5/3 * tri->w[i]*(cf->x[i]-xcell[i]);
+         }
+
+         subnormal_sign = 0.0;
+         for (i=0; i<3; ++i) {
+            subnormal_sign += tri->w[i]*fn[i];
+         }
+
+         if (subnormal_sign < 0) {
+            tet_volume *= -1.0;
+         }
+         if (!(neighbors[2*cf->face+0] == c)) {
+            tet_volume *= -1.0;
+         }
+         volume += tet_volume;
+
+         for (i=0; i<3; ++i) {
+            ccell[i] += tet_volume * 3/4.0*(tri->c[i] - xcell[i]);
+         }
+      }
+   }
+
+   for (i=0; i<3; ++i) ccentroids[3*c+i] = xcell[i] + ccell[i]/volume;
+   cvolumes[c] = volume;
+}
+
+
+/* ------------------------------------------------------------------ */
+static int
+fused_cells(double *coords, mrst_index_t *nodepos, mrst_index_t *facenodes,
+            mrst_index_t *neighbors, mrst_index_t *facepos,
+            mrst_index_t *cellfaces, mrst_index_t n,
+            const mrst_index_t *cells,
+            double *fnormals, double *fcentroids, double *fareas,
+            double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   /* Cells 'cells[0 .. n-1]', or 0 .. n-1 if 'cells' is NULL. */
+   int ok = 1;
+
+#pragma omp parallel
+   {
+      mrst_index_t k, c, j;
+      int          nf, ntri, thread_ok = 1;
+      struct fused_work work = { NULL, NULL, 0, 0 };
+
+#pragma omp for schedule(static)
+      for (k=0; k<n; ++k) {
+         if (thread_ok) {
+            c    = (cells != NULL) ? cells[k] : k;
+            nf   = facepos[c+1] - facepos[c];
+            ntri = 0;
+            for (j=facepos[c]; j<facepos[c+1]; ++j) {
+               ntri += nodepos[cellfaces[j]+1] - nodepos[cellfaces[j]];
+            }
+
+            thread_ok = reserve_work(&work, nf, ntri);
+            if (thread_ok) {
+               fused_cell(coords, nodepos, facenodes, neighbors,
+                          facepos, cellfaces, c, &work,
+                          fnormals, fcentroids, fareas,
+                          ccentroids, cvolumes);
+            }
+         }
+      }
+
+      if (!thread_ok) {
+#pragma omp critical
+         ok = 0;
+      }
+
+      free(work.faces);
+      free(work.tri);
+   }
+
+   return ok;
+}
+
+
+/* ------------------------------------------------------------------ */
+int
+compute_geometry_fused(double *coords, mrst_index_t nfaces,
+                       mrst_index_t *nodepos, mrst_index_t *facenodes,
+                       mrst_index_t *neighbors, mrst_index_t ncells,
+                       mrst_index_t *facepos, mrst_index_t *cellfaces,
+                       double *fnormals, double *fcentroids, double *fareas,
+                       double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   mrst_index_t f;
+   int          ok;
+
+   ok = fused_cells(coords, nodepos, facenodes, neighbors,
+                    facepos, cellfaces, ncells, NULL,
+                    fnormals, fcentroids, fareas, ccentroids, cvolumes);
+
+   /* Faces without cells are left to the face kernel. */
+   for (f=0; ok && (f<nfaces); ++f) {
+      if (face_owner(neighbors, f) < 0) {
+         compute_face_geometry(3, coords, 1, nodepos + f, facenodes,
+                               fnormals + 3*f, fcentroids + 3*f,
+                               fareas + f);
+      }
+   }
+
+   return ok;
+}
+
+
+/* ------------------------------------------------------------------ */
+int
+update_geometry_fused(double *coords,
+                      mrst_index_t *nodepos, mrst_index_t *facenodes,
+                      mrst_index_t *neighbors,
+                      mrst_index_t *facepos, mrst_index_t *cellfaces,
+                      mrst_index_t nupdfaces, const mrst_index_t *updfaces,
+                      mrst_index_t nupdcells, const mrst_index_t *updcells,
+                      double *fnormals, double *fcentroids, double *fareas,
+                      double *ccentroids, double *cvolumes)
+/* ------------------------------------------------------------------ */
+{
+   /*
+    * Faces are stored by their owning cell, so 'updcells' must contain
+    * the neighbours of all faces in 'updfaces'.  Only faces without
+    * cells are computed here.  Remaining entries are left untouched.
+    */
+   mrst_index_t k, f;
+   int          ok;
+
+   ok = fused_cells(coords, nodepos, facenodes, neighbors,
+                    facepos, cellfaces, nupdcells, updcells,
+                    fnormals, fcentroids, fareas, ccentroids, cvolumes);
+
+   for (k=0; ok && (k<nupdfaces); ++k) {
+      f = updfaces[k];
+      if (face_owner(neighbors, f) < 0) {
+         compute_face_geometry(3, coords, 1, nodepos + f, facenodes,
+                               fnormals + 3*f, fcentroids + 3*f,
+                               fareas + f);
+      }
+   }
+
+   return ok;
+}
@@ -5,7 +5,11 @@ function G = mcomputeGeometry_para(G, flag)
 %   G = mcomputeGeometry(G)
 %
 % PARAMETERS:
-%   G - A grid_structure.
+%   G    - A grid_structure.
+%
+%   flag - Number of OpenMP threads.  If zero (default), use the serial
+%          code.  Otherwise face and cell geometry are computed in a
+%          single parallel pass over the cells.
 %
 % RETURNS:
 %   G - An updated grid_structure containing areas, volumes, normals and
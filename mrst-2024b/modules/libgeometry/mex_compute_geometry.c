@@ -86,29 +86,35 @@ args_ok(int nlhs, int nrhs, const mxArray *prhs[])
 
 /* ---------------------------------------------------------------------- */
 static void
-compute_geometry(const mxArray *G ,
-                 const int      d ,
-                 const int      nc,
-                 const int      nf,
-                 double        *a ,
-                 double        *fc,
-                 double        *fn,
-                 double        *cc,
-                 double        *cv)
+compute_geometry(const mxArray      *G ,
+                 const int           d ,
+                 const mrst_index_t  nc,
+                 const mrst_index_t  nf,
+                 double             *a ,
+                 double             *fc,
+                 double             *fn,
+                 double             *cc,
+                 double             *cv)
 /* ---------------------------------------------------------------------- */
 {
-    int    *nodepos, *facenodes, *cellfaces, *facepos, *neighbors;
+    mrst_index_t *nodepos, *facenodes, *cellfaces, *facepos, *neighbors;
+    const grid_t *g;
     double *coords;
 
     mxAssert(d == 3, "Sorry, only support for 3D grids.");
 
-    /* Grid topology: */
-    nodepos   = getFaceNodePos(G);
-    facenodes = getFaceNodes(G);
-    cellfaces = getCellFaces(G);
-    facepos   = getCellFacePos(G);
-    neighbors = getFaceCellNeighbors(G);
-    coords    = getNodeCoordinates(G);
+    /* Grid topology, cached across calls: */
+    g = mrst_grid_view(G);
+    if (g == NULL) {
+        mexErrMsgTxt("Unable to access grid topology");
+    }
+
+    nodepos   = g->face_nodepos;
+    facenodes = g->face_nodes;
+    cellfaces = g->cell_faces;
+    facepos   = g->cell_facepos;
+    neighbors = g->face_cells;
+    coords    = g->node_coordinates;
     
 
 
@@ -119,11 +125,6 @@ compute_geometry(const mxArray *G ,
     /* Compute cell geometry */
     compute_cell_geometry(d, coords, nodepos, facenodes, neighbors,
                           fn, fc, nc, facepos, cellfaces, cc, cv);
-
-
-    /* Clean up */
-    mxFree(coords);   mxFree(neighbors);  mxFree(facenodes);
-    mxFree(nodepos);  mxFree(cellfaces);  mxFree(facepos);
 }
 
 
@@ -133,7 +134,8 @@ mexFunction(int nlhs,       mxArray *plhs[],
             int nrhs, const mxArray *prhs[])
 /* ---------------------------------------------------------------------- */
 {
-    int nc, nf, nd;
+    mrst_index_t nc, nf;
+    int nd;
 
     const mxArray *G;
     mxArray       *fa, *fc, *fn, *cc, *cv;
@@ -39,6 +39,12 @@ along with MRST.  If not, see <http://www.gnu.org/licenses/>.
 
    OPTS = { '-O', '-largeArrayDims' };
 
+   % 64-bit cell/face/node numbering for very large models.  Must agree
+   % between processgrid_mex and the libgeometry gateways.
+   if ~isempty(getenv('MRST_INDEX_64')),
+      OPTS = [OPTS, { '-DMRST_INDEX_64' }];
+   end
+
    SRC = { 'mex_compute_geometry.c', 'geometry.c', ...
            fullfile(d, '..', 'mrst_api', 'mrst_api.c') };
 
@@ -80,50 +80,63 @@ static int
 args_ok(int nlhs, int nrhs, const mxArray *prhs[])
 /* ---------------------------------------------------------------------- */
 {
-    return (nlhs == 5) && (nrhs == 2) && verify_grid(prhs[0]);
+    return (nlhs == 5) && ((nrhs == 2) || (nrhs == 3)) &&
+        verify_grid(prhs[0]);
 }
 
 
 /* ---------------------------------------------------------------------- */
-static void
-compute_geometry(const mxArray *G ,
-                 const int      d ,
-                 const int      nc,
-                 const int      nf,
-                 double        *a ,
-                 double        *fc,
-                 double        *fn,
-                 double        *cc,
-                 double        *cv)
+static int
+compute_geometry(const mxArray      *G ,
+                 const int           d ,
+                 const mrst_index_t  nc,
+                 const mrst_index_t  nf,
+                 const int           fused,
+                 double             *a ,
+                 double             *fc,
+                 double             *fn,
+                 double             *cc,
+                 double             *cv)
 /* ---------------------------------------------------------------------- */
 {
-    int    *nodepos, *facenodes, *cellfaces, *facepos, *neighbors;
+    mrst_index_t *nodepos, *facenodes, *cellfaces, *facepos, *neighbors;
+    const grid_t *g;
+    int     ok = 1;
     double *coords;
 
     mxAssert(d == 3, "Sorry, only support for 3D grids.");
 
-    /* Grid topology: */
-    nodepos   = getFaceNodePos(G);
-    facenodes = getFaceNodes(G);
-    cellfaces = getCellFaces(G);
-    facepos   = getCellFacePos(G);
-    neighbors = getFaceCellNeighbors(G);
-    coords    = getNodeCoordinates(G);
+    /* Grid topology, cached across calls: */
+    g = mrst_grid_view(G);
+    if (g == NULL) {
+        mexErrMsgTxt("Unable to access grid topology");
+    }
 
+    nodepos   = g->face_nodepos;
+    facenodes = g->face_nodes;
+    cellfaces = g->cell_faces;
+    facepos   = g->cell_facepos;
+    neighbors = g->face_cells;
+    coords    = g->node_coordinates;
 
 
-    /* Compute face geometry */
-    compute_face_geometry(d, coords, nf, nodepos, facenodes, fn, fc, a);
 
+    if (fused) {
+        /* Compute face and cell geometry in a single pass */
+        ok = compute_geometry_fused(coords, nf, nodepos, facenodes,
+                                    neighbors, nc, facepos, cellfaces,
+                                    fn, fc, a, cc, cv);
+    } else {
+        /* Compute face geometry */
+        compute_face_geometry(d, coords, nf, nodepos, facenodes, fn, fc, a);
 
-    /* Compute cell geometry */
-    compute_cell_geometry(d, coords, nodepos, facenodes, neighbors,
-                          fn, fc, nc, facepos, cellfaces, cc, cv);
 
+        /* Compute cell geometry */
+        compute_cell_geometry(d, coords, nodepos, facenodes, neighbors,
+                              fn, fc, nc, facepos, cellfaces, cc, cv);
+    }
 
-    /* Clean up */
-    mxFree(coords);   mxFree(facenodes);
-    mxFree(nodepos);  mxFree(cellfaces);  mxFree(facepos);
+    return ok;
 }
 
 
@@ -133,8 +146,9 @@ mexFunction(int nlhs,       mxArray *plhs[],
             int nrhs, const mxArray *prhs[])
 /* ---------------------------------------------------------------------- */
 {
-    int nc, nf, nd;
-    int flag;
+    mrst_index_t nc, nf;
+    int nd;
+    int flag, fused;
     double dtmp;
     const mxArray *G;
     mxArray       *fa, *fc, *fn, *cc, *cv;
@@ -146,6 +160,8 @@ mexFunction(int nlhs,       mxArray *plhs[],
 	flag = (int)  mxGetScalar(prhs[1]);
 	/* mexPrintf("Using %i threads\n",flag); */
 	omp_set_num_threads(flag);
+        fused = (nrhs < 3) || mxIsLogicalScalarTrue(prhs[2]) ||
+                (mxIsNumeric(prhs[2]) && (mxGetScalar(prhs[2]) != 0));
         nc = getNumberOfCells(G);
         nf = getNumberOfFaces(G);
         nd = getNumberOfDimensions(G);
@@ -156,9 +172,11 @@ mexFunction(int nlhs,       mxArray *plhs[],
         cc = mxCreateDoubleMatrix(nd, nc, mxREAL); /* Cell centroid */
         cv = mxCreateDoubleMatrix(nc,  1, mxREAL); /* Cell volume */
 
-        compute_geometry(G, nd, nc, nf,
-                         mxGetPr(fa), mxGetPr(fc), mxGetPr(fn),
-                         mxGetPr(cc), mxGetPr(cv));
+        if (! compute_geometry(G, nd, nc, nf, fused,
+                               mxGetPr(fa), mxGetPr(fc), mxGetPr(fn),
+                               mxGetPr(cc), mxGetPr(cv))) {
+            mexErrMsgTxt("Out of memory in fused geometry computation");
+        }
 
         plhs[0] = fa;
         plhs[1] = fc;
@@ -168,7 +186,7 @@ mexFunction(int nlhs,       mxArray *plhs[],
     } else {
         sprintf(errmsg,
                 "Calling sequence is\n\t"
-                "[fa, fc, fn, cc, cv] = %s(G)",
+                "[fa, fc, fn, cc, cv] = %s(G, nthreads[, fused])",
                 mexFunctionName());
         mexErrMsgTxt(errmsg);
     }
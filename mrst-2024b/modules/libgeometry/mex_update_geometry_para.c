@@ -0,0 +1,249 @@
+/*
+ * Copyright 2010 (c) SINTEF ICT, Applied Mathematics.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <omp.h>
+#include <mex.h>
+
+#include "grid.h"
+#include "mrst_api.h"
+
+#include "geometry.h"
+
+
+/* ------------------------------------------------------------------ */
+static int
+verify_faces_structure(mxArray *faces)
+/* ------------------------------------------------------------------ */
+{
+    /* Shallow structural inspection only.  Assume valid fields... */
+    int ok;
+
+    ok =       (mxGetFieldNumber(faces, "neighbors") >= 0);
+    ok = ok && (mxGetFieldNumber(faces, "nodePos"  ) >= 0);
+    ok = ok && (mxGetFieldNumber(faces, "nodes"    ) >= 0);
+    ok = ok && (mxGetFieldNumber(faces, "areas"    ) >= 0);
+    ok = ok && (mxGetFieldNumber(faces, "centroids") >= 0);
+    ok = ok && (mxGetFieldNumber(faces, "normals"  ) >= 0);
+
+    return ok;
+}
+
+
+/* ------------------------------------------------------------------ */
+static int
+verify_cells_structure(mxArray *cells)
+/* ------------------------------------------------------------------ */
+{
+    /* Shallow structural inspection only.  Assume valid fields... */
+    int ok;
+
+    ok =       (mxGetFieldNumber(cells, "facePos"  ) >= 0);
+    ok = ok && (mxGetFieldNumber(cells, "faces"    ) >= 0);
+    ok = ok && (mxGetFieldNumber(cells, "volumes"  ) >= 0);
+    ok = ok && (mxGetFieldNumber(cells, "centroids") >= 0);
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+verify_grid(const mxArray *G)
+/* ---------------------------------------------------------------------- */
+{
+    int nodes_ok = 0, faces_ok = 0, cells_ok = 0, field_no;
+
+    mxArray *pm;
+
+    if (mxIsStruct(G)) {
+        nodes_ok = mxGetFieldNumber(G, "nodes") >= 0;
+
+        field_no = mxGetFieldNumber(G, "faces");
+        faces_ok = field_no >= 0;
+        if (faces_ok) {
+            pm = mxGetFieldByNumber(G, 0, field_no);
+            faces_ok = verify_faces_structure(pm);
+        }
+
+        field_no = mxGetFieldNumber(G, "cells");
+        cells_ok = field_no >= 0;
+        if (cells_ok) {
+            pm = mxGetFieldByNumber(G, 0, field_no);
+            cells_ok = verify_cells_structure(pm);
+        }
+    }
+
+    return nodes_ok && faces_ok && cells_ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+args_ok(int nlhs, int nrhs, const mxArray *prhs[])
+/* ---------------------------------------------------------------------- */
+{
+    return (nlhs == 5) && (nrhs == 4) && verify_grid(prhs[0]) &&
+        (mxIsDouble(prhs[2]) || mxIsInt32(prhs[2])) &&
+        (mxIsDouble(prhs[3]) || mxIsInt32(prhs[3]));
+}
+
+
+/* ---------------------------------------------------------------------- */
+static mrst_index_t *
+extract_indices(const mxArray *a, mrst_index_t n)
+/* ---------------------------------------------------------------------- */
+{
+    /* One-based indices in [1, n] to zero-based.  NULL if out of range. */
+    size_t        i, m = mxGetNumberOfElements(a);
+    mrst_index_t *q    = mxMalloc((m + 1) * sizeof *q);
+
+    if (mxIsInt32(a)) {
+        const int *p = mxGetData(a);
+        for (i = 0; i < m; ++i) { q[i] = p[i] - 1; }
+    } else {
+        const double *p = mxGetPr(a);
+        for (i = 0; i < m; ++i) {
+            q[i] = ((1 <= p[i]) && (p[i] <= n)) ? (mrst_index_t) p[i] - 1 : -1;
+        }
+    }
+
+    for (i = 0; i < m; ++i) {
+        if ((q[i] < 0) || (q[i] >= n)) {
+            mxFree(q);
+            return NULL;
+        }
+    }
+
+    return q;
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+update_geometry(const mxArray      *G ,
+                const mrst_index_t  nc,
+                const mrst_index_t  nf,
+                const mxArray      *faces,
+                const mxArray      *cells,
+                double             *a ,
+                double             *fc,
+                double             *fn,
+                double             *cc,
+                double             *cv)
+/* ---------------------------------------------------------------------- */
+{
+    mrst_index_t *nodepos, *facenodes, *cellfaces, *facepos, *neighbors;
+    const grid_t *g;
+    mrst_index_t *updfaces, *updcells;
+    int     ok;
+    double *coords, *p;
+
+    updfaces = extract_indices(faces, nf);
+    updcells = extract_indices(cells, nc);
+
+    if ((updfaces == NULL) || (updcells == NULL)) {
+        if (updfaces != NULL) { mxFree(updfaces); }
+        if (updcells != NULL) { mxFree(updcells); }
+
+        return -1;
+    }
+
+    /* Current geometry, updated in place below. */
+    memcpy(a , getFaceAreas  (G), nf * sizeof *a );
+    memcpy(cv, getCellVolumes(G), nc * sizeof *cv);
+
+    p = getFaceCentroids(G);  memcpy(fc, p, 3 * nf * sizeof *fc);  mxFree(p);
+    p = getFaceNormals  (G);  memcpy(fn, p, 3 * nf * sizeof *fn);  mxFree(p);
+    p = getCellCentroids(G);  memcpy(cc, p, 3 * nc * sizeof *cc);  mxFree(p);
+
+    /* Grid topology, cached across calls: */
+    g = mrst_grid_view(G);
+    if (g == NULL) {
+        mexErrMsgTxt("Unable to access grid topology");
+    }
+
+    nodepos   = g->face_nodepos;
+    facenodes = g->face_nodes;
+    cellfaces = g->cell_faces;
+    facepos   = g->cell_facepos;
+    neighbors = g->face_cells;
+    coords    = g->node_coordinates;
+
+    ok = update_geometry_fused(coords, nodepos, facenodes, neighbors,
+                               facepos, cellfaces,
+                               (mrst_index_t) mxGetNumberOfElements(faces),
+                               updfaces,
+                               (mrst_index_t) mxGetNumberOfElements(cells),
+                               updcells,
+                               fn, fc, a, cc, cv);
+
+    mxFree(updfaces); mxFree(updcells);
+
+    return ok;
+}
+
+
+/*
+ * [fa, fc, fn, cc, cv] = mex_update_geometry_para(G, nthreads, faces, cells)
+ */
+/* ---------------------------------------------------------------------- */
+void
+mexFunction(int nlhs,       mxArray *plhs[],
+            int nrhs, const mxArray *prhs[])
+/* ---------------------------------------------------------------------- */
+{
+    mrst_index_t nc, nf;
+    int nd, flag, ok;
+    const mxArray *G;
+    mxArray       *fa, *fc, *fn, *cc, *cv;
+
+    char errmsg[1023 + 1];
+
+    if (args_ok(nlhs, nrhs, prhs)) {
+        G    = prhs[0];
+        flag = (int) mxGetScalar(prhs[1]);
+        if (flag > 0) {
+            omp_set_num_threads(flag);
+        }
+
+        nc = getNumberOfCells(G);
+        nf = getNumberOfFaces(G);
+        nd = getNumberOfDimensions(G);
+
+        if (nd != 3) {
+            mexErrMsgTxt("Sorry, only support for 3D grids.");
+        }
+
+        fa = mxCreateDoubleMatrix(nf,  1, mxREAL); /* Face area */
+        fc = mxCreateDoubleMatrix(nd, nf, mxREAL); /* Face centroid */
+        fn = mxCreateDoubleMatrix(nd, nf, mxREAL); /* Face normal */
+        cc = mxCreateDoubleMatrix(nd, nc, mxREAL); /* Cell centroid */
+        cv = mxCreateDoubleMatrix(nc,  1, mxREAL); /* Cell volume */
+
+        ok = update_geometry(G, nc, nf, prhs[2], prhs[3],
+                             mxGetPr(fa), mxGetPr(fc), mxGetPr(fn),
+                             mxGetPr(cc), mxGetPr(cv));
+
+        if (ok < 0) {
+            mexErrMsgTxt("Face or cell index out of range");
+        } else if (ok == 0) {
+            mexErrMsgTxt("Out of memory in geometry update");
+        }
+
+        plhs[0] = fa;
+        plhs[1] = fc;
+        plhs[2] = fn;
+        plhs[3] = cc;
+        plhs[4] = cv;
+    } else {
+        sprintf(errmsg,
+                "Calling sequence is\n\t"
+                "[fa, fc, fn, cc, cv] = %s(G, nthreads, faces, cells)",
+                mexFunctionName());
+        mexErrMsgTxt(errmsg);
+    }
+}
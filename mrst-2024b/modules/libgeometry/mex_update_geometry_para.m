@@ -0,0 +1,58 @@
+function varargout = mex_update_geometry_para(varargin)
+%Undocumented Utility Function
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   d = fileparts(mfilename('fullpath'));
+
+   CFLAGS = {'CFLAGS="\$CFLAGS','-O3', '-fopenmp', '-Wall', '-Wextra', '-ansi'     , ...
+             '-pedantic', '-Wformat-nonliteral',  '-Wcast-align' , ...
+             '-Wpointer-arith', '-Wbad-function-cast'            , ...
+             '-Wmissing-prototypes', '-Wstrict-prototypes'      , ...
+             '-Wmissing-declarations', '-Winline', '-Wundef'     , ...
+             '-Wnested-externs', '-Wcast-qual', '-Wshadow'       , ...
+             '-Wconversion', '-Wwrite-strings', '-Wno-conversion', ...
+             '-Wchar-subscripts', '-Wredundant-decls"'};
+
+   LDFLAGS = {'LDFLAGS="\$LDFLAGS','-fopenmp"'};
+
+   INCLUDE = { ['-I', fullfile(d, '..', 'mrst_api')] };
+
+   LINK = { };
+
+   OPTS = { '-O', '-largeArrayDims'};
+
+   % 64-bit cell/face/node numbering for very large models.  Must agree
+   % between processgrid_mex and the libgeometry gateways.
+   if ~isempty(getenv('MRST_INDEX_64')),
+      OPTS = [OPTS, { '-DMRST_INDEX_64' }];
+   end
+
+   SRC = { 'mex_update_geometry_para.c', 'geometry_para.c', ...
+           fullfile(d, '..', 'mrst_api', 'mrst_api.c') };
+
+   LIBS = {};
+
+   buildmex(CFLAGS{:}, LDFLAGS{:}, ...
+            INCLUDE{:}, LINK{:}, OPTS{:}, SRC{:}, LIBS{:});
+
+   % Call MEX'ed edition.
+   [varargout{1:nargout}] = mex_update_geometry_para(varargin{:});
+end
@@ -0,0 +1,126 @@
+function [G, adj] = mupdateGeometry(G, nodes, varargin)
+%Update geometric primitives after nodes have moved, using compiled C code.
+%
+% SYNOPSIS:
+%   G        = mupdateGeometry(G, nodes)
+%   [G, adj] = mupdateGeometry(G, nodes, 'pn1', pv1, ...)
+%
+% PARAMETERS:
+%   G     - A grid_structure with geometry (e.g., from mcomputeGeometry)
+%           in which the coordinates 'G.nodes.coords' of some nodes have
+%           been changed.
+%
+%   nodes - Indices, or logical mask, of the nodes that have moved.
+%
+% OPTIONAL PARAMETERS:
+%   adjacency - Node-to-face adjacency returned as 'adj' from a previous
+%               call for the same grid topology.  Computed if empty.
+%               DEFAULT: [].
+%
+%   nthreads  - Number of OpenMP threads.  Zero retains the current
+%               setting.  DEFAULT: 0.
+%
+% RETURNS:
+%   G   - Grid with updated areas, normals and centroids of all faces
+%         touching the moved nodes, and volumes and centroids of the
+%         neighbouring cells.  All other entries are left unchanged.
+%
+%   adj - Node-to-face adjacency.  Pass as option 'adjacency' to avoid
+%         recomputing it in subsequent updates of the same grid, for
+%         instance in every step of a coupled compaction simulation.
+%
+% EXAMPLE:
+%   G   = mcomputeGeometry(cartGrid([10, 10, 10]));
+%   adj = [];
+%   for step = 1 : 10
+%      top = find(G.nodes.coords(:,3) == 0);
+%      G.nodes.coords(top, 3) = G.nodes.coords(top, 3) + 0.01;
+%      [G, adj] = mupdateGeometry(G, top, 'adjacency', adj);
+%   end
+%
+% SEE ALSO:
+%   `mcomputeGeometry`, `mcomputeGeometry_para`, `computeGeometry`.
+
+%{
+Copyright 2009-2024 SINTEF Digital, Mathematics & Cybernetics.
+
+This file is part of The MATLAB Reservoir Simulation Toolbox (MRST).
+
+MRST is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+MRST is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with MRST.  If not, see <http://www.gnu.org/licenses/>.
+%}
+
+   opt = struct('adjacency', [], 'nthreads', 0);
+   opt = merge_options(opt, varargin{:});
+
+   if size(G.nodes.coords, 2) ~= 3
+      error(['Function ''%s'' is only supported in three ', ...
+             'space dimensions.'], mfilename);
+   end
+
+   if ~(isfield(G.faces, 'areas') && isfield(G.cells, 'volumes'))
+      error('Geometry:Missing', ...
+           ['Grid has no geometry.  Use ''mcomputeGeometry'' to ', ...
+            'compute the initial geometry.']);
+   end
+
+   adj = opt.adjacency;
+   if isempty(adj)
+      adj = node_face_adjacency(G);
+   end
+
+   if islogical(nodes)
+      nodes = find(nodes);
+   end
+   nodes = reshape(nodes, [], 1);
+
+   faces = adj.faces(mcolon(adj.facePos(nodes), adj.facePos(nodes + 1) - 1));
+   faces = unique(faces);
+
+   cells = G.faces.neighbors(faces, :);
+   cells = unique(cells(cells > 0));
+
+   if isempty(faces)
+      return
+   end
+
+   [fa, fc, fn, cc, cv] = ...
+      mex_update_geometry_para(G, opt.nthreads, faces, cells);
+
+   if ~ all(fa(faces) > 0)
+      warning(msgid('FaceAre:NonPositive'), ...
+              'Face area negative or zero');
+   end
+   if ~ all(cv(cells) > 0)
+      warning(msgid('CellVolume:NonPositive'), ...
+              'Cell volume negative or zero');
+   end
+
+   G.faces.areas     = fa;
+   G.faces.centroids = fc .';
+   G.faces.normals   = fn .';
+   G.cells.centroids = cc .';
+   G.cells.volumes   = cv;
+end
+
+%--------------------------------------------------------------------------
+
+function adj = node_face_adjacency(G)
+   % Faces touching each node: adj.faces(adj.facePos(n) : adj.facePos(n+1)-1)
+   f = rldecode((1 : G.faces.num) .', diff(G.faces.nodePos));
+
+   [n, i] = sort(G.faces.nodes);
+
+   adj = struct('facePos', cumsum([1; accumarray(n, 1, [G.nodes.num, 1])]), ...
+                'faces',   f(i));
+end
@@ -20,6 +20,28 @@
 #ifndef OPM_GRID_HEADER_INCLUDED
 #define OPM_GRID_HEADER_INCLUDED
 
+#include <limits.h>
+#include <stddef.h>
+
+#ifndef MRST_INDEX_T_DEFINED
+#define MRST_INDEX_T_DEFINED
+/*
+ * Type of cell, face and node numbers, of counts and of offsets into
+ * index arrays.  Plain int by default, which halves the size of the
+ * topology arrays.  Define MRST_INDEX_64 when building to process
+ * models whose number of face nodes (about 24 per cell) exceeds INT_MAX.
+ * Must match the definition in deckformat's preprocess.h.
+ */
+#ifdef MRST_INDEX_64
+typedef ptrdiff_t mrst_index_t;
+#define MRST_INDEX_MAX ((mrst_index_t) (((size_t) -1) >> 1))
+#else
+typedef int       mrst_index_t;
+#define MRST_INDEX_MAX INT_MAX
+#endif
+#define MRST_INDEX_MIN (-MRST_INDEX_MAX - 1)
+#endif /* MRST_INDEX_T_DEFINED */
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,16 +51,16 @@ extern "C" {
 struct UnstructuredGrid {
     int    dimensions;
 
-    int    number_of_cells;
-    int    number_of_faces;
-    int    number_of_nodes;
+    mrst_index_t  number_of_cells;
+    mrst_index_t  number_of_faces;
+    mrst_index_t  number_of_nodes;
 
-    int    *face_nodes;
-    int    *face_nodepos;
-    int    *face_cells;
+    mrst_index_t *face_nodes;
+    mrst_index_t *face_nodepos;
+    mrst_index_t *face_cells;
 
-    int    *cell_faces;
-    int    *cell_facepos;
+    mrst_index_t *cell_faces;
+    mrst_index_t *cell_facepos;
 
     double *node_coordinates;
 
@@ -50,7 +72,7 @@ struct UnstructuredGrid {
     double *cell_volumes;
 
 
-    int    *global_cell;
+    mrst_index_t *global_cell;
 
     int     cartdims[3];
     int    *cell_facetag;
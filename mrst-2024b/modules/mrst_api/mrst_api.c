@@ -1,6 +1,7 @@
 /* "API" */
 
 #include <stddef.h>
+#include <string.h>
 
 #include <mex.h>
 #include "grid.h"
@@ -34,12 +35,12 @@ getField(const mxArray *a, const char *field, const char *subfield)
 }
 
 /* ------------------------------------------------------------------ */
-static int *
+static mrst_index_t *
 extractIntMatrix(const mxArray *a)
 /* ------------------------------------------------------------------ */
 {
-    size_t  n = mxGetNumberOfElements(a);
-    int    *q = mxMalloc(n * sizeof *q);
+    size_t        n = mxGetNumberOfElements(a);
+    mrst_index_t *q = mxMalloc(n * sizeof *q);
     if (q != NULL) {
         if (mxIsInt32(a)) {
             int *p = mxGetData(a);
@@ -51,9 +52,9 @@ extractIntMatrix(const mxArray *a)
             double *p = mxGetPr(a);
             size_t i;
             for (i=0; i<n; ++i) {
-                mxAssert ((1 <= p[i]) && (p[i] <= INT_MAX),
-                          "Matrix entry exceeds INT_MAX");
-                q[i] = p[i]-1;
+                mxAssert ((1 <= p[i]) && (p[i] <= MRST_INDEX_MAX),
+                          "Matrix entry exceeds MRST_INDEX_MAX");
+                q[i] = (mrst_index_t) p[i]-1;
             }
         }
     }
@@ -62,15 +63,15 @@ extractIntMatrix(const mxArray *a)
 }
 
 /* ------------------------------------------------------------------ */
-static int *
+static mrst_index_t *
 extractIntMatrixTranspose(const mxArray *a)
 /* ------------------------------------------------------------------ */
 {
-    int *p = extractIntMatrix(a);
+    mrst_index_t *p = extractIntMatrix(a);
     size_t M = mxGetM(a);
     size_t N = mxGetN(a);
 
-    int *q = mxMalloc(M * N * sizeof *q);
+    mrst_index_t *q = mxMalloc(M * N * sizeof *q);
     if (q != NULL) {
         size_t i,j;
         for(i=0; i<M; ++i) {
@@ -155,7 +156,7 @@ getLocal2GlobalCellMap(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int
+mrst_index_t
 getNumberOfNodes(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -193,7 +194,7 @@ getNodeCoordinates(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int
+mrst_index_t
 getNumberOfFaces(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -201,7 +202,7 @@ getNumberOfFaces(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int *
+mrst_index_t *
 getFaceNodePos(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -209,7 +210,7 @@ getFaceNodePos(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int
+mrst_index_t
 getNumberOfFaceNodes(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -217,7 +218,7 @@ getNumberOfFaceNodes(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int *
+mrst_index_t *
 getFaceNodes(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -226,7 +227,7 @@ getFaceNodes(const mxArray *G)
 
 
 /* ------------------------------------------------------------------ */
-int *
+mrst_index_t *
 getFaceCellNeighbors(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -276,7 +277,7 @@ getFaceCentroids(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int
+mrst_index_t
 getNumberOfCells(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
@@ -284,21 +285,21 @@ getNumberOfCells(const mxArray *G)
 }
 
 /* ------------------------------------------------------------------ */
-int *getCellFacePos(const mxArray *G)
+mrst_index_t *getCellFacePos(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
     return extractIntMatrix(getField(G, "cells", "facePos"));
 }
 
 /* ------------------------------------------------------------------ */
-int getNumberOfCellFaces(const mxArray *G)
+mrst_index_t getNumberOfCellFaces(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
     return mxGetM(getField(G, "cells", "faces"));
 }
 
 /* ------------------------------------------------------------------ */
-int *getCellFaces(const mxArray *G)
+mrst_index_t *getCellFaces(const mxArray *G)
 /* ------------------------------------------------------------------ */
 {
     return extractIntMatrix(getField(G, "cells", "faces"));
@@ -570,6 +571,292 @@ mrst_grid_topology(const mxArray *G)
     return g;
 }
 
+/*
+ * Cached, read-only grid view.
+ *
+ * mrst_grid() copies and converts the topology of the grid on every call.
+ * mrst_grid_view() converts each topology field once and keeps the result
+ * across calls of the MEX function.  A cached conversion is reused if the
+ * source field is the same mxArray, with the same data pointer, class and
+ * size, and the same version, a hash of its entire contents.  Hashing
+ * reads each topology field once per call, which is cheaper than
+ * converting it again (no allocation, no stores), and catches topology
+ * that MATLAB code has edited in place.  Coordinates and centroids are
+ * transposed into their persistent buffers on every call.  Double
+ * precision vectors (face areas, cell volumes) already have the required
+ * layout and point into MATLAB's data.
+ */
+
+enum view_field_id {
+    VIEW_NODE_COORDINATES,
+    VIEW_FACE_NODEPOS, VIEW_FACE_NODES, VIEW_FACE_CELLS,
+    VIEW_CELL_FACEPOS, VIEW_CELL_FACES,
+    VIEW_FACE_CENTROIDS, VIEW_FACE_NORMALS, VIEW_CELL_CENTROIDS,
+    VIEW_NUMBER_OF_FIELDS
+};
+
+struct view_field {
+    const mxArray     *src;      /* Identity of source field */
+    const void        *data;
+    size_t             m, n;
+    mxClassID          cls;
+    unsigned int       version;  /* Hash of source contents */
+    void              *buf;      /* Converted data, persistent */
+};
+
+static struct view_field view_fields[VIEW_NUMBER_OF_FIELDS];
+static grid_t            view_grid;
+static int               view_exit_registered = 0;
+
+
+/* ------------------------------------------------------------------ */
+static mxArray *
+findField(const mxArray *G, const char *field, const char *subfield)
+/* ------------------------------------------------------------------ */
+{
+    /* Like getField(), but NULL rather than an error if missing. */
+    mxArray *b = mxGetField(G, 0, field);
+
+    return (b != NULL) ? mxGetField(b, 0, subfield) : NULL;
+}
+
+
+/* ------------------------------------------------------------------ */
+static unsigned int
+content_version(const mxArray *a)
+/* ------------------------------------------------------------------ */
+{
+    /* 32-bit FNV-1a over all data words. */
+    const unsigned int prime = 16777619U;
+
+    const unsigned int *w = mxGetData(a);
+    size_t nw = (mxGetNumberOfElements(a) * mxGetElementSize(a)) / sizeof *w;
+    size_t i;
+    unsigned int version = 2166136261U;
+
+    for (i = 0; i < nw; ++i) {
+        version = (version ^ w[i]) * prime;
+    }
+
+    return version;
+}
+
+
+/* ------------------------------------------------------------------ */
+static void
+release_view_field(struct view_field *vf)
+/* ------------------------------------------------------------------ */
+{
+    if (vf->buf != NULL) { mxFree(vf->buf); }
+
+    vf->src  = NULL;
+    vf->data = NULL;
+    vf->buf  = NULL;
+}
+
+
+/* ------------------------------------------------------------------ */
+void
+mrst_grid_view_release(void)
+/* ------------------------------------------------------------------ */
+{
+    int i;
+
+    for (i = 0; i < VIEW_NUMBER_OF_FIELDS; ++i) {
+        release_view_field(&view_fields[i]);
+    }
+}
+
+
+/* ------------------------------------------------------------------ */
+static int
+view_field_current(struct view_field *vf, const mxArray *a,
+                   unsigned int version)
+/* ------------------------------------------------------------------ */
+{
+    return (vf->buf     != NULL)            &&
+           (vf->src     == a)               &&
+           (vf->data    == mxGetData(a))    &&
+           (vf->m       == mxGetM(a))       &&
+           (vf->n       == mxGetN(a))       &&
+           (vf->cls     == mxGetClassID(a)) &&
+           (vf->version == version);
+}
+
+
+/* ------------------------------------------------------------------ */
+static void *
+view_field_store(struct view_field *vf, const mxArray *a,
+                 unsigned int version, size_t nbytes)
+/* ------------------------------------------------------------------ */
+{
+    release_view_field(vf);
+
+    vf->buf = mxMalloc(nbytes > 0 ? nbytes : 1);
+    if (vf->buf != NULL) {
+        mexMakeMemoryPersistent(vf->buf);
+
+        vf->src     = a;
+        vf->data    = mxGetData(a);
+        vf->m       = mxGetM(a);
+        vf->n       = mxGetN(a);
+        vf->cls     = mxGetClassID(a);
+        vf->version = version;
+    }
+
+    return vf->buf;
+}
+
+
+/* ------------------------------------------------------------------ */
+static mrst_index_t *
+viewIntMatrix(struct view_field *vf, const mxArray *a, size_t cols,
+              int transpose)
+/* ------------------------------------------------------------------ */
+{
+    /* One-based indices in the first 'cols' columns of 'a' to zero-based,
+     * optionally transposed to row major order. */
+    unsigned int version = content_version(a);
+    size_t  M = mxGetM(a), N = mxGetN(a), i, j, k;
+    mrst_index_t *q;
+
+    if (view_field_current(vf, a, version)) {
+        return vf->buf;
+    }
+
+    if ((! mxIsInt32(a)) && (! mxIsDouble(a))) {
+        return NULL;
+    }
+
+    if (cols < N) { N = cols; }
+
+    q = view_field_store(vf, a, version, M * N * sizeof *q);
+
+    if (q != NULL) {
+        for (j = 0; j < N; ++j) {
+            for (i = 0; i < M; ++i) {
+                k = transpose ? (i*N + j) : (i + M*j);
+
+                if (mxIsInt32(a)) {
+                    q[k] = ((const int *) mxGetData(a))[i + M*j] - 1;
+                } else {
+                    q[k] = (mrst_index_t) mxGetPr(a)[i + M*j] - 1;
+                }
+            }
+        }
+    }
+
+    return q;
+}
+
+
+/* ------------------------------------------------------------------ */
+static double *
+viewDoubleMatrixTranspose(struct view_field *vf, const mxArray *a)
+/* ------------------------------------------------------------------ */
+{
+    size_t  M = mxGetM(a), N = mxGetN(a), i, j;
+    double *p, *q;
+
+    if ((M == 1) || (N == 1)) {
+        /* Layout already matches.  Use MATLAB's data directly. */
+        return mxGetPr(a);
+    }
+
+    /* Values may have changed in place, so always transpose.  Only the
+     * buffer is reused. */
+    if ((vf->buf != NULL) && (vf->m == M) && (vf->n == N)) {
+        q = vf->buf;
+    } else {
+        q = view_field_store(vf, a, 0U, M * N * sizeof *q);
+    }
+
+    if (q != NULL) {
+        p = mxGetPr(a);
+        for (i = 0; i < M; ++i) {
+            for (j = 0; j < N; ++j) {
+                q[i*N + j] = p[i + M*j];
+            }
+        }
+    }
+
+    return q;
+}
+
+
+/* ---------------------------------------------------------------------- */
+const grid_t *
+mrst_grid_view(const mxArray *G)
+/* ---------------------------------------------------------------------- */
+{
+    mxArray *a;
+    grid_t  *g = &view_grid;
+
+    if (! view_exit_registered) {
+        mexAtExit(mrst_grid_view_release);
+        view_exit_registered = 1;
+    }
+
+    g->dimensions      = getNumberOfDimensions(G);
+    g->number_of_cells = getNumberOfCells     (G);
+    g->number_of_faces = getNumberOfFaces     (G);
+    g->number_of_nodes = getNumberOfNodes     (G);
+
+    /* Topology */
+    g->node_coordinates =
+        viewDoubleMatrixTranspose(&view_fields[VIEW_NODE_COORDINATES],
+                                  getField(G, "nodes", "coords"));
+    g->face_nodepos =
+        viewIntMatrix(&view_fields[VIEW_FACE_NODEPOS],
+                      getField(G, "faces", "nodePos"), (size_t) -1, 0);
+    g->face_nodes =
+        viewIntMatrix(&view_fields[VIEW_FACE_NODES],
+                      getField(G, "faces", "nodes"), (size_t) -1, 0);
+    g->face_cells =
+        viewIntMatrix(&view_fields[VIEW_FACE_CELLS],
+                      getField(G, "faces", "neighbors"), (size_t) -1, 1);
+    g->cell_facepos =
+        viewIntMatrix(&view_fields[VIEW_CELL_FACEPOS],
+                      getField(G, "cells", "facePos"), (size_t) -1, 0);
+
+    /* Face column only, not the tags of cells.faces(:,2) */
+    g->cell_faces =
+        viewIntMatrix(&view_fields[VIEW_CELL_FACES],
+                      getField(G, "cells", "faces"), 1, 0);
+
+    if ((g->node_coordinates == NULL) || (g->face_nodepos == NULL) ||
+        (g->face_nodes       == NULL) || (g->face_cells   == NULL) ||
+        (g->cell_facepos     == NULL) || (g->cell_faces   == NULL)) {
+        mrst_grid_view_release();
+        return NULL;
+    }
+
+    /* Geometry, if present */
+    a = findField(G, "faces", "areas");
+    g->face_areas     = (a != NULL) ? mxGetPr(a) : NULL;
+
+    a = findField(G, "cells", "volumes");
+    g->cell_volumes   = (a != NULL) ? mxGetPr(a) : NULL;
+
+    a = findField(G, "faces", "centroids");
+    g->face_centroids = (a == NULL) ? NULL :
+        viewDoubleMatrixTranspose(&view_fields[VIEW_FACE_CENTROIDS], a);
+
+    a = findField(G, "faces", "normals");
+    g->face_normals   = (a == NULL) ? NULL :
+        viewDoubleMatrixTranspose(&view_fields[VIEW_FACE_NORMALS], a);
+
+    a = findField(G, "cells", "centroids");
+    g->cell_centroids = (a == NULL) ? NULL :
+        viewDoubleMatrixTranspose(&view_fields[VIEW_CELL_CENTROIDS], a);
+
+    g->global_cell  = NULL;
+    g->cell_facetag = NULL;
+    g->cartdims[0]  = g->cartdims[1] = g->cartdims[2] = 0;
+
+    return g;
+}
+
 /* Local Variables:    */
 /* c-basic-offset:4    */
 /* End:                */
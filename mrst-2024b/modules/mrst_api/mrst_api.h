@@ -19,15 +19,15 @@ int  getNumberOfDimensions (const mxArray *G);
 void getLocal2GlobalCellMap(const mxArray *G);
 
 /* Node coordinates */
-int     getNumberOfNodes      (const mxArray *G);
-double *getNodeCoordinates(const mxArray *G); /* copy */
+mrst_index_t  getNumberOfNodes      (const mxArray *G);
+double       *getNodeCoordinates(const mxArray *G); /* copy */
 
 /* Face topology */
-int     getNumberOfFaces      (const mxArray *G);
-int     getNumberOfFaceNodes  (const mxArray *G);
-int    *getFaceNodePos        (const mxArray *G);    /* copy */
-int    *getFaceNodes          (const mxArray *G);    /* copy */
-int    *getFaceCellNeighbors  (const mxArray *G);    /* copy */
+mrst_index_t  getNumberOfFaces      (const mxArray *G);
+mrst_index_t  getNumberOfFaceNodes  (const mxArray *G);
+mrst_index_t *getFaceNodePos        (const mxArray *G);    /* copy */
+mrst_index_t *getFaceNodes          (const mxArray *G);    /* copy */
+mrst_index_t *getFaceCellNeighbors  (const mxArray *G);    /* copy */
 
 /* Face geometry */
 double *getFaceAreas          (const mxArray *G);
@@ -35,10 +35,10 @@ double *getFaceNormals        (const mxArray *G);    /* copy */
 double *getFaceCentroids      (const mxArray *G);    /* copy */
 
 /* Cell topology */
-int     getNumberOfCells      (const mxArray *G);
-int     getNumberOfCellFaces  (const mxArray *G);
-int    *getCellFacePos        (const mxArray *G);    /* copy */
-int    *getCellFaces          (const mxArray *G);    /* copy */
+mrst_index_t  getNumberOfCells      (const mxArray *G);
+mrst_index_t  getNumberOfCellFaces  (const mxArray *G);
+mrst_index_t *getCellFacePos        (const mxArray *G);    /* copy */
+mrst_index_t *getCellFaces          (const mxArray *G);    /* copy */
 
 /* Cell geometry */
 double *getCellVolumes        (const mxArray *G);
@@ -55,6 +55,13 @@ grid_t *mrst_grid(const mxArray *G);
 grid_t *mrst_grid_topology(const mxArray *G);
 void    free_mrst_grid(grid_t *g);
 
+/* Cached, read-only view of the grid.  Owned by mrst_api.  Valid until
+ * the next call or mrst_grid_view_release(), which is also registered
+ * with mexAtExit().  Topology edited in place is detected and converted
+ * again.  NULL on failure. */
+const grid_t *mrst_grid_view(const mxArray *G);
+void          mrst_grid_view_release(void);
+
 int verify_mrst_grid(const mxArray *G);
 
 
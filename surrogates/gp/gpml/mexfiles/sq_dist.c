@@ -1,5 +1,5 @@
 /* sq_dist - a mex function to compute a matrix of all pairwise squared
-   distances between two sets of vectors, stored in the columns of the two 
+   distances between two sets of vectors, stored in the columns of the two
    matrices that are arguments to the function. The length of the vectors must
    agree. If only a single argument is given, the missing argument is taken to
    be identical to the first. If an optional third matrix argument Q is given,
@@ -7,48 +7,243 @@
    traces of the product of Q and the coordinatewise squared distances is
    returned.
 
-   Copyright (c) 2003, 2004 Carl Edward Rasmussen. 2003-04-22. */
- 
+   Copyright (c) 2003, 2004 Carl Edward Rasmussen. 2003-04-22.
+
+   The distances are computed on tiles of TILE_M x TILE_N output entries from
+   a transposed copy of a, so that the innermost loop runs down a column of C
+   (and Q) and vectorises. Tiles are distributed over OpenMP threads, and for
+   sq_dist(a) only the upper triangle is computed and then mirrored. This
+   exact-difference path gives the same result as the original triple loop.
+
+   When compiled with -DUSE_BLAS and D >= SQ_DIST_GEMM_D, C is instead formed
+   as |a_i|^2 + |b_j|^2 - 2 a_i'b_j with a single dgemm. The columns are
+   centred first to limit cancellation, negative round-off is clamped to
+   zero, and the diagonal of sq_dist(a) is exactly zero, but entries for
+   nearby points then carry an absolute error of order eps*|a_i - mean|^2.
+
+   Build (OpenMP is optional):
+     mex -O CFLAGS="\$CFLAGS -fopenmp" LDFLAGS="\$LDFLAGS -fopenmp" ...
+         -output gpml_sq_dist sq_dist.c [-DUSE_BLAS -lmwblas] */
+
 #include "mex.h"
 #include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef USE_BLAS
+#include "blas.h"
+#endif
+
+#define TILE_M 256
+#define TILE_N 32
+#define SMALL_D 16
+#ifndef SQ_DIST_GEMM_D
+#define SQ_DIST_GEMM_D 64
+#endif
+
+/* at = a' (m x D, column major) from a (D x m) */
+static void transpose(const double *a, double *at, ptrdiff_t D, ptrdiff_t m)
+{
+  ptrdiff_t i, k;
+#pragma omp parallel for private(k) schedule(static)
+  for (i=0; i<m; i++) for (k=0; k<D; k++) at[i+k*m] = a[k+i*D];
+}
+
+/* Copy the upper triangle of the square matrix C to its lower triangle */
+static void mirror_upper(double *C, ptrdiff_t m)
+{
+  ptrdiff_t i, j, jb, je;
+#pragma omp parallel for private(i, j, je) schedule(dynamic, 1)
+  for (jb=0; jb<m; jb+=TILE_N) {
+    je = jb+TILE_N < m ? jb+TILE_N : m;
+    for (i=jb; i<m; i++) for (j=jb; j<je && j<i; j++) C[i+j*m] = C[j+i*m];
+  }
+}
+
+/* C[i+j*m] = sum_k (a_ki - b_kj)^2 on the tile (ib, jb). at is a' (m x D).
+   With upper set, only entries with i <= j are written. */
+static void tile_exact(const double *at, const double *b, double *C, ptrdiff_t D,
+                       ptrdiff_t m, ptrdiff_t n, ptrdiff_t ib, ptrdiff_t jb, int upper)
+{
+  ptrdiff_t i, j, k, ie, je;
+  double bk, t, z, *c;
+  const double *ak;
+  je = jb+TILE_N < n ? jb+TILE_N : n;
+  for (j=jb; j<je; j++) {
+    ie = ib+TILE_M < m ? ib+TILE_M : m;
+    if (upper && ie > j+1) ie = j+1;
+    if (ie <= ib) continue;
+    c = C+j*m;
+    if (D <= SMALL_D) {
+      /* Keep the sums in registers, one lane per row */
+      const double *bj = b+j*D;
+#pragma omp simd private(k, t, z)
+      for (i=ib; i<ie; i++) {
+        z = 0.0;
+        for (k=0; k<D; k++) { t = at[i+k*m] - bj[k]; z += t*t; }
+        c[i] = z;
+      }
+      continue;
+    }
+    for (i=ib; i<ie; i++) c[i] = 0.0;
+    for (k=0; k<D; k++) {
+      bk = b[k+j*D];
+      ak = at+k*m;
+#pragma omp simd private(t)
+      for (i=ib; i<ie; i++) { t = ak[i] - bk; c[i] += t*t; }
+    }
+  }
+}
+
+static void sq_dist_exact(const double *a, const double *b, double *C, ptrdiff_t D,
+                          ptrdiff_t m, ptrdiff_t n, int sym)
+{
+  ptrdiff_t t, nbm = (m+TILE_M-1)/TILE_M, nbn = (n+TILE_N-1)/TILE_N;
+  double *at = mxMalloc((m*D > 0 ? m*D : 1)*sizeof(double));
+  transpose(a, at, D, m);
+#pragma omp parallel for schedule(dynamic, 1)
+  for (t=0; t<nbm*nbn; t++) {
+    ptrdiff_t ib = (t%nbm)*TILE_M, jb = (t/nbm)*TILE_N;
+    if (!sym || ib <= jb+TILE_N-1)
+      tile_exact(at, b, C, D, m, n, ib, jb, sym);
+  }
+  mxFree(at);
+  if (sym) mirror_upper(C, m);
+}
+
+#ifdef USE_BLAS
+/* Norm expansion through dgemm on columns centred by the mean of a and b */
+static void sq_dist_gemm(const double *a, const double *b, double *C, ptrdiff_t D,
+                         ptrdiff_t m, ptrdiff_t n, int sym)
+{
+  ptrdiff_t i, j, k;
+  double *mu, *ac, *bc, *na, *nb, s, minus2 = -2.0, zero = 0.0;
+  mu = mxCalloc(D, sizeof(double));
+  ac = mxMalloc(D*m*sizeof(double));
+  na = mxMalloc(m*sizeof(double));
+  bc = sym ? ac : mxMalloc(D*n*sizeof(double));
+  nb = sym ? na : mxMalloc(n*sizeof(double));
+  for (i=0; i<m; i++) for (k=0; k<D; k++) mu[k] += a[k+i*D];
+  if (!sym) for (j=0; j<n; j++) for (k=0; k<D; k++) mu[k] += b[k+j*D];
+  for (k=0; k<D; k++) mu[k] /= sym ? m : m+n;
+#pragma omp parallel for private(k, s) schedule(static)
+  for (i=0; i<m; i++) {
+    s = 0.0;
+    for (k=0; k<D; k++) { ac[k+i*D] = a[k+i*D]-mu[k]; s += ac[k+i*D]*ac[k+i*D]; }
+    na[i] = s;
+  }
+  if (!sym) {
+#pragma omp parallel for private(k, s) schedule(static)
+    for (j=0; j<n; j++) {
+      s = 0.0;
+      for (k=0; k<D; k++) { bc[k+j*D] = b[k+j*D]-mu[k]; s += bc[k+j*D]*bc[k+j*D]; }
+      nb[j] = s;
+    }
+  }
+  dgemm("T", "N", &m, &n, &D, &minus2, ac, &D, bc, &D, &zero, C, &m);
+#pragma omp parallel for private(i, s) schedule(static)
+  for (j=0; j<n; j++) for (i=0; i<m; i++) {
+    s = C[i+j*m] + na[i] + nb[j];
+    C[i+j*m] = s > 0.0 ? s : 0.0;
+  }
+  if (sym) {
+    for (i=0; i<m; i++) C[i+i*m] = 0.0;
+    mirror_upper(C, m);
+  } else {
+    mxFree(bc);
+    mxFree(nb);
+  }
+  mxFree(mu);
+  mxFree(ac);
+  mxFree(na);
+}
+#endif
+
+/* c_k = sum_ij Q_ij (a_ki - b_kj)^2. Each thread accumulates its own row of
+   acc over a static share of the columns j of Q, running down Q(:,j) and
+   at(:,k) together. The rows are then summed in thread order, so that the
+   result does not vary between runs with the same number of threads. */
+static void sq_dist_q(const double *a, const double *b, const double *Q, double *C,
+                      ptrdiff_t D, ptrdiff_t m, ptrdiff_t n)
+{
+  ptrdiff_t k, p, nt = 1;
+  double *at = mxMalloc((m*D > 0 ? m*D : 1)*sizeof(double)), *acc;
+#ifdef _OPENMP
+  nt = omp_get_max_threads();
+#endif
+  acc = mxCalloc(nt*(D > 0 ? D : 1), sizeof(double));
+  transpose(a, at, D, m);
+#pragma omp parallel num_threads(nt)
+  {
+    ptrdiff_t i, j, ib, ie, kk;
+    double bk, s, t, *acc_t = acc;
+    const double *ak, *q;
+#ifdef _OPENMP
+    acc_t = acc + omp_get_thread_num()*D;
+#endif
+#pragma omp for schedule(static)
+    for (j=0; j<n; j++) {
+      q = Q+j*m;
+      for (ib=0; ib<m; ib+=TILE_M) {
+        ie = ib+TILE_M < m ? ib+TILE_M : m;
+        for (kk=0; kk<D; kk++) {
+          bk = b[kk+j*D];
+          ak = at+kk*m;
+          s = 0.0;
+#pragma omp simd private(t) reduction(+:s)
+          for (i=ib; i<ie; i++) { t = ak[i] - bk; s += q[i]*t*t; }
+          acc_t[kk] += s;
+        }
+      }
+    }
+  }
+  for (k=0; k<D; k++) {
+    C[k] = 0.0;
+    for (p=0; p<nt; p++) C[k] += acc[k+p*D];
+  }
+  mxFree(acc);
+  mxFree(at);
+}
+
 void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
 {
-  double *a, *b, *C, *Q, z, t;
-  int    D, n, m, i, j, k;
+  double *a, *b, *C, *Q;
+  ptrdiff_t D, n, m;
+  int sym;
   if (nrhs < 1 || nrhs > 3 || nlhs > 1)
     mexErrMsgTxt("Usage: C = sq_dist(a,b)\n       or: C = sq_dist(a)\n       or: c = sq_dist(a,b,Q)\nwhere the b matrix may be empty.");
   a = mxGetPr(prhs[0]);
   m = mxGetN(prhs[0]);
   D = mxGetM(prhs[0]);
-  if (nrhs == 1 || mxIsEmpty(prhs[1])) {
+  sym = nrhs == 1 || mxIsEmpty(prhs[1]);
+  if (sym) {
     b = a;
     n = m;
   } else {
     b = mxGetPr(prhs[1]);
     n = mxGetN(prhs[1]);
-    if (D != mxGetM(prhs[1]))
+    if (D != (ptrdiff_t)mxGetM(prhs[1]))
       mexErrMsgTxt("Error: column lengths must agree");
   }
   if (nrhs < 3) {
     plhs[0] = mxCreateDoubleMatrix(m, n, mxREAL);
     C = mxGetPr(plhs[0]);
-    for (i=0; i<m; i++) for (j=0; j<n; j++) {
-      z = 0.0;
-      for (k=0; k<D; k++) { t = a[D*i+k] - b[D*j+k]; z += t*t; }
-      C[i+j*m] = z;
+    if (m == 0 || n == 0) return;
+#ifdef USE_BLAS
+    if (D >= SQ_DIST_GEMM_D) {
+      sq_dist_gemm(a, b, C, D, m, n, sym);
+      return;
     }
+#endif
+    sq_dist_exact(a, b, C, D, m, n, sym);
   } else {
     Q = mxGetPr(prhs[2]);
-    if (mxGetN(prhs[2]) != n || mxGetM(prhs[2]) != m)
+    if ((ptrdiff_t)mxGetN(prhs[2]) != n || (ptrdiff_t)mxGetM(prhs[2]) != m)
 	mexErrMsgTxt("Error: 3rd matrix argument has wrong dimensions");
     plhs[0] = mxCreateDoubleMatrix(D, 1, mxREAL);
     C = mxGetPr(plhs[0]);
-    for (k=0; k<D; k++) C[k] = 0.0;
-    for (i=0; i<m; i++) for (j=0; j<n; j++) {
-      t = Q[i+j*m];
-      for (k=0; k<D; k++) {
-        z = a[i*D+k] - b[j*D+k]; C[k] += t*z*z;
-      }
-    }
+    sq_dist_q(a, b, Q, C, D, m, n);
   }
 }
@@ -0,0 +1,64 @@
+classdef RBFModel < handle
+%RBFMODEL  RBF interpolant for a growing set of centres
+%
+% Call:   M = RBFModel(X, Y)
+%         M = RBFModel(X, Y, bf_type, bf_c, usePolyPart, reg)
+%         M = RBFModel(..., 'refit', k)
+%
+% Input as for MY_RBFBUILD (bf_type 'BH', 'CUB', 'TPS', 'MQ', 'IMQ' or 'G',
+% defaults 'MQ', 1, 0) with the diagonal regularisation reg (default
+% 1e-6). APPEND borders the factorisation of the interpolation system
+% instead of solving it again, O(n^2) per centre; with k > 0 the system is
+% factorised from scratch after every k appended centres.
+%
+% Methods
+%   M.append(X, Y)           add the centres in the rows of X
+%   Yq = M.predict(Xq)       interpolant at the rows of Xq
+%   [coefs, meanY] = M.coefficients()   [lambda; gamma] as in MY_RBFBUILD
+%   n = M.size()             number of centres
+%
+% Uses the compiled engine, see BUILDRBFMEX.
+
+properties (SetAccess = private)
+    handle = []
+end
+
+methods
+    function M = RBFModel(X, Y, varargin)
+        args = {'MQ', 1, 0, 1e-6};
+        k = find(strcmpi(varargin, 'refit'), 1);
+        if isempty(k), k = numel(varargin) + 1; end
+        args(1:k-1) = varargin(1:k-1);
+        opt = struct('refit', 0);
+        for i = k:2:numel(varargin)
+            opt.(lower(varargin{i})) = varargin{i+1};
+        end
+        if exist('rbfmodel_mex', 'file') ~= 3
+            error('RBFModel needs rbfmodel_mex, run buildRBFMex');
+        end
+        M.handle = rbfmodel_mex('new', X, Y, args{:}, opt.refit);
+    end
+
+    function append(M, X, Y)
+        rbfmodel_mex('append', M.handle, X, Y);
+    end
+
+    function Yq = predict(M, Xq)
+        Yq = rbfmodel_mex('predict', M.handle, Xq);
+    end
+
+    function [coefs, meanY] = coefficients(M)
+        [coefs, meanY] = rbfmodel_mex('coefs', M.handle);
+    end
+
+    function n = size(M)
+        n = rbfmodel_mex('size', M.handle);
+    end
+
+    function delete(M)
+        if ~isempty(M.handle) && exist('rbfmodel_mex', 'file') == 3
+            rbfmodel_mex('delete', M.handle);
+        end
+    end
+end
+end
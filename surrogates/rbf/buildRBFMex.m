@@ -0,0 +1,31 @@
+function buildRBFMex(varargin)
+%BUILDRBFMEX  Build the compiled RBF engine used by the RBF surrogates
+%
+% Call:   buildRBFMex()                    % with OpenMP
+%         buildRBFMex('openmp', false)     % serial
+%
+% The sources are in the native directory, and the MEX files rbfbuild_mex,
+% rbfpredict_mex and rbfmodel_mex are placed next to this file. Once they
+% exist, rbf_build/rbf_predict, my_rbfbuild/my_rbfpredict and RBF/RBF_eval
+% of MS-MTO use them, and fall back to the MATLAB code otherwise.
+% RBFMODEL requires rbfmodel_mex.
+
+opt = struct('openmp', true);
+for i = 1:2:numel(varargin)
+    opt.(lower(varargin{i})) = varargin{i+1};
+end
+here = fileparts(mfilename('fullpath'));
+src = fullfile(here, 'native');
+flags = {'-outdir', here, ['-I', src]};
+if opt.openmp
+    if ispc
+        flags = [flags, {'COMPFLAGS=$COMPFLAGS /openmp'}];
+    elseif ismac
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -Xpreprocessor -fopenmp', 'LDFLAGS=$LDFLAGS -lomp'}];
+    else
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -fopenmp', 'LDFLAGS=$LDFLAGS -fopenmp'}];
+    end
+end
+for f = {'rbfbuild_mex', 'rbfpredict_mex', 'rbfmodel_mex'}
+    mex(flags{:}, fullfile(src, [f{1}, '.cpp']), fullfile(src, 'rbf.cpp'));
+end
@@ -0,0 +1,547 @@
+/*
+  Native RBF interpolation, see rbf.h.
+
+  Optional build flag:
+  -fopenmp     build the kernel matrix, factorise it and evaluate the
+               prediction sites in parallel
+*/
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "rbf.h"
+
+namespace rbf {
+
+namespace {
+
+/* Kernel matrix tiles and prediction blocks */
+const int TILE_M = 256;
+const int TILE_N = 32;
+const int PRED_BLOCK = 64;
+
+/* Relative size below which a bordered pivot is treated as breakdown */
+const double PIVOT_TOL = 1e-13;
+
+/* phi of the squared distance s */
+inline double phi(Kernel kernel, double s, double c2)
+{
+    switch (kernel) {
+    case LINEAR:
+        return std::sqrt(s);
+    case CUBIC:
+        return s * std::sqrt(s);
+    case THINPLATE: {
+        const double t = s + c2;
+        return t > 0.0 ? 0.5 * t * std::log(t) : 0.0;
+    }
+    case MULTIQUADRIC:
+        return std::sqrt(s + c2);
+    case INVMULTIQUADRIC:
+        return 1.0 / std::sqrt(s + c2);
+    case GAUSSIAN:
+    default:
+        return std::exp(-s / (2.0 * c2));
+    }
+}
+
+/* Tail functions t [p] at the site x (stride ldx), regpoly2 order for the
+   quadratic tail */
+void tailFunctions(Tail tail, const double *x, size_t ldx, int d, double *t)
+{
+    if (tail == TAIL_NONE) {
+        return;
+    }
+    t[0] = 1.0;
+    for (int k = 0; k < d; k++) {
+        t[1 + k] = x[k * ldx];
+    }
+    if (tail == TAIL_QUADRATIC) {
+        int j = d + 1;
+        for (int k = 0; k < d; k++) {
+            for (int l = k; l < d; l++) {
+                t[j++] = x[k * ldx] * x[l * ldx];
+            }
+        }
+    }
+}
+
+/* y [nq] += sum_j lambda_j phi(|x_q - X_j|) + gamma' t(x_q) for the
+   centres X [n x d] (leading dimension ldX) and the sites x [nq x d].
+   Blocks of sites are distributed over threads; within a block the squared
+   distances to one centre are accumulated across the sites. */
+void evaluate(Kernel kernel, double c2, Tail tail, const double *X, size_t ldX, int n, int d,
+              const double *lambda, const double *gamma, const double *x, int nq, double *y)
+{
+    const int p = tailSize(tail, d);
+    const int nb = (nq + PRED_BLOCK - 1) / PRED_BLOCK;
+#pragma omp parallel if (nb > 1)
+    {
+        double s[PRED_BLOCK];
+        std::vector<double> t(p > 0 ? p : 1);
+#pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < nb; b++) {
+            const int qb = b * PRED_BLOCK, qe = std::min(qb + PRED_BLOCK, nq), nqb = qe - qb;
+            double *yb = y + qb;
+            for (int j = 0; j < n; j++) {
+                std::fill(s, s + nqb, 0.0);
+                for (int k = 0; k < d; k++) {
+                    const double xj = X[j + k * ldX], *xk = x + (size_t)k * nq + qb;
+#pragma omp simd
+                    for (int q = 0; q < nqb; q++) {
+                        const double u = xk[q] - xj;
+                        s[q] += u * u;
+                    }
+                }
+                const double lj = lambda[j];
+                for (int q = 0; q < nqb; q++) {
+                    yb[q] += lj * phi(kernel, s[q], c2);
+                }
+            }
+            for (int q = 0; q < nqb; q++) {
+                tailFunctions(tail, x + qb + q, nq, d, t.data());
+                double v = 0.0;
+                for (int a = 0; a < p; a++) {
+                    v += gamma[a] * t[a];
+                }
+                yb[q] += v;
+            }
+        }
+    }
+}
+
+/* In-place lower Cholesky factor of A [N x N] (leading dimension ld), of
+   which the lower triangle is read. Returns false if A is not positive
+   definite. */
+bool cholesky(double *A, int N, size_t ld)
+{
+    bool ok = true;
+#pragma omp parallel if (N > 256)
+    for (int k = 0; k < N; k++) {
+#pragma omp single
+        {
+            double *Ak = A + k * ld;
+            if (!(Ak[k] > 0.0)) {
+                ok = false;
+            } else {
+                Ak[k] = std::sqrt(Ak[k]);
+                for (int i = k + 1; i < N; i++) {
+                    Ak[i] /= Ak[k];
+                }
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        const double *Ak = A + k * ld;
+#pragma omp for schedule(static)
+        for (int j = k + 1; j < N; j++) {
+            double *Aj = A + j * ld;
+            const double a = Ak[j];
+            for (int i = j; i < N; i++) {
+                Aj[i] -= Ak[i] * a;
+            }
+        }
+    }
+    return ok;
+}
+
+/* In-place LU factorisation with partial pivoting, row i of P*A is row
+   perm[i] of A. Returns false if a pivot column is zero. */
+bool lu(double *A, int N, size_t ld, int *perm)
+{
+    bool ok = true;
+    for (int i = 0; i < N; i++) {
+        perm[i] = i;
+    }
+#pragma omp parallel if (N > 256)
+    for (int k = 0; k < N; k++) {
+#pragma omp single
+        {
+            double *Ak = A + k * ld;
+            int piv = k;
+            for (int i = k + 1; i < N; i++) {
+                if (std::fabs(Ak[i]) > std::fabs(Ak[piv])) {
+                    piv = i;
+                }
+            }
+            if (Ak[piv] == 0.0) {
+                ok = false;
+            } else {
+                if (piv != k) {
+                    std::swap(perm[k], perm[piv]);
+                    for (int j = 0; j < N; j++) {
+                        std::swap(A[k + j * ld], A[piv + j * ld]);
+                    }
+                }
+                const double inv = 1.0 / Ak[k];
+                for (int i = k + 1; i < N; i++) {
+                    Ak[i] *= inv;
+                }
+            }
+        }
+        if (!ok) {
+            break;
+        }
+        const double *Ak = A + k * ld;
+#pragma omp for schedule(static)
+        for (int j = k + 1; j < N; j++) {
+            double *Aj = A + j * ld;
+            const double a = Aj[k];
+            if (a != 0.0) {
+                for (int i = k + 1; i < N; i++) {
+                    Aj[i] -= Ak[i] * a;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+/* Solve L x = b in place, L lower triangular, unit diagonal if unit */
+void forwardSolve(const double *L, int N, size_t ld, bool unit, double *x)
+{
+    for (int j = 0; j < N; j++) {
+        const double *Lj = L + j * ld;
+        if (!unit) {
+            x[j] /= Lj[j];
+        }
+        const double xj = x[j];
+        for (int i = j + 1; i < N; i++) {
+            x[i] -= Lj[i] * xj;
+        }
+    }
+}
+
+/* Solve U x = b in place for the upper triangular U */
+void backSolveUpper(const double *U, int N, size_t ld, double *x)
+{
+    for (int j = N - 1; j >= 0; j--) {
+        const double *Uj = U + j * ld;
+        x[j] /= Uj[j];
+        const double xj = x[j];
+        for (int i = 0; i < j; i++) {
+            x[i] -= Uj[i] * xj;
+        }
+    }
+}
+
+/* Solve L' x = b in place for the lower triangular L */
+void backSolveTransposed(const double *L, int N, size_t ld, double *x)
+{
+    for (int j = N - 1; j >= 0; j--) {
+        const double *Lj = L + j * ld;
+        double s = x[j];
+        for (int i = j + 1; i < N; i++) {
+            s -= Lj[i] * x[i];
+        }
+        x[j] = s / Lj[j];
+    }
+}
+
+/* Solve U' x = b in place for the upper triangular U */
+void forwardSolveTransposed(const double *U, int N, size_t ld, double *x)
+{
+    for (int j = 0; j < N; j++) {
+        const double *Uj = U + j * ld;
+        double s = x[j];
+        for (int i = 0; i < j; i++) {
+            s -= Uj[i] * x[i];
+        }
+        x[j] = s / Uj[j];
+    }
+}
+
+} // namespace
+
+int kernelFromName(const char *name)
+{
+    static const struct {
+        const char *name;
+        Kernel kernel;
+    } names[] = {{"bh", LINEAR}, {"linear", LINEAR}, {"cub", CUBIC}, {"cubic", CUBIC},
+                 {"tps", THINPLATE}, {"mq", MULTIQUADRIC}, {"imq", INVMULTIQUADRIC},
+                 {"g", GAUSSIAN}};
+    if (name == NULL) {
+        return -1;
+    }
+    std::string s(name);
+    for (size_t i = 0; i < s.size(); i++) {
+        s[i] = (char)std::tolower((unsigned char)s[i]);
+    }
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (s == names[i].name) {
+            return names[i].kernel;
+        }
+    }
+    return -1;
+}
+
+int tailSize(Tail tail, int d)
+{
+    switch (tail) {
+    case TAIL_NONE:
+        return 0;
+    case TAIL_LINEAR:
+        return d + 1;
+    case TAIL_QUADRATIC:
+    default:
+        return (d + 1) * (d + 2) / 2;
+    }
+}
+
+Model::Model(Kernel kernel, double c, Tail tail, double reg, int refitEvery)
+    : kernel_(kernel), c2_(c * c), reg_(reg), tail_(tail), refitEvery_(refitEvery),
+      appended_(0), n_(0), d_(0), p_(0), cholesky_(false), meanY_(0.0), cap_(0)
+{
+    if (kernel == GAUSSIAN && c == 0.0) {
+        throw std::invalid_argument("The Gaussian kernel needs c > 0");
+    }
+}
+
+/* Storage for n centres, growing geometrically */
+void Model::grow(int n)
+{
+    if (n <= cap_) {
+        return;
+    }
+    const int cap = std::max(n, 2 * cap_);
+    const size_t ldo = cap_ + p_, ldn = cap + p_, N = n_ + p_;
+    std::vector<double> X((size_t)cap * d_), K(ldn * ldn);
+    for (int k = 0; k < d_; k++) {
+        std::copy(X_.begin() + k * (size_t)cap_, X_.begin() + k * (size_t)cap_ + n_,
+                  X.begin() + k * (size_t)cap);
+    }
+    for (size_t j = 0; j < N; j++) {
+        std::copy(K_.begin() + j * ldo, K_.begin() + j * ldo + N, K.begin() + j * ldn);
+    }
+    X_.swap(X);
+    K_.swap(K);
+    cap_ = cap;
+}
+
+void Model::fit(const double *X, const double *y, int n, int d)
+{
+    if (n < 1 || d < 1) {
+        throw std::invalid_argument("Wrong training data sizes.");
+    }
+    d_ = d;
+    p_ = tailSize(tail_, d);
+    n_ = n;
+    cap_ = n;
+    X_.assign(X, X + (size_t)n * d);
+    K_.resize((size_t)(n + p_) * (n + p_));
+    y_.assign(y, y + n);
+    appended_ = 0;
+    factorise();
+    solve();
+}
+
+/* Assemble the system [tail; centres] and factorise it */
+void Model::factorise()
+{
+    const int n = n_, d = d_, p = p_, N = n + p;
+    const size_t ld = cap_ + p, ldX = cap_;
+    double *K = K_.data();
+    const double *X = X_.data();
+
+    for (int pass = 0; pass < 2; pass++) {
+        /* Tail block and the polynomial rows and columns */
+        std::vector<double> t(p > 0 ? p : 1);
+        for (int a = 0; a < p; a++) {
+            std::fill(K + a * ld, K + a * ld + p, 0.0);
+            K[a + a * ld] = reg_;
+        }
+        for (int i = 0; i < n; i++) {
+            tailFunctions(tail_, X + i, ldX, d, t.data());
+            for (int a = 0; a < p; a++) {
+                K[p + i + a * ld] = t[a];
+                K[a + (p + i) * ld] = t[a];
+            }
+        }
+
+        /* Kernel block by tiles of the upper triangle, mirrored */
+        const int nbm = (n + TILE_M - 1) / TILE_M, nbn = (n + TILE_N - 1) / TILE_N;
+#pragma omp parallel for schedule(dynamic, 1)
+        for (int tt = 0; tt < nbm * nbn; tt++) {
+            const int ib = (tt % nbm) * TILE_M, jb = (tt / nbm) * TILE_N;
+            if (ib > jb + TILE_N - 1) {
+                continue;
+            }
+            const int je = std::min(jb + TILE_N, n);
+            for (int j = jb; j < je; j++) {
+                const int ie = std::min(std::min(ib + TILE_M, n), j + 1);
+                double *Kj = K + (p + j) * ld + p;
+                for (int i = ib; i < ie; i++) {
+                    Kj[i] = 0.0;
+                }
+                for (int k = 0; k < d; k++) {
+                    const double xj = X[j + k * ldX], *xk = X + k * ldX;
+#pragma omp simd
+                    for (int i = ib; i < ie; i++) {
+                        const double u = xk[i] - xj;
+                        Kj[i] += u * u;
+                    }
+                }
+                for (int i = ib; i < ie; i++) {
+                    Kj[i] = phi(kernel_, Kj[i], c2_) + (i == j ? reg_ : 0.0);
+                }
+            }
+        }
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int j = 0; j < n; j++) {
+            for (int i = j + 1; i < n; i++) {
+                K[p + i + (p + j) * ld] = K[p + j + (p + i) * ld];
+            }
+        }
+
+        /* Cholesky where the system is positive definite, else LU */
+        if (pass == 0 && p == 0 && (kernel_ == GAUSSIAN || kernel_ == INVMULTIQUADRIC)) {
+            cholesky_ = cholesky(K, N, ld);
+            if (cholesky_) {
+                return;
+            }
+            continue;
+        }
+        cholesky_ = false;
+        perm_.resize(N);
+        if (!lu(K, N, ld, perm_.data())) {
+            throw std::runtime_error("The RBF system is singular");
+        }
+        return;
+    }
+}
+
+/* z = K \ [0; y - meanY] with the factorisation */
+void Model::solve()
+{
+    const int n = n_, p = p_, N = n + p;
+    const size_t ld = cap_ + p;
+    if (tail_ == TAIL_NONE) {
+        double s = 0.0;
+        for (int i = 0; i < n; i++) {
+            s += y_[i];
+        }
+        meanY_ = s / n;
+    } else {
+        meanY_ = 0.0;
+    }
+    std::vector<double> b(N, 0.0);
+    for (int i = 0; i < n; i++) {
+        b[p + i] = y_[i] - meanY_;
+    }
+    z_.resize(N);
+    if (cholesky_) {
+        z_ = b;
+        forwardSolve(K_.data(), N, ld, false, z_.data());
+        backSolveTransposed(K_.data(), N, ld, z_.data());
+    } else {
+        for (int i = 0; i < N; i++) {
+            z_[i] = b[perm_[i]];
+        }
+        forwardSolve(K_.data(), N, ld, true, z_.data());
+        backSolveUpper(K_.data(), N, ld, z_.data());
+    }
+}
+
+void Model::append(const double *x, double y)
+{
+    if (n_ == 0) {
+        throw std::logic_error("rbf::Model: fit the model before appending centres");
+    }
+    const int d = d_, p = p_, N = n_ + p;
+    grow(n_ + 1);
+    const size_t ld = cap_ + p, ldX = cap_;
+    for (int k = 0; k < d; k++) {
+        X_[n_ + k * ldX] = x[k];
+    }
+    y_.push_back(y);
+    appended_++;
+
+    /* Border b = [t(x); phi(|x - X_i|)], diagonal c */
+    std::vector<double> b(N);
+    tailFunctions(tail_, x, 1, d, b.data());
+    for (int i = 0; i < n_; i++) {
+        double s = 0.0;
+        for (int k = 0; k < d; k++) {
+            const double u = x[k] - X_[i + k * ldX];
+            s += u * u;
+        }
+        b[p + i] = phi(kernel_, s, c2_);
+    }
+    const double c = phi(kernel_, 0.0, c2_) + reg_;
+    double *K = K_.data(), *Kn = K + N * ld;
+    bool refactor = refitEvery_ > 0 && appended_ % refitEvery_ == 0;
+
+    if (!refactor && cholesky_) {
+        /* [L 0; l' d] with L l = b, d^2 = c - l'l */
+        std::vector<double> l(b);
+        forwardSolve(K, N, ld, false, l.data());
+        double ll = 0.0;
+        for (int i = 0; i < N; i++) {
+            ll += l[i] * l[i];
+        }
+        const double d2 = c - ll;
+        if (d2 > PIVOT_TOL * (std::fabs(c) + ll)) {
+            for (int i = 0; i < N; i++) {
+                K[N + i * ld] = l[i];
+            }
+            Kn[N] = std::sqrt(d2);
+        } else {
+            refactor = true;
+        }
+    } else if (!refactor) {
+        /* [L 0; w' 1][U v; 0 s] with L v = P b, U' w = b, s = c - w'v */
+        std::vector<double> v(N), w(b);
+        for (int i = 0; i < N; i++) {
+            v[i] = b[perm_[i]];
+        }
+        forwardSolve(K, N, ld, true, v.data());
+        forwardSolveTransposed(K, N, ld, w.data());
+        double wv = 0.0;
+        for (int i = 0; i < N; i++) {
+            wv += w[i] * v[i];
+        }
+        const double s = c - wv;
+        if (std::fabs(s) > PIVOT_TOL * (std::fabs(c) + std::fabs(wv))) {
+            for (int i = 0; i < N; i++) {
+                Kn[i] = v[i];
+                K[N + i * ld] = w[i];
+            }
+            Kn[N] = s;
+            perm_.push_back(N);
+        } else {
+            refactor = true;
+        }
+    }
+    n_++;
+    if (refactor) {
+        factorise();
+    }
+    solve();
+}
+
+void Model::predict(const double *x, int nq, double *y) const
+{
+    std::fill(y, y + nq, meanY_);
+    evaluate(kernel_, c2_, tail_, X_.data(), cap_, n_, d_, z_.data() + p_, z_.data(), x, nq, y);
+}
+
+std::vector<double> Model::coefficients() const
+{
+    std::vector<double> c(z_.begin() + p_, z_.end());
+    c.insert(c.end(), z_.begin(), z_.begin() + p_);
+    return c;
+}
+
+void predict(Kernel kernel, double c, Tail tail, const double *X, int n, int d,
+             const double *coefs, double meanY, const double *x, int nq, double *y)
+{
+    std::fill(y, y + nq, meanY);
+    evaluate(kernel, c * c, tail, X, n, n, d, coefs, coefs + n, x, nq, y);
+}
+
+} // namespace rbf
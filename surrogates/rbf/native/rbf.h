@@ -0,0 +1,92 @@
+/*
+  Native radial basis function interpolation shared by the RBF surrogates:
+  rbf_build/rbf_predict and my_rbfbuild/my_rbfpredict of the Jekabsons
+  toolbox (surrogates/rbf/rbftlbx, utils) and RBF/RBF_eval of MS-MTO.
+
+  The interpolant at the n centres X [n x d] is
+
+    y(x) = meanY + sum_i lambda_i phi(|x - X_i|) + sum_j gamma_j t_j(x)
+
+  with the polynomial tail t = [1 x] or the regpoly2 basis, or no tail and
+  meanY the mean of the responses. lambda and gamma solve
+
+    [Phi + reg*I  T     ] [lambda]   [y - meanY]
+    [T'           reg*I ] [gamma ] = [0        ]
+
+  like the regularised systems of rbf_build. The kernel matrix is built on
+  tiles in parallel and factorised once (Cholesky for the positive definite
+  Gaussian and inverse multiquadric kernels without a tail, otherwise LU
+  with partial pivoting); appending a centre borders the factorisation in
+  O(n^2). The MATLAB interfaces are rbfbuild_mex.cpp, rbfpredict_mex.cpp
+  and rbfmodel_mex.cpp (see buildRBFMex.m).
+*/
+#ifndef RBF_H
+#define RBF_H
+
+#include <vector>
+
+namespace rbf {
+
+/* phi(r): r, r^3, (r^2+c^2) log sqrt(r^2+c^2), sqrt(r^2+c^2),
+   1/sqrt(r^2+c^2) and exp(-r^2/(2c^2)) */
+enum Kernel { LINEAR, CUBIC, THINPLATE, MULTIQUADRIC, INVMULTIQUADRIC, GAUSSIAN };
+enum Tail { TAIL_NONE, TAIL_LINEAR, TAIL_QUADRATIC };
+
+/* Kernel from the names of the toolboxes ('BH', 'CUB', 'TPS', 'MQ', 'IMQ',
+   'G', 'linear', 'cubic'), case insensitive; -1 if it is unknown. */
+int kernelFromName(const char *name);
+
+/* Number of tail functions in dimension d. */
+int tailSize(Tail tail, int d);
+
+class Model
+{
+public:
+    /* With refitEvery > 0 the system is factorised again after that many
+       appended centres. */
+    Model(Kernel kernel, double c, Tail tail, double reg = 0.0, int refitEvery = 0);
+
+    /* Interpolate y [n] at the centres X [n x d]. Throws std::runtime_error
+       if the system is singular. */
+    void fit(const double *X, const double *y, int n, int d);
+
+    /* Add the centre x [d] with response y and update the coefficients. */
+    void append(const double *x, double y);
+
+    /* y [nq] at the sites x [nq x d], in parallel when built with OpenMP. */
+    void predict(const double *x, int nq, double *y) const;
+
+    /* [lambda; gamma], n + tailSize entries */
+    std::vector<double> coefficients() const;
+    double meanY() const { return meanY_; }
+    int size() const { return n_; }
+    int dim() const { return d_; }
+
+private:
+    void factorise();
+    void solve();
+    void grow(int n);
+
+    Kernel kernel_;
+    double c2_, reg_;
+    Tail tail_;
+    int refitEvery_, appended_;
+    int n_, d_, p_;
+    bool cholesky_;
+    double meanY_;
+    std::vector<double> X_;     // centres by columns, leading dimension cap_
+    std::vector<double> y_;     // responses
+    int cap_;
+    std::vector<double> K_;     // factor of the system [tail; centres], ld cap_ + p_
+    std::vector<int> perm_;     // row permutation of the LU factorisation
+    std::vector<double> z_;     // solution [gamma; lambda]
+};
+
+/* Predict with the coefficients of rbf_build at the sites x [nq x d]:
+   coefs = [lambda; gamma] for the centres X [n x d]. */
+void predict(Kernel kernel, double c, Tail tail, const double *X, int n, int d,
+             const double *coefs, double meanY, const double *x, int nq, double *y);
+
+} // namespace rbf
+
+#endif /* RBF_H */
@@ -0,0 +1,38 @@
+/*
+  Helpers shared by the MEX interfaces of the native RBF engine.
+*/
+#ifndef RBF_MEX_H
+#define RBF_MEX_H
+
+#include <mex.h>
+#include <string.h>
+#include "rbf.h"
+
+static bool isRealMatrix(const mxArray *a)
+{
+    return mxIsDouble(a) && !mxIsComplex(a) && !mxIsSparse(a);
+}
+
+/* Kernel from its name */
+static rbf::Kernel kernelArg(const mxArray *a)
+{
+    char *name = mxIsChar(a) ? mxArrayToString(a) : NULL;
+    const int k = rbf::kernelFromName(name);
+    mxFree(name);
+    if (k < 0) {
+        mexErrMsgTxt("Unknown basis function type.");
+    }
+    return (rbf::Kernel)k;
+}
+
+/* Tail from the usePolyPart value 0, 1 or 2 */
+static rbf::Tail tailArg(const mxArray *a)
+{
+    const double t = mxGetScalar(a);
+    if (t != 0.0 && t != 1.0 && t != 2.0) {
+        mexErrMsgTxt("The polynomial part must be 0, 1 or 2.");
+    }
+    return (rbf::Tail)(int)t;
+}
+
+#endif /* RBF_MEX_H */
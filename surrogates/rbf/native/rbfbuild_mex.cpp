@@ -0,0 +1,52 @@
+/*
+  MATLAB interface to rbf::Model::fit, called by rbf_build, my_rbfbuild
+  and RBF (MS-MTO) when it is built:
+
+    [coefs, meanY] = rbfbuild_mex(X, Y, type, c, poly, reg)
+
+  with the centres X [n x d], responses Y [n x 1], the basis function type
+  ('BH', 'CUB', 'TPS', 'MQ', 'IMQ', 'G'), its parameter c, the polynomial
+  tail poly (0: none, 1: linear, 2: quadratic) and the diagonal
+  regularisation reg. coefs = [lambda; gamma] as in rbf_build. Build with
+  buildRBFMex.
+*/
+#include <exception>
+#include <vector>
+#include "rbf_mex.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    static char err[512];
+    if (nrhs != 6 || nlhs > 2) {
+        mexErrMsgTxt("usage: [coefs, meanY] = rbfbuild_mex(X, Y, type, c, poly, reg)");
+    }
+    if (!isRealMatrix(prhs[0]) || !isRealMatrix(prhs[1])) {
+        mexErrMsgTxt("X and Y must be real, full matrices.");
+    }
+    const int n = (int)mxGetM(prhs[0]), d = (int)mxGetN(prhs[0]);
+    if (n < 1 || d < 1 || mxGetNumberOfElements(prhs[1]) != (size_t)n) {
+        mexErrMsgTxt("Wrong training data sizes.");
+    }
+    const rbf::Kernel kernel = kernelArg(prhs[2]);
+    const rbf::Tail tail = tailArg(prhs[4]);
+
+    std::vector<double> coefs;
+    double meanY = 0.0;
+    err[0] = '\0';
+    try {
+        rbf::Model model(kernel, mxGetScalar(prhs[3]), tail, mxGetScalar(prhs[5]));
+        model.fit(mxGetPr(prhs[0]), mxGetPr(prhs[1]), n, d);
+        coefs = model.coefficients();
+        meanY = model.meanY();
+    } catch (const std::exception &e) {
+        strncpy(err, e.what(), sizeof(err) - 1);
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+    plhs[0] = mxCreateDoubleMatrix(coefs.size(), 1, mxREAL);
+    memcpy(mxGetPr(plhs[0]), coefs.data(), coefs.size() * sizeof(double));
+    if (nlhs > 1) {
+        plhs[1] = mxCreateDoubleScalar(meanY);
+    }
+}
@@ -0,0 +1,162 @@
+/*
+  MATLAB interface to rbf::Model, used by RBFModel.m:
+
+    h              = rbfmodel_mex('new', X, Y, type, c, poly, reg, refit)
+                     rbfmodel_mex('append', h, X, Y)
+    Yq             = rbfmodel_mex('predict', h, Xq)
+    [coefs, meanY] = rbfmodel_mex('coefs', h)
+    n              = rbfmodel_mex('size', h)
+                     rbfmodel_mex('delete', h)
+
+  The arguments of 'new' are those of rbfbuild_mex, and refit > 0
+  refactorises the system after that many appended centres. X of 'append'
+  holds one centre per row. The models live until they are deleted or the
+  MEX file is cleared. Build with buildRBFMex.
+*/
+#include <stdio.h>
+#include <exception>
+#include <map>
+#include <string>
+#include <vector>
+#include "rbf_mex.h"
+
+namespace {
+
+std::map<int, rbf::Model *> models;
+int nextHandle = 1;
+
+void clearModels()
+{
+    for (std::map<int, rbf::Model *>::iterator it = models.begin(); it != models.end(); ++it) {
+        delete it->second;
+    }
+    models.clear();
+}
+
+rbf::Model *lookup(const mxArray *h)
+{
+    if (!mxIsDouble(h) || mxGetNumberOfElements(h) != 1) {
+        mexErrMsgTxt("Invalid model handle.");
+    }
+    std::map<int, rbf::Model *>::iterator it = models.find((int)mxGetScalar(h));
+    if (it == models.end()) {
+        mexErrMsgTxt("Invalid model handle.");
+    }
+    return it->second;
+}
+
+/* Rows of the real matrix x of dimension d */
+int rows(const mxArray *x, int d, const char *what)
+{
+    static char msg[96];
+    if (!isRealMatrix(x) || (int)mxGetN(x) != d) {
+        sprintf(msg, "%s must be a real, full matrix with %d columns.", what, d);
+        mexErrMsgTxt(msg);
+    }
+    return (int)mxGetM(x);
+}
+
+void create(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 8 || nlhs > 1) {
+        mexErrMsgTxt("usage: h = rbfmodel_mex('new', X, Y, type, c, poly, reg, refit)");
+    }
+    if (!isRealMatrix(prhs[1]) || !isRealMatrix(prhs[2])) {
+        mexErrMsgTxt("X and Y must be real, full matrices.");
+    }
+    const int n = (int)mxGetM(prhs[1]), d = (int)mxGetN(prhs[1]);
+    if (n < 1 || d < 1 || mxGetNumberOfElements(prhs[2]) != (size_t)n) {
+        mexErrMsgTxt("Wrong training data sizes.");
+    }
+    const rbf::Kernel kernel = kernelArg(prhs[3]);
+    const rbf::Tail tail = tailArg(prhs[5]);
+
+    static char err[512];
+    rbf::Model *model = NULL;
+    err[0] = '\0';
+    try {
+        model = new rbf::Model(kernel, mxGetScalar(prhs[4]), tail, mxGetScalar(prhs[6]),
+                               (int)mxGetScalar(prhs[7]));
+        model->fit(mxGetPr(prhs[1]), mxGetPr(prhs[2]), n, d);
+    } catch (const std::exception &e) {
+        strncpy(err, e.what(), sizeof(err) - 1);
+        delete model;
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+    if (models.empty()) {
+        mexAtExit(clearModels);
+    }
+    models[nextHandle] = model;
+    plhs[0] = mxCreateDoubleScalar(nextHandle++);
+}
+
+} // namespace
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs < 1 || !mxIsChar(prhs[0])) {
+        mexErrMsgTxt("usage: rbfmodel_mex(command, ...)");
+    }
+    char *s = mxArrayToString(prhs[0]);
+    const std::string cmd(s);
+    mxFree(s);
+    if (cmd == "new") {
+        create(nlhs, plhs, nrhs, prhs);
+        return;
+    }
+    if (nrhs < 2) {
+        mexErrMsgTxt("Missing model handle.");
+    }
+    rbf::Model *model = lookup(prhs[1]);
+    const int d = model->dim();
+    static char err[512];
+    err[0] = '\0';
+
+    if (cmd == "append") {
+        if (nrhs != 4) {
+            mexErrMsgTxt("usage: rbfmodel_mex('append', h, X, Y)");
+        }
+        const int na = rows(prhs[2], d, "X");
+        if (!isRealMatrix(prhs[3]) || mxGetNumberOfElements(prhs[3]) != (size_t)na) {
+            mexErrMsgTxt("X and Y must have the same number of rows");
+        }
+        const double *X = mxGetPr(prhs[2]), *Y = mxGetPr(prhs[3]);
+        std::vector<double> x(d);
+        try {
+            for (int i = 0; i < na; i++) {
+                for (int k = 0; k < d; k++) {
+                    x[k] = X[i + (size_t)k * na];
+                }
+                model->append(x.data(), Y[i]);
+            }
+        } catch (const std::exception &e) {
+            strncpy(err, e.what(), sizeof(err) - 1);
+        }
+    } else if (cmd == "predict") {
+        if (nrhs != 3 || nlhs > 1) {
+            mexErrMsgTxt("usage: Yq = rbfmodel_mex('predict', h, Xq)");
+        }
+        const int nq = rows(prhs[2], d, "Xq");
+        plhs[0] = mxCreateDoubleMatrix(nq, 1, mxREAL);
+        model->predict(mxGetPr(prhs[2]), nq, mxGetPr(plhs[0]));
+    } else if (cmd == "coefs") {
+        const std::vector<double> c = model->coefficients();
+        plhs[0] = mxCreateDoubleMatrix(c.size(), 1, mxREAL);
+        memcpy(mxGetPr(plhs[0]), c.data(), c.size() * sizeof(double));
+        if (nlhs > 1) {
+            plhs[1] = mxCreateDoubleScalar(model->meanY());
+        }
+    } else if (cmd == "size") {
+        plhs[0] = mxCreateDoubleScalar(model->size());
+    } else if (cmd == "delete") {
+        models.erase((int)mxGetScalar(prhs[1]));
+        delete model;
+    } else {
+        mexErrMsgTxt("Unknown command.");
+    }
+    if (err[0] != '\0') {
+        mexErrMsgTxt(err);
+    }
+}
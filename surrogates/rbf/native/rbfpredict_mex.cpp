@@ -0,0 +1,33 @@
+/*
+  MATLAB interface to rbf::predict, called by rbf_predict, my_rbfpredict
+  and RBF_eval (MS-MTO) when it is built:
+
+    Yq = rbfpredict_mex(X, coefs, meanY, type, c, poly, Xq)
+
+  for the centres X [n x d] and coefficients [lambda; gamma] of
+  rbfbuild_mex at the sites Xq [nq x d]. Build with buildRBFMex.
+*/
+#include "rbf_mex.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    if (nrhs != 7 || nlhs > 1) {
+        mexErrMsgTxt("usage: Yq = rbfpredict_mex(X, coefs, meanY, type, c, poly, Xq)");
+    }
+    if (!isRealMatrix(prhs[0]) || !isRealMatrix(prhs[1]) || !isRealMatrix(prhs[6])) {
+        mexErrMsgTxt("X, coefs and Xq must be real, full matrices.");
+    }
+    const int n = (int)mxGetM(prhs[0]), d = (int)mxGetN(prhs[0]);
+    const rbf::Kernel kernel = kernelArg(prhs[3]);
+    const rbf::Tail tail = tailArg(prhs[5]);
+    if (mxGetNumberOfElements(prhs[1]) != (size_t)(n + rbf::tailSize(tail, d))) {
+        mexErrMsgTxt("The coefficients do not match the centres.");
+    }
+    if ((int)mxGetN(prhs[6]) != d) {
+        mexErrMsgTxt("Xq must have the dimension of X.");
+    }
+    const int nq = (int)mxGetM(prhs[6]);
+    plhs[0] = mxCreateDoubleMatrix(nq, 1, mxREAL);
+    rbf::predict(kernel, mxGetScalar(prhs[4]), tail, mxGetPr(prhs[0]), n, d, mxGetPr(prhs[1]),
+                 mxGetScalar(prhs[2]), mxGetPr(prhs[6]), nq, mxGetPr(plhs[0]));
+}
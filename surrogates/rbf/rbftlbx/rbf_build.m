@@ -95,6 +95,20 @@ else
     model.bf_c = bf_c;
     model.poly = usePolyPart;
 
+    if exist('rbfbuild_mex', 'file') == 3
+        % Compiled engine (see buildRBFMex), same regularised system
+        kname = upper(bf_type);
+        if ~any(strcmp(kname, {'BH', 'IMQ', 'TPS', 'G'}))
+            kname = 'MQ';
+        end
+        model.coefs = rbfbuild_mex(Xtr, Ytr, kname, bf_c, double(model.poly ~= 0), 1e-6);
+        time = toc;
+        if verbose
+            fprintf('Execution time: %0.2f seconds\n', time);
+        end
+        return
+    end
+
     %calculate and transform distances between all the points in the training data
     dist = zeros(n, n);
     switch upper(model.bf_type)
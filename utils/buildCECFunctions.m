@@ -0,0 +1,29 @@
+function buildCECFunctions(varargin)
+% Build the MEX interfaces cec17_func, cec19_func, cec20_func and cec22_func
+% from the CEC benchmark library in utils/cec.
+%   buildCECFunctions()                  % with OpenMP
+%   buildCECFunctions('openmp', false)   % serial
+%   buildCECFunctions('blas', true)      % shift and rotate through BLAS dgemm
+opt = struct('openmp', true, 'blas', false);
+for i = 1:2:numel(varargin)
+    opt.(lower(varargin{i})) = varargin{i+1};
+end
+here = fileparts(mfilename('fullpath'));
+lib = fullfile(here, 'cec', {'cec.cpp', 'cec_base.cpp', 'cec17.cpp', 'cec19.cpp', 'cec20.cpp', 'cec22.cpp'});
+flags = {'-outdir', here};
+if opt.openmp
+    if ispc
+        flags = [flags, {'COMPFLAGS=$COMPFLAGS /openmp'}];
+    elseif ismac
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -Xpreprocessor -fopenmp', 'LDFLAGS=$LDFLAGS -lomp'}];
+    else
+        flags = [flags, {'CXXFLAGS=$CXXFLAGS -fopenmp', 'LDFLAGS=$LDFLAGS -fopenmp'}];
+    end
+end
+if opt.blas
+    flags = [flags, {'-DUSE_BLAS', '-lmwblas'}];
+end
+for s = [17, 19, 20, 22]
+    mex(flags{:}, fullfile(here, sprintf('cec%d_func.cpp', s)), lib{:});
+end
+end
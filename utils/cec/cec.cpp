@@ -0,0 +1,131 @@
+/*
+  Problem interface of the CEC benchmark library, see cec.h.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdexcept>
+#include <string>
+#include "cec.h"
+#include "cec_suites.h"
+
+namespace cec {
+
+static std::string &root()
+{
+	static std::string r(getenv("CEC_DATA_ROOT")!=NULL?getenv("CEC_DATA_ROOT"):"utils");
+	return r;
+}
+
+const char *check(int suite, int id, int dim)
+{
+	switch (suite)
+	{
+	case 17:
+		return cec17::check(id,dim);
+	case 19:
+		return cec19::check(id,dim);
+	case 20:
+		return cec20::check(id,dim);
+	case 22:
+		return cec22::check(id,dim);
+	default:
+		return "Unknown suite. Expected 17, 19, 20 or 22.";
+	}
+}
+
+int numFunctions(int suite)
+{
+	switch (suite)
+	{
+	case 17:
+		return 30;
+	case 19:
+	case 20:
+		return 10;
+	case 22:
+		return 12;
+	default:
+		return 0;
+	}
+}
+
+void setDataRoot(const std::string &r)
+{
+	if (r!=root())
+	{
+		clearCache();
+		root()=r;
+	}
+}
+
+const std::string &dataRoot()
+{
+	return root();
+}
+
+void clearCache()
+{
+	cec17::clear();
+	cec19::clear();
+	cec20::clear();
+	cec22::clear();
+}
+
+Problem::Problem(int suite, int id, int dim)
+	: suite_(suite), id_(id), dim_(dim), context_(NULL)
+{
+	const char *msg=check(suite,id,dim);
+	if (msg!=NULL)
+		throw std::invalid_argument(msg);
+	switch (suite)
+	{
+	case 17:
+		context_=cec17::load(id,dim);
+		break;
+	case 19:
+		context_=cec19::load(id,dim);
+		break;
+	case 20:
+		context_=cec20::load(id,dim);
+		break;
+	case 22:
+		context_=cec22::load(id,dim);
+		break;
+	}
+	if (context_==NULL)
+	{
+		char buf[128];
+		sprintf(buf,"Cannot read the data of CEC20%d F%d (D=%d) below ",suite,id,dim);
+		throw std::runtime_error(buf+root());
+	}
+}
+
+void Problem::evaluate(const double *x, double *f, int m) const
+{
+	/* The suites take non-const pointers but never write to x */
+	double *xm=const_cast<double *>(x);
+	switch (suite_)
+	{
+	case 17:
+		cec17::evaluate(context_,xm,f,m);
+		break;
+	case 19:
+		cec19::evaluate(context_,xm,f,m);
+		break;
+	case 20:
+		cec20::evaluate(context_,xm,f,m);
+		break;
+	case 22:
+		cec22::evaluate(context_,xm,f,m);
+		break;
+	}
+}
+
+double Problem::evaluate(const double *x) const
+{
+	double f;
+	evaluate(x,&f,1);
+	return f;
+}
+
+} // namespace cec
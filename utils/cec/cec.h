@@ -0,0 +1,65 @@
+/*
+  CEC single objective benchmark suites (CEC 2017, 2019, 2020 and 2022).
+
+  A Problem is one test function of one suite in a given dimension:
+
+    cec::Problem p(17, 4, 30);   // CEC 2017 F4, D = 30
+    p.evaluate(x, f, m);         // x is D x m (column major), f has m entries
+
+  The problem data (shift vectors, rotation matrices and shuffles) is read
+  from the input_data directories below the data root the first time a
+  problem is created, and stays cached until clearCache() or
+  setDataRoot() is called. All problems are defined on [-100, 100]^D.
+
+  Problems of the same or different suites may be evaluated concurrently,
+  from OpenMP or any other threads.
+  Creating problems and changing the data root are not thread safe.
+*/
+#ifndef CEC_H
+#define CEC_H
+
+#include <string>
+
+namespace cec {
+
+/* Error message if (suite, id, dim) is not a defined problem, NULL otherwise.
+   suite is 17, 19, 20 or 22. */
+const char *check(int suite, int id, int dim);
+
+/* Number of functions in a suite, 0 for an unknown suite. */
+int numFunctions(int suite);
+
+/* Directory holding input_data, input_data20, input_data22 and
+   input_data_cec2019. Defaults to $CEC_DATA_ROOT, or to "utils" relative
+   to the working directory. Changing it releases all cached data and invalidates
+   existing problems. */
+void setDataRoot(const std::string &root);
+const std::string &dataRoot();
+
+/* Release all cached problem data. Invalidates existing problems. */
+void clearCache();
+
+class Problem
+{
+public:
+	/* Throws std::invalid_argument if check() fails, and
+	   std::runtime_error if the data files cannot be read. */
+	Problem(int suite, int id, int dim);
+
+	int suite() const { return suite_; }
+	int id() const { return id_; }
+	int dim() const { return dim_; }
+
+	/* Evaluate the m columns of x [dim x m] into f [m]. Populations are
+	   evaluated in parallel when the library is built with OpenMP. */
+	void evaluate(const double *x, double *f, int m) const;
+	double evaluate(const double *x) const;
+
+private:
+	int suite_,id_,dim_;
+	void *context_;
+};
+
+} // namespace cec
+
+#endif /* CEC_H */
@@ -0,0 +1,1175 @@
+/*
+  CEC17 Test Function Suite for Single Objective Optimization- Bound constraints 
+  Noor Awad (email: noor0029@e.ntu.edu.sg) 
+  Sep. 10th 2016
+  Last update on 26_5_2017
+  
+  Part of the CEC benchmark library, see cec.h; the MATLAB interface is
+  ../cec17_func.cpp. Optional build flags:
+  -fopenmp     evaluate the columns of a population in parallel
+  -DUSE_BLAS   shift and rotate populations through BLAS dgemm (-lmwblas in MATLAB)
+  -ffast-math  with OpenMP, vectorise the cos/exp loops of the base functions
+               through glibc libmvec; results then change in the last few bits
+  The text data files are converted to binary *.pack files on first use
+  (see cec_data_pack.h), and all loaded functions stay cached in memory.
+*/
+
+// #include <WINDOWS.H>      
+#include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "cec_base.h"
+#include "cec_data_pack.h"
+#include "cec.h"
+#include "cec_suites.h"
+
+namespace cec {
+namespace cec17 {
+
+/* Problem data (shift vectors, rotation matrices, shuffles) for one
+   (func_num, nx) pair. Read-only once loaded, shared by all threads. */
+typedef struct cec17_context
+{
+	int nx,func_num;
+	double *OShift,*M;
+	int *SS;
+	cec_pack pack;
+} cec17_context;
+
+/* Every context loaded so far, so that switching between functions does
+   not reload their data */
+cec17_context **ctx_cache=NULL;
+int ctx_num=0;
+
+int cec17_load_context(cec17_context *,int,int);
+void cec17_free_context(cec17_context *);
+cec17_context *cec17_get_context(int,int);
+void cec17_clear_cache(void);
+void cec17_eval(cec17_context *,double *,double *,int,double *,double *);
+double cec17_batch_sr(int);
+
+// #include <WINDOWS.H>      
+// #include <stdio.h>
+// #include <math.h>
+// #include <malloc.h>
+
+
+void hf01 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 1 */
+void hf02 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 2 */
+void hf03 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 3 */
+void hf04 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 4 */
+void hf05 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 5 */
+void hf06 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 6 */
+void hf07 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 7 */
+void hf08 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 8 */
+void hf09 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 9 */
+void hf10 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 10 */
+
+void cf01 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 1 */
+void cf02 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 2 */
+void cf03 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 3 */
+void cf04 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 4 */
+void cf05 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 5 */
+void cf06 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 6 */
+void cf07 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 7 */
+void cf08 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 8 */
+void cf09 (double *, double *, int , double *,double *, int *, int,double *,double *); /* Composition Function 7 */
+void cf10 (double *, double *, int , double *,double *, int *, int,double *,double *); /* Composition Function 8 */
+
+
+const char *check(int func_num, int nx)
+{
+	if (func_num<1||func_num>30)
+		return "There are only 30 test functions in this test suite.";
+	if (func_num==2)
+		return "F2 has been deleted from this test suite.";
+	if (!(nx==2||nx==10||nx==20||nx==30||nx==50||nx==100))
+		return "Test functions are only defined for D=2,10,20,30,50,100.";
+	if (nx==2&&((func_num>=17&&func_num<=22)||(func_num>=29&&func_num<=30)))
+		return "hf01,hf02,hf03,hf04,hf05,hf06,cf07&cf08 are NOT defined for D=2.";
+	return NULL;
+}
+
+void *load(int func_num, int nx)
+{
+	return cec17_get_context(nx,func_num);
+}
+
+void evaluate(void *context, double *x, double *f, int mx)
+{
+	cec17_context *c=(cec17_context *)context;
+	int i,nx=c->nx;
+	double *xsr=NULL,sh_rate=cec17_batch_sr(c->func_num);
+
+	if (mx>1&&sh_rate!=0.0)
+	{
+		xsr=(double *)malloc(sizeof(double)*nx*mx);
+		sr_block(x,xsr,nx,mx,c->OShift,c->M,sh_rate);
+	}
+
+	/* Individuals are independent; each thread works in its own y and z */
+#pragma omp parallel if (mx>1)
+	{
+		double *y=(double *)malloc(sizeof(double)*2*nx),*z=y+nx;
+#pragma omp for schedule(static)
+		for (i = 0; i < mx; i++)
+		{
+			if (xsr!=NULL)
+				cec17_eval(c,&xsr[i*nx],&f[i],-1,y,z);
+			else
+				cec17_eval(c,&x[i*nx],&f[i],1,y,z);
+		}
+		free(y);
+	}
+	free(xsr);
+}
+
+void clear()
+{
+	cec17_clear_cache();
+}
+
+int cec17_load_context(cec17_context *c, int nx, int func_num)
+{
+	FILE *fpt;
+	char FileName[1024],PackName[1024];
+	const char *root=dataRoot().c_str();
+	/* Components of the composition functions 21-30; their data files
+	   only hold that many matrices for some dimensions */
+	static const int cf_comp[]={3,3,4,4,5,5,6,6,3,3};
+	int cf_num=func_num>20?cf_comp[func_num-21]:10,i,j;
+	double *M=NULL,*OShift=NULL;
+	int *SS=NULL;
+	int nM=0,nOShift=0,nSS=0,ok=1;
+
+	c->nx=nx;
+	c->func_num=func_num;
+	sprintf(PackName, "%s/input_data/cec17_F%d_D%d.pack", root, func_num,nx);
+	if (cec_pack_load(&c->pack,PackName,17,func_num,nx,&c->M,&c->OShift,&SS))
+	{
+		c->SS=SS;
+		return 1;
+	}
+
+	/* Load Matrix M*/
+	sprintf(FileName, "%s/input_data/M_%d_D%d.txt", root, func_num,nx);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+	    printf("\n Error: Cannot open input file for reading \n");
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	if (func_num<=20)
+	{
+		nM=nx*nx;
+		M=(double*)malloc(nM*sizeof(double));
+		if (M==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<nx*nx; i++)
+		{
+			ok&=fscanf(fpt,"%lf",&M[i])==1;
+		}
+	}
+	else
+	{
+		nM=cf_num*nx*nx;
+		M=(double*)malloc(nM*sizeof(double));
+		if (M==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<cf_num*nx*nx; i++)
+		{
+			ok&=fscanf(fpt,"%lf",&M[i])==1;
+		}
+	}
+	fclose(fpt);
+	
+	/* Load shift_data */
+	sprintf(FileName, "%s/input_data/shift_data_%d.txt", root, func_num);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+		printf("\n Error: Cannot open input file for reading \n");
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+
+	if (func_num<=20)
+	{
+		nOShift=nx;
+		OShift=(double *)malloc(nOShift*sizeof(double));
+		if (OShift==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
+		{
+			ok&=fscanf(fpt,"%lf",&OShift[i])==1;
+		}
+	}
+	else
+	{
+		nOShift=nx*cf_num;
+		OShift=(double *)malloc(nOShift*sizeof(double));
+		if (OShift==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<cf_num-1;i++)
+		{
+			for (j=0;j<nx;j++)
+			{
+				ok&=fscanf(fpt,"%lf",&OShift[i*nx+j])==1;
+			}
+			fscanf(fpt,"%*[^\n]%*c"); 
+		}
+		for (j=0;j<nx;j++)
+		{
+			ok&=fscanf(fpt,"%lf",&OShift[(cf_num-1)*nx+j])==1;
+		}
+			
+	}
+	fclose(fpt);
+
+
+	/* Load Shuffle_data */
+	
+	if (func_num>=11&&func_num<=20)
+	{
+		sprintf(FileName, "%s/input_data/shuffle_data_%d_D%d.txt", root, func_num, nx);
+		fpt = fopen(FileName,"r");
+		if (fpt==NULL)
+		{
+			printf("\n Error: Cannot open input file for reading \n");
+			free(M);
+			free(OShift);
+			free(SS);
+			return 0;
+		}
+		nSS=nx;
+		SS=(int *)malloc(nSS*sizeof(int));
+		if (SS==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
+		{
+			ok&=fscanf(fpt,"%d",&SS[i])==1;
+		}
+		fclose(fpt);	
+	}
+	else if (func_num==29||func_num==30)
+	{
+		sprintf(FileName, "%s/input_data/shuffle_data_%d_D%d.txt", root, func_num, nx);
+		fpt = fopen(FileName,"r");
+		if (fpt==NULL)
+		{
+			printf("\n Error: Cannot open input file for reading \n");
+			free(M);
+			free(OShift);
+			free(SS);
+			return 0;
+		}
+		nSS=nx*cf_num;
+		SS=(int *)malloc(nSS*sizeof(int));
+		if (SS==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx*cf_num;i++)
+		{
+			ok&=fscanf(fpt,"%d",&SS[i])==1;
+		}
+		fclose(fpt);
+	}
+
+	if (!ok)
+	{
+		printf("\n Error: Incomplete data for function %d, D=%d \n",func_num,nx);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	cec_pack_write(PackName,17,func_num,nx,M,nM,OShift,nOShift,SS,nSS);
+	c->M=M;
+	c->OShift=OShift;
+	c->SS=SS;
+	return 1;
+}
+
+void cec17_free_context(cec17_context *c)
+{
+	if (c->pack.base!=NULL)
+		cec_pack_close(&c->pack);
+	else
+	{
+		free(c->M);
+		free(c->OShift);
+		free(c->SS);
+	}
+	c->M=NULL;
+	c->OShift=NULL;
+	c->SS=NULL;
+	c->nx=0;
+	c->func_num=0;
+}
+
+cec17_context *cec17_get_context(int nx, int func_num)
+{
+	int i;
+	cec17_context *c;
+	for (i=0;i<ctx_num;i++)
+	{
+		if (ctx_cache[i]->func_num==func_num&&ctx_cache[i]->nx==nx)
+			return ctx_cache[i];
+	}
+	c=(cec17_context *)calloc(1,sizeof(cec17_context));
+	if (!cec17_load_context(c,nx,func_num))
+	{
+		free(c);
+		return NULL;
+	}
+	ctx_cache=(cec17_context **)realloc(ctx_cache,(ctx_num+1)*sizeof(cec17_context *));
+	ctx_cache[ctx_num++]=c;
+	return c;
+}
+
+void cec17_clear_cache(void)
+{
+	int i;
+	for (i=0;i<ctx_num;i++)
+	{
+		cec17_free_context(ctx_cache[i]);
+		free(ctx_cache[i]);
+	}
+	free(ctx_cache);
+	ctx_cache=NULL;
+	ctx_num=0;
+}
+
+void cec17_eval(cec17_context *c, double *x, double *f, int sr, double *y, double *z)
+{
+	int nx=c->nx;
+	double *OShift=c->OShift,*M=c->M;
+	int *SS=c->SS;
+	switch(c->func_num)
+	{
+	case 1:	
+		bent_cigar_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=100.0;
+		break;
+	case 2:	
+		//sum_diff_pow_func(x,f,nx,OShift,M,1,1);
+		//f[0]+=200.0;
+		printf("\nError: This function (F2) has been deleted\n");
+		break;
+	case 3:	
+		zakharov_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=300.0;
+		break;
+	case 4:	
+		rosenbrock_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=400.0;
+		break;
+	case 5:
+		rastrigin_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=500.0;
+		break;
+	case 6:
+		schaffer_F7_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=600.0;
+		break;
+	case 7:	
+		bi_rastrigin_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=700.0;
+		break;
+	case 8:	
+		step_rastrigin_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=800.0;
+		break;
+	case 9:	
+		levy_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=900.0;
+		break;
+	case 10:	
+		schwefel_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1000.0;
+		break;
+	case 11:	
+		hf01(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1100.0;
+		break;
+	case 12:	
+		hf02(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1200.0;
+		break;
+	case 13:	
+		hf03(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1300.0;
+		break;
+	case 14:	
+		hf04(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1400.0;
+		break;
+	case 15:	
+		hf05(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1500.0;
+		break;
+	case 16:	
+		hf06(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1600.0;
+		break;
+	case 17:	
+		hf07(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1700.0;
+		break;
+	case 18:	
+		hf08(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1800.0;
+		break;
+	case 19:	
+		hf09(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1900.0;
+		break;
+	case 20:	
+		hf10(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=2000.0;
+		break;
+	case 21:	
+		cf01(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2100.0;
+		break;
+	case 22:	
+		cf02(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2200.0;
+		break;
+	case 23:	
+		cf03(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2300.0;
+		break;
+	case 24:	
+		cf04(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2400.0;
+		break;
+	case 25:	
+		cf05(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2500.0;
+		break;
+	case 26:
+		cf06(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2600.0;
+		break;
+	case 27:
+		cf07(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2700.0;
+		break;
+	case 28:
+		cf08(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2800.0;
+		break;
+	case 29:
+		cf09(x,f,nx,OShift,M,SS,1,y,z);
+		f[0]+=2900.0;
+		break;
+	case 30:
+		cf10(x,f,nx,OShift,M,SS,1,y,z);
+		f[0]+=3000.0;
+		break;
+	default:
+		printf("\nError: There are only 30 test functions in this test suite!\n");
+		f[0] = 0.0;
+		break;
+	}
+}
+
+/* Shrink rate of the functions whose kernels only see x through sr_func,
+   so that the shift, shrink and rotation can be applied to the whole
+   population up front; 0 for the others */
+double cec17_batch_sr(int func_num)
+{
+	switch(func_num)
+	{
+	case 1:
+		return 1.0;
+	case 3:
+		return 1.0;
+	case 4:
+		return 2.048/100.0;
+	case 5:
+		return 5.12/100.0;
+	case 9:
+		return 1.0;
+	case 10:
+		return 1000.0/100.0;
+	case 11:
+		return 1.0;
+	case 12:
+		return 1.0;
+	case 13:
+		return 1.0;
+	case 14:
+		return 1.0;
+	case 15:
+		return 1.0;
+	case 16:
+		return 1.0;
+	case 17:
+		return 1.0;
+	case 18:
+		return 1.0;
+	case 19:
+		return 1.0;
+	case 20:
+		return 1.0;
+	default:
+		return 0.0;
+	}
+
+}
+
+
+void hf01 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 1 */
+{
+	int i,tmp,cf_num=3;
+	double fit[3];
+	int G[3],G_nx[3];
+	double Gp[3]={0.2,0.4,0.4};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	zakharov_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf02 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 2 */
+{
+	int i,tmp,cf_num=3;
+	double fit[3];
+	int G[3],G_nx[3];
+	double Gp[3]={0.3,0.3,0.4};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf03 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 2 */
+{
+	int i,tmp,cf_num=3;
+	double fit[3];
+	int G[3],G_nx[3];
+	double Gp[3]={0.3,0.3,0.4};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	
+	i=0;
+	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	bi_rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+	
+}
+
+void hf04 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 3 */
+{
+	int i,tmp,cf_num=4;
+	double fit[4];
+	int G[4],G_nx[4];
+	double Gp[4]={0.2,0.2,0.2,0.4};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	schaffer_F7_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf05 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 4 */
+{
+	int i,tmp,cf_num=4;
+	double fit[4];
+	int G[4],G_nx[4];
+	double Gp[4]={0.2,0.2,0.3,0.3};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	
+	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+void hf06 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 5 */
+{
+	int i,tmp,cf_num=4;
+	double fit[4];
+	int G[4],G_nx[4];
+	double Gp[4]={0.2,0.2,0.3,0.3};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	escaffer6_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	rosenbrock_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf07 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=5;
+	double fit[5];
+	int G[5],G_nx[5];
+	double Gp[5]={0.1,0.2,0.2,0.2,0.3};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	grie_rosen_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf08 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=5;
+	double fit[5];
+	int G[5],G_nx[5];
+	double Gp[5]={0.2,0.2,0.2,0.2,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	
+	i=0;
+	ellips_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	discus_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf09 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=5;
+	double fit[5];
+	int G[5],G_nx[5];
+	double Gp[5]={0.2,0.2,0.2,0.2,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	
+	i=0;
+	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	grie_rosen_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	weierstrass_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	escaffer6_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+
+void hf10 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=6;
+	double fit[6];
+	int G[6],G_nx[6];
+	double Gp[6]={0.1,0.1,0.2,0.2,0.2,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	
+	i=0;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=5;
+	schaffer_F7_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void cf01 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 1 */
+{
+	int i,cf_num=3;
+	double fit[3];
+	double delta[3] = {10, 20, 30};
+	double bias[3] = {0, 100, 200};
+	
+	i=0;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=1;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=2;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+}
+
+void cf02 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 2 */
+{
+	int i,cf_num=3;
+	double fit[3];
+	double delta[3] = {10,20,30};
+	double bias[3] = {0, 100, 200};
+
+	i=0;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=1;
+	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=2;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+void cf03 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 3 */
+{
+	int i,cf_num=4;
+	double fit[4];
+	double delta[4] = {10,20,30,40};
+	double bias[4] = {0, 100, 200, 300};
+	
+	i=0;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=1;
+	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=2;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=3;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+	
+}
+void cf04 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 3 */
+{
+	int i,cf_num=4;
+	double fit[4];
+	double delta[4] = {10,20,30,40};
+	double bias[4] = {0, 100, 200, 300};
+	
+	i=0;
+	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=1;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=2;
+	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=3;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+void cf05 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{
+	int i,cf_num=5;
+	double fit[5];
+	double delta[5] = {10,20,30,40,50};
+	double bias[5] = {0, 100, 200, 300, 400};
+	i=0;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+3;
+	i=1;
+	happycat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/1e+3;
+	i=2;
+	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=3;
+	discus_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;	
+	i=4;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}		
+
+
+void cf06 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{
+	int i,cf_num=5;
+	double fit[5];
+	double delta[5] = {10,20,20,30,40};
+	double bias[5] = {0, 100, 200, 300, 400};
+	i=0;
+	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/2e+7;
+	i=1;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=2;
+	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=3;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=4;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+3;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+void cf07 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{
+	int i,cf_num=6;
+	double fit[6];
+	double delta[6] = {10,20,30,40,50,60};
+	double bias[6] = {0, 100, 200, 300, 400, 500};
+	i=0;
+	hgbat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1000;
+	i=1;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+3;
+	i=2;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/4e+3;
+	i=3;
+	bent_cigar_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+30;
+	i=4;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=5;
+	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/2e+7;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num); 
+}
+
+void cf08 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{	
+	int i,cf_num=6;
+	double fit[6];
+	double delta[6] = {10,20,30,40,50,60};
+	double bias[6] = {0, 100, 200, 300, 400, 500};
+	i=0;
+	ackley_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=1;
+	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=2;
+	discus_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=3;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=4;
+	happycat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/1e+3;
+	i=5;
+	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/2e+7;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+
+void cf09 (double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag,double *y,double *z)
+{
+	
+	int i,cf_num=3;
+	double fit[3];
+	double delta[3] = {10,30,50};
+	double bias[3] = {0, 100, 200};
+	i=0;
+	hf05(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	i=1;
+	hf06(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	i=2;
+	hf07(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+		
+}
+
+void cf10 (double *x, double *f, int nx, double *Os,double *Mr,int *SS,int r_flag,double *y,double *z) 
+{
+	int i,cf_num=3;
+	double fit[3];
+	double delta[3] = {10,30,50};
+	double bias[3] = {0, 100, 200};
+	i=0;
+	hf05(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	i=1;
+	hf08(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	i=2;
+	hf09(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],&SS[i*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+
+} // namespace cec17
+} // namespace cec
@@ -0,0 +1,474 @@
+/*
+  CEC19 Test Function Suite 
+  Noor Awad (email: noorawad1989@gmail.com) 
+  Dec. 13th 2018
+  Part of the CEC benchmark library, see cec.h; the MATLAB interface is
+  ../cec19_func.cpp. Optional build flags:
+  -fopenmp     evaluate the columns of a population in parallel
+  -DUSE_BLAS   shift and rotate populations through BLAS dgemm (-lmwblas in MATLAB)
+  -ffast-math  with OpenMP, vectorise the cos/exp loops of the base functions
+               through glibc libmvec; results then change in the last few bits
+  The text data files are converted to binary *.pack files on first use
+  (see cec_data_pack.h), and all loaded functions stay cached in memory.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cec_base.h"
+#include "cec_data_pack.h"
+#include "cec.h"
+#include "cec_suites.h"
+
+namespace cec {
+namespace cec19 {
+
+
+void Lennard_Jones(double *, int, double *); /* Lennard Jones */
+void Hilbert(double *, int, double *); /* Hilbert */
+void Chebyshev(double *, int, double *); /* Chebyshev */
+
+
+/* Problem data (shift vector, rotation matrix) for one (func_num, nx)
+   pair. Read-only once loaded, shared by all threads. */
+typedef struct cec19_context
+{
+	int nx,func_num;
+	double *OShift,*M;
+	cec_pack pack;
+} cec19_context;
+
+/* Every context loaded so far, so that switching between functions does
+   not reload their data */
+static cec19_context **ctx_cache=NULL;
+static int ctx_num=0;
+
+int cec19_load_context(cec19_context *,int,int);
+void cec19_free_context(cec19_context *);
+cec19_context *cec19_get_context(int,int);
+void cec19_clear_cache(void);
+void cec19_eval(cec19_context *,double *,double *,int,double *,double *);
+double cec19_batch_sr(int);
+
+const char *check(int func_num, int nx)
+{
+	if (func_num<1||func_num>10)
+		return "There are only 10 test functions in this test suite.";
+	if ((func_num==1&&nx!=9)||(func_num==2&&nx!=16)||(func_num==3&&nx!=18)||(func_num>3&&nx!=10))
+		return "F1 is defined on D=9, F2 on D=16, F3 on D=18 and F4-F10 on D=10.";
+	return NULL;
+}
+
+void *load(int func_num, int nx)
+{
+	return cec19_get_context(nx,func_num);
+}
+
+void evaluate(void *context, double *x, double *f, int mx)
+{
+	cec19_context *c=(cec19_context *)context;
+	int i,nx=c->nx;
+	double *xsr=NULL,sh_rate=cec19_batch_sr(c->func_num);
+
+	if (mx>1&&sh_rate!=0.0)
+	{
+		xsr=(double *)malloc(sizeof(double)*nx*mx);
+		sr_block(x,xsr,nx,mx,c->OShift,c->M,sh_rate);
+	}
+
+	/* Individuals are independent; each thread works in its own y and z */
+#pragma omp parallel if (mx>1)
+	{
+		double *y=(double *)malloc(sizeof(double)*2*nx),*z=y+nx;
+#pragma omp for schedule(static)
+		for (i = 0; i < mx; i++)
+		{
+			if (xsr!=NULL)
+				cec19_eval(c,&xsr[i*nx],&f[i],-1,y,z);
+			else
+				cec19_eval(c,&x[i*nx],&f[i],1,y,z);
+		}
+		free(y);
+	}
+	free(xsr);
+}
+
+void clear()
+{
+	cec19_clear_cache();
+}
+
+int cec19_load_context(cec19_context *c, int nx, int func_num)
+{
+	FILE *fpt;
+	char FileName[1024],PackName[1024];
+	const char *root=dataRoot().c_str();
+	int i;
+	double *M=NULL,*OShift=NULL;
+	int *SS=NULL;
+	int nM=0,nOShift=0,ok=1;
+
+	c->nx=nx;
+	c->func_num=func_num;
+	sprintf(PackName, "%s/input_data_cec2019/cec19_F%d_D%d.pack", root, func_num,nx);
+	if (cec_pack_load(&c->pack,PackName,19,func_num,nx,&c->M,&c->OShift,&SS))
+		return 1;
+
+	/* Load Matrix M*/
+	if (func_num > 3)
+	{
+      sprintf(FileName, "%s/input_data_cec2019/M_%d_D%d.txt", root, func_num,nx);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+      printf("\n Error: Cannot open input '%s' file for reading \n", FileName);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	nM=nx*nx;
+	M=(double*)malloc(nM*sizeof(double));
+	if (M==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+	for (i=0; i<nx*nx; i++)
+	{
+		ok&=fscanf(fpt,"%lf",&M[i])==1;
+	}
+	
+	fclose(fpt);
+	}
+	
+	/* Load shift_data */
+	if (func_num > 3)
+	{
+      sprintf(FileName, "%s/input_data_cec2019/shift_data_%d.txt", root, func_num);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+		printf("\n Error: Cannot open input '%s' file for reading \n", FileName);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+
+	nOShift=nx;
+	OShift=(double *)malloc(nOShift*sizeof(double));
+	if (OShift==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+	for(i=0;i<nx;i++)
+	{
+		ok&=fscanf(fpt,"%lf",&OShift[i])==1;
+	}
+	
+	fclose(fpt);
+	}
+	
+
+	if (!ok)
+	{
+		printf("\n Error: Incomplete data for function %d, D=%d \n",func_num,nx);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	cec_pack_write(PackName,19,func_num,nx,M,nM,OShift,nOShift,NULL,0);
+	c->M=M;
+	c->OShift=OShift;
+	return 1;
+}
+
+void cec19_free_context(cec19_context *c)
+{
+	if (c->pack.base!=NULL)
+		cec_pack_close(&c->pack);
+	else
+	{
+		free(c->M);
+		free(c->OShift);
+	}
+	c->M=NULL;
+	c->OShift=NULL;
+	c->nx=0;
+	c->func_num=0;
+}
+
+cec19_context *cec19_get_context(int nx, int func_num)
+{
+	int i;
+	cec19_context *c;
+	for (i=0;i<ctx_num;i++)
+	{
+		if (ctx_cache[i]->func_num==func_num&&ctx_cache[i]->nx==nx)
+			return ctx_cache[i];
+	}
+	c=(cec19_context *)calloc(1,sizeof(cec19_context));
+	if (!cec19_load_context(c,nx,func_num))
+	{
+		free(c);
+		return NULL;
+	}
+	ctx_cache=(cec19_context **)realloc(ctx_cache,(ctx_num+1)*sizeof(cec19_context *));
+	ctx_cache[ctx_num++]=c;
+	return c;
+}
+
+void cec19_clear_cache(void)
+{
+	int i;
+	for (i=0;i<ctx_num;i++)
+	{
+		cec19_free_context(ctx_cache[i]);
+		free(ctx_cache[i]);
+	}
+	free(ctx_cache);
+	ctx_cache=NULL;
+	ctx_num=0;
+}
+
+void cec19_eval(cec19_context *c, double *x, double *f, int sr, double *y, double *z)
+{
+	int nx=c->nx;
+	double *OShift=c->OShift,*M=c->M;
+	switch(c->func_num)
+	{
+	case 1:
+		Chebyshev(x, nx, f);	
+		f[0]+=1.0;
+		break;
+		
+	case 2:	
+		Hilbert(x, nx, f);	
+		f[0]+=1.0;
+		break;
+		
+	case 3:	
+		Lennard_Jones(x, nx, f);	
+		f[0]+=1.0;
+		break;
+		
+	case 4:	
+		rastrigin_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 5:	
+		griewank_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 6:	
+		weierstrass_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 7:	
+		schwefel_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 8:
+		escaffer6_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 9:
+		happycat_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+		
+	case 10:	
+		ackley_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=1.0;
+		break;
+	default:
+		printf("\nError: There are only 30 test functions in this test suite!\n");
+		f[0] = 0.0;
+		break;
+	}
+}
+
+/* Shrink rate of the functions whose kernels only see x through sr_func,
+   so that the shift, shrink and rotation can be applied to the whole
+   population up front; 0 for the others */
+double cec19_batch_sr(int func_num)
+{
+	switch(func_num)
+	{
+	case 4:
+		return 5.12/100.0;
+	case 5:
+		return 600.0/100.0;
+	case 6:
+		return 0.5/100.0;
+	case 7:
+		return 1000.0/100.0;
+	case 8:
+		return 1.0;
+	case 9:
+		return 5.0/100.0;
+	case 10:
+		return 1.0;
+	default:
+		return 0.0;
+	}
+
+}
+
+
+void Lennard_Jones(double *x,int D, double *f)  // find the atomic configuration with minimum energy
+{
+	/* valid for any dimension, D=3*k, k=2,3,4,...,25.   k is the number of atoms in 3-D space
+	constraints: unconstrained
+	type: multi-modal with one global minimum; non-separable
+	initial upper bound = 4, initial lower bound = -4
+	value-to-reach = minima[k-2]+.0001
+	f(x*) = minima[k-2]; see array of minima below; additional minima available at the
+	Cambridge cluster database: http://www-wales.ch.cam.ac.uk/~jon/structures/LJ/tables.150.html
+	*/
+
+	f[0] = 0;
+	int i, j, k, a, b;
+	long double xd, yd, zd, ed, ud, sum = 0;
+
+
+	k = D / 3;
+	if (k < 2)  // default if k<2
+	{
+		k = 2;
+		D = 6;
+	}
+
+	for (i = 0; i < k - 1; i++)
+	{
+		for (j = i + 1; j < k; j++)
+		{
+			a = 3 * i;
+			b = 3 * j;
+			xd = x[a] - x[b];
+			yd = x[a + 1] - x[b + 1];
+			zd = x[a + 2] - x[b + 2];
+			ed = xd*xd + yd*yd + zd*zd;
+			ud = ed*ed*ed;
+			if (ud > 1.0e-10) sum += (1.0 / ud - 2.0) / ud;
+			else sum += 1.0e20; 
+		}
+	}
+	
+	f[0] += sum;
+	f[0] += 12.7120622568;
+}
+
+void Hilbert(double *x, int D, double *f)  // find the inverse of the (ill-conditioned) Hilbert matrix
+{
+	/* valid for any dimension, n=k*k, k=2,3,4,...
+	constraints: unconstrained
+	type: multi-modal with one global minimum; non-separable
+	initial upper bound = 2^n, initial lower bound = -2^n
+	value-to-reach = f(x*)+1.0e-8
+	f(x*) = 0.0; x*={{9,-36,30},{-36,192,-180},{30,-180,180}} (n=9)
+	x*={{16,-120,240,-140},{-120,1200,-2700,1680},{240,-2700,6480,4200},{-140,1680,-4200,2800}} (n=16)
+	*/
+
+	f[0] = 0;
+	int i, j, k, b;
+
+	long double sum = 0;
+
+	long double hilbert[10][10], y[10][10];			// Increase matrix size if D > 100
+
+	b = (int)sqrt((double)D);
+
+	
+	for (i = 0; i < b; i++)
+		{
+			for (j = 0; j < b; j++)
+			{
+				hilbert[i][j] = 1. / (double)(i + j + 1);		// Create a static Hilbert matrix
+			}
+		}
+
+	for (j = 0; j < b; j++)
+	{
+		for (k = 0; k < b; k++)
+		{
+			y[j][k] = 0;
+			for (i = 0; i < b; i++)
+			{
+				y[j][k] += hilbert[j][i] * x[k + b * i];		// Compute matrix product H*x
+			}
+		}
+	}
+
+
+	for (i = 0; i < b; i++)
+	{
+		for (j = 0; j < b; j++)
+		{
+			if (i == j) sum += fabs(y[i][j] - 1);				// Sum absolute value of deviations
+			else sum += fabs(y[i][j]);
+		}
+	}
+	
+	f[0] += sum;
+}
+
+void Chebyshev( double *x, int D, double *f)  // Storn's Tchebychev - a 2nd ICEO function - generalized version
+{
+	/* Valid for any D>2
+	constraints: unconstrained
+	type: multi-modal with one global minimum; non-separable
+	initial upper bound = 2^D, initial lower bound = -D^n
+	value-to-reach = f(x*)+1.0e-8
+	f(x*)=0.0; x*=(128,0,-256,0,160,0,-32,0,1) (n=9)
+	x*=(32768,0,-131072,0,212992,0,-180224,0,84480,0,-21504,0,2688,0,-128,0,1) (n=17)
+	*/
+
+	f[0] = 0.0;
+	int i, j;
+	int sample;
+	long double a = 1., b = 1.2, px, y = -1, sum = 0;
+	long double dx = 0, dy;
+	
+	for (j = 0; j < D - 2; j++)
+		{
+			dx = 2.4 * b - a;
+			a = b;
+			b = dx;
+		}
+
+		sample = 32 * D;
+		dy = 2. / (long double)sample;
+
+	for (i = 0; i <= sample; i++)
+	{
+		px = x[0];
+		for (j = 1; j < D; j++)
+		{
+			px = y*px + x[j];
+		}
+		if (px < -1 || px > 1) sum += (1. - fabs(px))*(1. - fabs(px));
+		y += dy;
+	}
+
+	for (i = -1; i <= 1; i += 2)
+	{
+		px = x[0];
+		for (j = 1; j < D; j++)
+		{
+			px = 1.2*px + x[j];
+		}
+
+		if (px < dx) sum += px * px;
+	}
+	
+	f[0] += sum;
+	
+}
+
+} // namespace cec19
+} // namespace cec
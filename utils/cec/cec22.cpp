@@ -0,0 +1,661 @@
+/*
+  CEC22 Test Function Suite for Single Objective Bound Constrained Numerical Optimization
+
+
+  Part of the CEC benchmark library, see cec.h; the MATLAB interface is
+  ../cec22_func.cpp. Optional build flags:
+  -fopenmp     evaluate the columns of a population in parallel
+  -DUSE_BLAS   shift and rotate populations through BLAS dgemm (-lmwblas in MATLAB)
+  -ffast-math  with OpenMP, vectorise the cos/exp loops of the base functions
+               through glibc libmvec; results then change in the last few bits
+  The text data files are converted to binary *.pack files on first use
+  (see cec_data_pack.h), and all loaded functions stay cached in memory.
+*/
+
+// #include <WINDOWS.H>
+#include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "cec_base.h"
+#include "cec_data_pack.h"
+#include "cec.h"
+#include "cec_suites.h"
+
+namespace cec {
+namespace cec22 {
+
+/* Problem data (shift vectors, rotation matrices, shuffles) for one
+   (func_num, nx) pair. Read-only once loaded, shared by all threads. */
+typedef struct cec22_context
+{
+	int nx,func_num;
+	double *OShift,*M;
+	int *SS;
+	cec_pack pack;
+} cec22_context;
+
+/* Every context loaded so far, so that switching between functions does
+   not reload their data */
+cec22_context **ctx_cache=NULL;
+int ctx_num=0;
+
+int cec22_load_context(cec22_context *,int,int);
+void cec22_free_context(cec22_context *);
+cec22_context *cec22_get_context(int,int);
+void cec22_clear_cache(void);
+void cec22_eval(cec22_context *,double *,double *,int,double *,double *);
+double cec22_batch_sr(int);
+
+// #include <WINDOWS.H>
+// #include <stdio.h>
+// #include <math.h>
+// #include <malloc.h>
+
+/* CEC 2022 places the optimum of Levy's function at the origin; this
+   hides cec::levy_func, which shifts it to 1 as in CEC 2017 */
+void levy_func(double *, double *, int , double *,double *, int, int,double *,double *); /* Levy */
+
+void hf02 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 2 */
+void hf06 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 6 */
+void hf10 (double *, double *, int, double *,double *, int *,int, int,double *,double *); /* Hybrid Function 10 */
+
+
+void cf01 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 1 */
+void cf02 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 2 */
+void cf06 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 6 */
+void cf07 (double *, double *, int , double *,double *, int,double *,double *); /* Composition Function 7 */
+
+
+const char *check(int func_num, int nx)
+{
+	if (func_num<1||func_num>12)
+		return "There are only 12 test functions in this test suite.";
+	if (!(nx==2||nx==10||nx==20))
+		return "Test functions are only defined for D=2,10,20.";
+	if (nx==2&&(func_num==6||func_num==7||func_num==8))
+		return "F6, F7 and F8 are NOT defined for D=2.";
+	return NULL;
+}
+
+void *load(int func_num, int nx)
+{
+	return cec22_get_context(nx,func_num);
+}
+
+void evaluate(void *context, double *x, double *f, int mx)
+{
+	cec22_context *c=(cec22_context *)context;
+	int i,nx=c->nx;
+	double *xsr=NULL,sh_rate=cec22_batch_sr(c->func_num);
+
+	if (mx>1&&sh_rate!=0.0)
+	{
+		xsr=(double *)malloc(sizeof(double)*nx*mx);
+		sr_block(x,xsr,nx,mx,c->OShift,c->M,sh_rate);
+	}
+
+	/* Individuals are independent; each thread works in its own y and z */
+#pragma omp parallel if (mx>1)
+	{
+		double *y=(double *)malloc(sizeof(double)*2*nx),*z=y+nx;
+#pragma omp for schedule(static)
+		for (i = 0; i < mx; i++)
+		{
+			if (xsr!=NULL)
+				cec22_eval(c,&xsr[i*nx],&f[i],-1,y,z);
+			else
+				cec22_eval(c,&x[i*nx],&f[i],1,y,z);
+		}
+		free(y);
+	}
+	free(xsr);
+}
+
+void clear()
+{
+	cec22_clear_cache();
+}
+
+int cec22_load_context(cec22_context *c, int nx, int func_num)
+{
+	FILE *fpt;
+	char FileName[1024],PackName[1024];
+	const char *root=dataRoot().c_str();
+	/* Components of the composition functions 9-12; their data files
+	   hold 10 matrices and shift vectors, or 8 matrices for D=2 */
+	static const int cf_comp[]={5,3,5,6};
+	int cf_num=func_num>=9?cf_comp[func_num-9]:12,i,j;
+	double *M=NULL,*OShift=NULL;
+	int *SS=NULL;
+	int nM=0,nOShift=0,nSS=0,ok=1;
+
+	c->nx=nx;
+	c->func_num=func_num;
+	sprintf(PackName, "%s/input_data22/cec22_F%d_D%d.pack", root, func_num,nx);
+	if (cec_pack_load(&c->pack,PackName,22,func_num,nx,&c->M,&c->OShift,&SS))
+	{
+		c->SS=SS;
+		return 1;
+	}
+
+	/* Load Matrix M*/
+	sprintf(FileName, "%s/input_data22/M_%d_D%d.txt", root, func_num,nx);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+	    printf("\n Error: Cannot open M_%d_D%d.txt for reading \n",func_num,nx);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	if (func_num<9)
+	{
+		nM=nx*nx;
+		M=(double*)malloc(nM*sizeof(double));
+		if (M==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<nx*nx; i++)
+		{
+			ok&=fscanf(fpt,"%lf",&M[i])==1;
+		}
+	}
+	else
+	{
+		nM=cf_num*nx*nx;
+		M=(double*)malloc(nM*sizeof(double));
+		if (M==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for (i=0; i<cf_num*nx*nx; i++)
+		{
+			ok&=fscanf(fpt,"%lf",&M[i])==1;
+		}
+	}
+	fclose(fpt);
+
+	/* Load shift_data */
+	sprintf(FileName, "%s/input_data22/shift_data_%d.txt", root, func_num);
+	fpt = fopen(FileName,"r");
+	if (fpt==NULL)
+	{
+		printf("\n Error: Cannot open shift_data_%d.txt for reading \n",func_num);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+
+	if (func_num<9)
+	{
+		nOShift=nx;
+		OShift=(double *)malloc(nOShift*sizeof(double));
+		if (OShift==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
+		{
+			ok&=fscanf(fpt,"%lf",&OShift[i])==1;
+		}
+	}
+	else
+	{
+            //OShift=(double *)malloc(nx*sizeof(double));
+		nOShift=nx*cf_num;
+		OShift=(double *)malloc(nOShift*sizeof(double));
+		if (OShift==NULL)
+		printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<cf_num-1;i++)
+		{
+			for (j=0;j<nx;j++)
+			{
+				ok&=fscanf(fpt,"%lf",&OShift[i*nx+j])==1;
+
+			}
+			fscanf(fpt,"%*[^\n]%*c");
+		}
+		for (j=0;j<nx;j++)
+		{
+ 				ok&=fscanf(fpt,"%lf",&OShift[nx*(cf_num-1)+j])==1;
+
+		}
+
+	}
+	fclose(fpt);
+
+
+	/* Load Shuffle_data */
+
+	if (func_num>=6&&func_num<=8)
+	{
+		sprintf(FileName, "%s/input_data22/shuffle_data_%d_D%d.txt", root, func_num, nx);
+		fpt = fopen(FileName,"r");
+		if (fpt==NULL)
+		{
+			printf("\n Error: Cannot open shuffle_data_%d_D%d.txt for reading \n", func_num, nx);
+			free(M);
+			free(OShift);
+			free(SS);
+			return 0;
+		}
+		nSS=nx;
+		SS=(int *)malloc(nSS*sizeof(int));
+		if (SS==NULL)
+			printf("\nError: there is insufficient memory available!\n");
+		for(i=0;i<nx;i++)
+		{
+			ok&=fscanf(fpt,"%d",&SS[i])==1;
+		}
+		fclose(fpt);
+	}
+
+	if (!ok)
+	{
+		printf("\n Error: Incomplete data for function %d, D=%d \n",func_num,nx);
+		free(M);
+		free(OShift);
+		free(SS);
+		return 0;
+	}
+	cec_pack_write(PackName,22,func_num,nx,M,nM,OShift,nOShift,SS,nSS);
+	c->M=M;
+	c->OShift=OShift;
+	c->SS=SS;
+	return 1;
+}
+
+void cec22_free_context(cec22_context *c)
+{
+	if (c->pack.base!=NULL)
+		cec_pack_close(&c->pack);
+	else
+	{
+		free(c->M);
+		free(c->OShift);
+		free(c->SS);
+	}
+	c->M=NULL;
+	c->OShift=NULL;
+	c->SS=NULL;
+	c->nx=0;
+	c->func_num=0;
+}
+
+cec22_context *cec22_get_context(int nx, int func_num)
+{
+	int i;
+	cec22_context *c;
+	for (i=0;i<ctx_num;i++)
+	{
+		if (ctx_cache[i]->func_num==func_num&&ctx_cache[i]->nx==nx)
+			return ctx_cache[i];
+	}
+	c=(cec22_context *)calloc(1,sizeof(cec22_context));
+	if (!cec22_load_context(c,nx,func_num))
+	{
+		free(c);
+		return NULL;
+	}
+	ctx_cache=(cec22_context **)realloc(ctx_cache,(ctx_num+1)*sizeof(cec22_context *));
+	ctx_cache[ctx_num++]=c;
+	return c;
+}
+
+void cec22_clear_cache(void)
+{
+	int i;
+	for (i=0;i<ctx_num;i++)
+	{
+		cec22_free_context(ctx_cache[i]);
+		free(ctx_cache[i]);
+	}
+	free(ctx_cache);
+	ctx_cache=NULL;
+	ctx_num=0;
+}
+
+void cec22_eval(cec22_context *c, double *x, double *f, int sr, double *y, double *z)
+{
+	int nx=c->nx;
+	double *OShift=c->OShift,*M=c->M;
+	int *SS=c->SS;
+	switch(c->func_num)
+	{
+	case 1:
+		zakharov_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=300.0;
+		break;
+	case 2:
+		rosenbrock_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=400.0;
+		break;
+	case 3:
+		schaffer_F7_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=600.0;
+		break;
+	case 4:
+            step_rastrigin_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=800.0;
+		break;
+	case 5:
+		levy_func(x,f,nx,OShift,M,sr,sr,y,z);
+		f[0]+=900.0;
+		break;
+	case 6:
+		hf02(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=1800.0;
+		break;
+	case 7:
+		hf10(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=2000.0;
+		break;
+	case 8:
+		hf06(x,f,nx,OShift,M,SS,sr,sr,y,z);
+		f[0]+=2200.0;
+		break;
+	case 9:
+		cf01(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2300.0;
+		break;
+	case 10:
+		cf02(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2400.0;
+		break;
+        case 11:
+            cf06(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2600.0;
+		break;
+        case 12:
+            cf07(x,f,nx,OShift,M,1,y,z);
+		f[0]+=2700.0;
+		break;
+	default:
+		printf("\nError: There are only 10 test functions in this test suite!\n");
+		f[0] = 0.0;
+		break;
+	}
+}
+
+/* Shrink rate of the functions whose kernels only see x through sr_func,
+   so that the shift, shrink and rotation can be applied to the whole
+   population up front; 0 for the others */
+double cec22_batch_sr(int func_num)
+{
+	switch(func_num)
+	{
+	case 1:
+		return 1.0;
+	case 2:
+		return 2.048/100.0;
+	case 5:
+		return 1.0;
+	case 6:
+		return 1.0;
+	case 7:
+		return 1.0;
+	case 8:
+		return 1.0;
+	default:
+		return 0.0;
+	}
+
+}
+
+
+void levy_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Levy */
+{
+    int i;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	double *w;
+	w=(double *)malloc(sizeof(double)  *  nx);
+
+	for (i=0; i<nx; i++)
+	{
+	   w[i] = 1.0 + (z[i] - 0.0)/4.0;
+	}
+
+	double term1 = pow((sin(PI*w[0])),2);
+	double term3 = pow((w[nx-1]-1),2) * (1+pow((sin(2*PI*w[nx-1])),2));
+
+	double sum = 0.0;
+
+	for (i=0; i<nx-1; i++)
+	{
+		double wi = w[i];
+        double newv = pow((wi-1),2) * (1+10*pow((sin(PI*wi+1)),2));
+		sum = sum + newv;
+	}
+
+	f[0] = term1 + sum + term3;
+	free(w);   // ADD THIS LINE to free memory! Thanks for Dr. Janez
+}
+
+
+void hf02 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 2 */
+{
+	int i,tmp,cf_num=3;
+	double fit[3];
+	int G[3],G_nx[3];
+	double Gp[3]={0.4,0.4,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	bent_cigar_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf10 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=6;
+	double fit[6];
+	int G[6],G_nx[6];
+	double Gp[6]={0.1,0.2,0.2,0.2,0.1,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+
+	i=0;
+	hgbat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	rastrigin_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=5;
+	schaffer_F7_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void hf06 (double *x, double *f, int nx, double *Os,double *Mr,int *S,int s_flag,int r_flag,double *y,double *z) /* Hybrid Function 6 */
+{
+	int i,tmp,cf_num=5;
+	double fit[5];
+	int G[5],G_nx[5];
+	double Gp[5]={0.3,0.2,0.2,0.1,0.2};
+
+	tmp=0;
+	for (i=0; i<cf_num-1; i++)
+	{
+		G_nx[i] = ceil(Gp[i]*nx);
+		tmp += G_nx[i];
+	}
+	G_nx[cf_num-1]=nx-tmp;
+
+	G[0]=0;
+	for (i=1; i<cf_num; i++)
+	{
+		G[i] = G[i-1]+G_nx[i-1];
+	}
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		y[i]=z[S[i]-1];
+	}
+	i=0;
+	katsuura_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=1;
+	happycat_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=2;
+	grie_rosen_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=3;
+	schwefel_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	i=4;
+	ackley_func(&y[G[i]],&fit[i],G_nx[i],Os,Mr,0,0,y,z);
+	f[0]=0.0;
+	for(i=0;i<cf_num;i++)
+	{
+		f[0] += fit[i];
+	}
+}
+
+void cf01 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 1 */
+{
+	int i,cf_num=5;
+	double fit[5];
+	double delta[5] = {10, 20, 30, 40, 50};
+	double bias[5] = {0, 200, 300, 100, 400};
+
+	i=0;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+4;
+	i=1;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=2;
+	bent_cigar_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+30;
+	i=3;
+	discus_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=4;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,0,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+void cf02 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 2 */
+{
+	int i,cf_num=3;
+	double fit[3];
+	double delta[3] = {20,10,10};
+	double bias[3] = {0, 200, 100};
+
+	i=0;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,0,y,z);
+	i=1;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=2;
+	hgbat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+
+void cf06 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{
+	int i,cf_num=5;
+	double fit[5];
+	double delta[5] = {20,20,30,30,20};
+	double bias[5] = {0, 200, 300, 400, 200};
+	i=0;
+	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/2e+7;
+	i=1;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=2;
+	griewank_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=1000*fit[i]/100;
+	i=3;
+	rosenbrock_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	i=4;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+3;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+void cf07 (double *x, double *f, int nx, double *Os,double *Mr,int r_flag,double *y,double *z) /* Composition Function 4 */
+{
+	int i,cf_num=6;
+	double fit[6];
+	double delta[6] = {10,20,30,40,50,60};
+	double bias[6] = {0, 300, 500, 100, 400, 200};
+	i=0;
+	hgbat_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1000;
+	i=1;
+	rastrigin_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+3;
+	i=2;
+	schwefel_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/4e+3;
+	i=3;
+	bent_cigar_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+30;
+	i=4;
+	ellips_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/1e+10;
+	i=5;
+	escaffer6_func(x,&fit[i],nx,&Os[i*nx],&Mr[i*nx*nx],1,r_flag,y,z);
+	fit[i]=10000*fit[i]/2e+7;
+	cf_cal(x, f, nx, Os, delta,bias,fit,cf_num);
+}
+
+
+} // namespace cec22
+} // namespace cec
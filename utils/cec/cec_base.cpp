@@ -0,0 +1,755 @@
+/*
+  Base functions and transformations shared by the CEC suites, see
+  cec_base.h. Taken from the CEC 2017 code of Noor Awad; the CEC 2019,
+  2020 and 2022 suites carried identical copies.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef USE_BLAS
+#include "blas.h"
+#endif
+#include "cec_base.h"
+
+#define SR_BLOCK 16
+
+namespace cec {
+
+void sphere_func (double *x, double *f, int nx, double *Os, double *Mr, int s_flag, int r_flag,double *y,double *z) /* Sphere */
+{
+	int i;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */	
+	for (i=0; i<nx; i++)
+	{					
+		f[0] += z[i]*z[i];
+	}
+
+}
+
+void ellips_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Ellipsoidal */
+{
+    int i;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); /* shift and rotate */
+	for (i=0; i<nx; i++)
+	{
+       f[0] += pow(10.0,6.0*i/(nx-1))*z[i]*z[i];
+	}
+}
+
+void sum_diff_pow_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* sum of different power */
+{
+    int i;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); // shift and rotate 
+	f[0] = 0.0; 
+	double sum = 0.0;
+	for (i=0; i<nx; i++)
+	{
+		double xi = z[i];
+		double newv = pow((abs(xi)),(i+1));
+		sum = sum + newv;
+	}
+	
+	f[0] = sum;
+}
+
+void zakharov_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* zakharov */
+{
+	int i;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); // shift and rotate 
+	f[0] = 0.0; 
+	double sum1 = 0.0;
+	double sum2 = 0.0;
+	for (i=0; i<nx; i++)
+	{
+		double xi = z[i];
+		sum1 = sum1 + pow(xi,2);
+		sum2 = sum2 + 0.5*(i+1)*xi;
+	}
+	
+	f[0] = sum1 + pow(sum2,2) + pow(sum2,4);
+}
+
+/* Levy function */
+void levy_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Levy */
+{
+    int i;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); /* shift and rotate */
+	
+	double *w;
+	w=(double *)malloc(sizeof(double)  *  nx);
+
+	for (i=0; i<nx; i++)
+	{
+	   w[i] = 1.0 + (z[i] - 1.0)/4.0;
+	}
+	
+	double term1 = pow((sin(PI*w[0])),2);
+	double term3 = pow((w[nx-1]-1),2) * (1+pow((sin(2*PI*w[nx-1])),2));
+	
+	double sum = 0.0;
+
+	for (i=0; i<nx-1; i++)
+	{
+		double wi = w[i];
+        double newv = pow((wi-1),2) * (1+10*pow((sin(PI*wi+1)),2));
+		sum = sum + newv;
+	}
+	
+	f[0] = term1 + sum + term3;
+	free(w);   // ADD THIS LINE to free memory! Thanks for Dr. Janez
+}
+
+/* Dixon and Price */
+void dixon_price_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Dixon and Price */
+{
+	int i;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); // shift and rotate 
+	f[0] = 0;
+	double x1 = z[0];;
+	double term1 = pow((x1-1),2);
+	
+	double sum = 0;
+	for (i=1; i<nx; i++)
+	{
+		double xi = z[i];
+		double xold = z[i-1];
+		double newv = i * pow((pow(2*xi,2) - xold),2);
+		sum = sum + newv;
+	}
+	
+	f[0] = term1 + sum;
+}
+
+void bent_cigar_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Bent_Cigar */
+{
+    int i;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); /* shift and rotate */
+	f[0] = z[0]*z[0];
+	for (i=1; i<nx; i++)
+	{
+		f[0] += pow(10.0,6.0)*z[i]*z[i];
+	}
+
+}
+
+void discus_func (double *x, double *f, int nx, double *Os,double *Mr, int s_flag, int r_flag,double *y,double *z) /* Discus */
+{
+    int i;
+	sr_func (x, z, nx, Os, Mr,1.0, s_flag, r_flag, y); /* shift and rotate */
+	f[0] = pow(10.0,6.0)*z[0]*z[0];
+	for (i=1; i<nx; i++)
+	{
+		f[0] += z[i]*z[i];
+	}
+}
+
+void dif_powers_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Different Powers */
+{
+	int i;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		f[0] += pow(fabs(z[i]),2+4*i/(nx-1));
+	}
+	f[0]=pow(f[0],0.5);
+}
+
+void rosenbrock_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Rosenbrock's */
+{
+    int i;
+	double tmp1,tmp2;
+	f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr, 2.048/100.0, s_flag, r_flag, y); /* shift and rotate */
+	z[0] += 1.0;//shift to orgin
+	for (i=0; i<nx-1; i++)
+	{
+		z[i+1] += 1.0;//shift to orgin
+		tmp1=z[i]*z[i]-z[i+1];
+		tmp2=z[i]-1.0;
+		f[0] += 100.0*tmp1*tmp1 +tmp2*tmp2;
+	}
+}
+
+void schaffer_F7_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Schwefel's 1.2  */
+{
+    int i;
+	double tmp;
+    f[0] = 0.0;
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+	for (i=0; i<nx-1; i++)	
+	{
+		z[i]=pow(y[i]*y[i]+y[i+1]*y[i+1],0.5);
+		tmp=sin(50.0*pow(z[i],0.2));
+		f[0] += pow(z[i],0.5)+pow(z[i],0.5)*tmp*tmp ;
+	}
+	f[0] = f[0]*f[0]/(nx-1)/(nx-1);
+}
+
+void ackley_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Ackley's  */
+{
+    int i;
+    double sum1, sum2;
+    sum1 = 0.0;
+    sum2 = 0.0;
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+#pragma omp simd reduction(+:sum1,sum2)
+	for (i=0; i<nx; i++)
+	{
+		sum1 += z[i]*z[i];
+		sum2 += cos(2.0*PI*z[i]);
+	}
+	sum1 = -0.2*sqrt(sum1/nx);
+	sum2 /= nx;
+		f[0] =  E - 20.0*exp(sum1) - exp(sum2) +20.0;
+}
+
+/* a^k and 2*PI*b^k for a = 0.5, b = 3, k = 0..20. The powers are exact, so
+   the table entries round exactly as the products evaluated in the loop. */
+static const double weierstrass_ak[21]=
+{
+	1.0, 1.0/2.0, 1.0/4.0, 1.0/8.0,
+	1.0/16.0, 1.0/32.0, 1.0/64.0, 1.0/128.0,
+	1.0/256.0, 1.0/512.0, 1.0/1024.0, 1.0/2048.0,
+	1.0/4096.0, 1.0/8192.0, 1.0/16384.0, 1.0/32768.0,
+	1.0/65536.0, 1.0/131072.0, 1.0/262144.0, 1.0/524288.0,
+	1.0/1048576.0
+};
+static const double weierstrass_bk[21]=
+{
+	2.0*PI*1.0, 2.0*PI*3.0, 2.0*PI*9.0, 2.0*PI*27.0,
+	2.0*PI*81.0, 2.0*PI*243.0, 2.0*PI*729.0, 2.0*PI*2187.0,
+	2.0*PI*6561.0, 2.0*PI*19683.0, 2.0*PI*59049.0, 2.0*PI*177147.0,
+	2.0*PI*531441.0, 2.0*PI*1594323.0, 2.0*PI*4782969.0, 2.0*PI*14348907.0,
+	2.0*PI*43046721.0, 2.0*PI*129140163.0, 2.0*PI*387420489.0, 2.0*PI*1162261467.0,
+	2.0*PI*3486784401.0
+};
+
+void weierstrass_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Weierstrass's  */
+{
+    int i,j,k_max;
+    double sum,sum2,zi;
+    k_max = 20;
+    f[0] = 0.0;
+
+	sr_func (x, z, nx, Os, Mr, 0.5/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	sum2 = 0.0;
+	for (j=0; j<=k_max; j++)
+	{
+		sum2 += weierstrass_ak[j]*cos(weierstrass_bk[j]*0.5);
+	}
+	for (i=0; i<nx; i++)
+	{
+		sum = 0.0;
+		zi = z[i]+0.5;
+#pragma omp simd reduction(+:sum)
+		for (j=0; j<=k_max; j++)
+		{
+			sum += weierstrass_ak[j]*cos(weierstrass_bk[j]*zi);
+		}
+		f[0] += sum;
+	}
+	f[0] -= nx*sum2;
+}
+
+void griewank_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Griewank's  */
+{
+    int i;
+    double s, p;
+    s = 0.0;
+    p = 1.0;
+
+	sr_func (x, z, nx, Os, Mr, 600.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		s += z[i]*z[i];
+		p *= cos(z[i]/sqrt(1.0+i));
+	}
+	f[0] = 1.0 + s/4000.0 - p;
+}
+
+void rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Rastrigin's  */
+{
+    int i;
+	double sum=0.0;
+
+	sr_func (x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+#pragma omp simd reduction(+:sum)
+	for (i=0; i<nx; i++)
+	{
+		sum += (z[i]*z[i] - 10.0*cos(2.0*PI*z[i]) + 10.0);
+	}
+	f[0] = sum;
+}
+
+void step_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Noncontinuous Rastrigin's  */
+{
+    int i;
+	f[0]=0.0;
+	for (i=0; i<nx; i++)
+	{
+		if (fabs(y[i]-Os[i])>0.5)
+		y[i]=Os[i]+floor(2*(y[i]-Os[i])+0.5)/2;
+	}
+
+	sr_func (x, z, nx, Os, Mr, 5.12/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		f[0] += (z[i]*z[i] - 10.0*cos(2.0*PI*z[i]) + 10.0);
+	}
+}
+
+void schwefel_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Schwefel's  */
+{
+    int i;
+	double tmp,r;
+	f[0]=0.0;
+
+	sr_func (x, z, nx, Os, Mr, 1000.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	for (i=0; i<nx; i++)
+	{
+		z[i] += 4.209687462275036e+002;
+		if (z[i]>500)
+		{
+			r=500.0-fmod(z[i],500);
+			f[0]-=r*sin(sqrt(r));
+			tmp=(z[i]-500.0)/100;
+			f[0]+= tmp*tmp/nx;
+		}
+		else if (z[i]<-500)
+		{
+			r=fmod(fabs(z[i]),500);
+			f[0]-=(-500.0+r)*sin(sqrt(500.0-r));
+			tmp=(z[i]+500.0)/100;
+			f[0]+= tmp*tmp/nx;
+		}
+		else
+			f[0]-=z[i]*sin(sqrt(fabs(z[i])));
+		}
+		f[0] +=4.189828872724338e+002*nx;
+
+}
+
+/* 2^j and 2^-j for j = 1..32 */
+static const double katsuura_pow2[32]=
+{
+	2.0, 4.0, 8.0, 16.0, 32.0, 64.0,
+	128.0, 256.0, 512.0, 1024.0, 2048.0, 4096.0,
+	8192.0, 16384.0, 32768.0, 65536.0, 131072.0, 262144.0,
+	524288.0, 1048576.0, 2097152.0, 4194304.0, 8388608.0, 16777216.0,
+	33554432.0, 67108864.0, 134217728.0, 268435456.0, 536870912.0, 1073741824.0,
+	2147483648.0, 4294967296.0
+};
+static const double katsuura_pow2inv[32]=
+{
+	1.0/2.0, 1.0/4.0, 1.0/8.0, 1.0/16.0, 1.0/32.0,
+	1.0/64.0, 1.0/128.0, 1.0/256.0, 1.0/512.0, 1.0/1024.0,
+	1.0/2048.0, 1.0/4096.0, 1.0/8192.0, 1.0/16384.0, 1.0/32768.0,
+	1.0/65536.0, 1.0/131072.0, 1.0/262144.0, 1.0/524288.0, 1.0/1048576.0,
+	1.0/2097152.0, 1.0/4194304.0, 1.0/8388608.0, 1.0/16777216.0, 1.0/33554432.0,
+	1.0/67108864.0, 1.0/134217728.0, 1.0/268435456.0, 1.0/536870912.0, 1.0/1073741824.0,
+	1.0/2147483648.0, 1.0/4294967296.0
+};
+
+void katsuura_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Katsuura  */
+{
+    int i,j;
+	double temp,tmp1,tmp3,zi;
+	f[0]=1.0;
+	tmp3=10.0/pow(1.0*nx,1.2);
+
+	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+    for (i=0; i<nx; i++)
+	{
+		temp=0.0;
+		zi=z[i];
+#pragma omp simd reduction(+:temp)
+		for (j=0; j<32; j++)
+		{
+			double tmp2=katsuura_pow2[j]*zi;
+			temp += fabs(tmp2-floor(tmp2+0.5))*katsuura_pow2inv[j];
+		}
+		f[0] *= pow(1.0+(i+1)*temp,tmp3);
+    }
+	tmp1=10.0/nx/nx;
+    f[0]=f[0]*tmp1-tmp1;
+
+}
+
+void bi_rastrigin_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Lunacek Bi_rastrigin Function */
+{
+    int i;
+	double mu0=2.5,d=1.0,s,mu1,tmp,tmp1,tmp2;
+	double *tmpx;
+	tmpx=(double *)malloc(sizeof(double)  *  nx);
+	s=1.0-1.0/(2.0*pow(nx+20.0,0.5)-8.2);
+	mu1=-pow((mu0*mu0-d)/s,0.5);
+
+	if (s_flag==1)
+		shiftfunc(x, y, nx, Os);
+	else
+	{
+		for (i=0; i<nx; i++)//shrink to the orginal search range
+		{
+			y[i] = x[i];
+		}
+	}
+	for (i=0; i<nx; i++)//shrink to the orginal search range
+    {
+        y[i] *= 10.0/100.0;
+    }
+
+	for (i = 0; i < nx; i++)
+    {
+		tmpx[i]=2*y[i];
+        if (Os[i] < 0.0)
+            tmpx[i] *= -1.;
+    }
+	for (i=0; i<nx; i++)
+	{
+		z[i]=tmpx[i];
+		tmpx[i] += mu0;
+	}
+    tmp1=0.0;tmp2=0.0;
+	for (i=0; i<nx; i++)
+	{
+		tmp = tmpx[i]-mu0;
+		tmp1 += tmp*tmp;
+		tmp = tmpx[i]-mu1;
+		tmp2 += tmp*tmp;
+	}
+	tmp2 *= s;
+	tmp2 += d*nx;
+	tmp=0.0;
+
+	if (r_flag==1)
+	{
+		rotatefunc(z, y, nx, Mr);
+		for (i=0; i<nx; i++)
+		{
+			tmp+=cos(2.0*PI*y[i]);
+		}	
+		if(tmp1<tmp2)
+			f[0] = tmp1;
+		else
+			f[0] = tmp2;
+		f[0] += 10.0*(nx-tmp);
+	}
+	else
+	{
+		for (i=0; i<nx; i++)
+		{
+			tmp+=cos(2.0*PI*z[i]);
+		}	
+		if(tmp1<tmp2)
+			f[0] = tmp1;
+		else
+			f[0] = tmp2;
+		f[0] += 10.0*(nx-tmp);
+	}
+
+	free(tmpx);
+}
+
+void grie_rosen_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Griewank-Rosenbrock  */
+{
+    int i;
+    double temp,tmp1,tmp2;
+    f[0]=0.0;
+
+	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	z[0] += 1.0;//shift to orgin
+    for (i=0; i<nx-1; i++)
+    {
+		z[i+1] += 1.0;//shift to orgin
+		tmp1 = z[i]*z[i]-z[i+1];
+		tmp2 = z[i]-1.0;
+        temp = 100.0*tmp1*tmp1 + tmp2*tmp2;
+         f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0;
+    }
+	tmp1 = z[nx-1]*z[nx-1]-z[0];
+	tmp2 = z[nx-1]-1.0;
+    temp = 100.0*tmp1*tmp1 + tmp2*tmp2;;
+    f[0] += (temp*temp)/4000.0 - cos(temp) + 1.0 ;
+}
+
+void escaffer6_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* Expanded Scaffer's F6  */
+{
+    int i;
+    double temp1, temp2;
+
+	sr_func (x, z, nx, Os, Mr, 1.0, s_flag, r_flag, y); /* shift and rotate */
+
+    f[0] = 0.0;
+    for (i=0; i<nx-1; i++)
+    {
+        temp1 = sin(sqrt(z[i]*z[i]+z[i+1]*z[i+1]));
+		temp1 =temp1*temp1;
+        temp2 = 1.0 + 0.001*(z[i]*z[i]+z[i+1]*z[i+1]);
+        f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
+    }
+    temp1 = sin(sqrt(z[nx-1]*z[nx-1]+z[0]*z[0]));
+	temp1 =temp1*temp1;
+    temp2 = 1.0 + 0.001*(z[nx-1]*z[nx-1]+z[0]*z[0]);
+    f[0] += 0.5 + (temp1-0.5)/(temp2*temp2);
+}
+
+void happycat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* HappyCat, provdided by Hans-Georg Beyer (HGB) */
+/* original global optimum: [-1,-1,...,-1] */
+{
+	int i;
+	double alpha,r2,sum_z;
+	alpha=1.0/8.0;
+	
+	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	r2 = 0.0;
+	sum_z=0.0;
+    for (i=0; i<nx; i++)
+    {
+		z[i]=z[i]-1.0;//shift to orgin
+        r2 += z[i]*z[i];
+		sum_z += z[i];
+    }
+    f[0]=pow(fabs(r2-nx),2*alpha) + (0.5*r2 + sum_z)/nx + 0.5;
+}
+
+void hgbat_func (double *x, double *f, int nx, double *Os,double *Mr,int s_flag, int r_flag,double *y,double *z) /* HGBat, provdided by Hans-Georg Beyer (HGB)*/
+/* original global optimum: [-1,-1,...,-1] */
+{
+	int i;
+	double alpha,r2,sum_z;
+	alpha=1.0/4.0;
+
+	sr_func (x, z, nx, Os, Mr, 5.0/100.0, s_flag, r_flag, y); /* shift and rotate */
+
+	r2 = 0.0;
+	sum_z=0.0;
+    for (i=0; i<nx; i++)
+    {
+		z[i]=z[i]-1.0;//shift to orgin
+        r2 += z[i]*z[i];
+		sum_z += z[i];
+    }
+    f[0]=pow(fabs(pow(r2,2.0)-pow(sum_z,2.0)),2*alpha) + (0.5*r2 + sum_z)/nx + 0.5;
+}
+
+void shiftfunc (double *x, double *xshift, int nx,double *Os)
+{
+	int i;
+    for (i=0; i<nx; i++)
+    {
+        xshift[i]=x[i]-Os[i];
+    }
+}
+
+void rotatefunc (double *x, double *xrot, int nx,double *Mr)
+{
+	int i,j;
+    for (i=0; i<nx; i++)
+    {
+        xrot[i]=0;
+			for (j=0; j<nx; j++)
+			{
+				xrot[i]=xrot[i]+x[j]*Mr[i*nx+j];
+			}
+    }
+}
+
+void sr_func (double *x, double *sr_x, int nx, double *Os,double *Mr, double sh_rate, int s_flag,int r_flag,double *y) /* shift and rotate */
+{
+	int i;
+	if (s_flag<0)
+	{
+		/* x was shifted, shrunk and rotated by sr_block */
+		memcpy(sr_x, x, sizeof(double)*nx);
+	}
+	else if (s_flag==1)
+	{
+		if (r_flag==1)
+		{	
+			shiftfunc(x, y, nx, Os);
+			for (i=0; i<nx; i++)//shrink to the orginal search range
+			{
+				y[i]=y[i]*sh_rate;
+			}
+			rotatefunc(y, sr_x, nx, Mr);
+		}
+		else
+		{
+			shiftfunc(x, sr_x, nx, Os);
+			for (i=0; i<nx; i++)//shrink to the orginal search range
+			{
+				sr_x[i]=sr_x[i]*sh_rate;
+			}
+		}
+	}
+	else
+	{	
+
+		if (r_flag==1)
+		{	
+			for (i=0; i<nx; i++)//shrink to the orginal search range
+			{
+				y[i]=x[i]*sh_rate;
+			}
+			rotatefunc(y, sr_x, nx, Mr);
+		}
+		else
+		for (i=0; i<nx; i++)//shrink to the orginal search range
+		{
+			sr_x[i]=x[i]*sh_rate;
+		}
+	}
+}
+
+/* Shift, shrink and rotate all mx columns of x at once, as sr_func does
+   for one, xsr(:,k) = Mr*((x(:,k)-Os)*sh_rate). The rotation is one
+   matrix-matrix product, blocked over the columns so that each row of Mr
+   is reused by SR_BLOCK individuals while in cache. The sums are formed
+   in the order of rotatefunc, so the result is bitwise that of sr_func
+   unless USE_BLAS is set. Callers pass the columns on with s_flag=-1. */
+void sr_block (double *x, double *xsr, int nx, int mx, double *Os, double *Mr, double sh_rate)
+{
+	int i,j,k,kb,ke;
+	double *xs,s;
+	xs=(double *)malloc(sizeof(double)*nx*mx);
+	for (k=0; k<mx; k++)
+	{
+		for (i=0; i<nx; i++)
+		{
+			xs[k*nx+i]=x[k*nx+i]-Os[i];
+			xs[k*nx+i]=xs[k*nx+i]*sh_rate;
+		}
+	}
+#ifdef USE_BLAS
+	{
+		/* Mr is stored row-wise, so xsr = Mr'*xs in column-major terms */
+		ptrdiff_t n=nx,m=mx;
+		double one=1.0,zero=0.0;
+		dgemm("T","N",&n,&m,&n,&one,Mr,&n,xs,&n,&zero,xsr,&n);
+	}
+#else
+#pragma omp parallel for private(i,j,k,ke,s) schedule(static)
+	for (kb=0; kb<mx; kb+=SR_BLOCK)
+	{
+		ke=kb+SR_BLOCK<mx ? kb+SR_BLOCK : mx;
+		for (i=0; i<nx; i++)
+		{
+			for (k=kb; k<ke; k++)
+			{
+				s=0;
+				for (j=0; j<nx; j++)
+				{
+					s=s+xs[k*nx+j]*Mr[i*nx+j];
+				}
+				xsr[k*nx+i]=s;
+			}
+		}
+	}
+#endif
+	free(xs);
+}
+
+void asyfunc (double *x, double *xasy, int nx, double beta)
+{
+	int i;
+    for (i=0; i<nx; i++)
+    {
+		if (x[i]>0)
+        xasy[i]=pow(x[i],1.0+beta*i/(nx-1)*pow(x[i],0.5));
+    }
+}
+
+void oszfunc (double *x, double *xosz, int nx)
+{
+	int i,sx;
+	double c1,c2,xx;
+    for (i=0; i<nx; i++)
+    {
+		if (i==0||i==nx-1)
+        {
+			if (x[i]!=0)
+				xx=log(fabs(x[i]));
+			else
+				xx=0.0;
+			if (x[i]>0)
+			{	
+				c1=10;
+				c2=7.9;
+			}
+			else
+			{
+				c1=5.5;
+				c2=3.1;
+			}	
+			if (x[i]>0)
+				sx=1;
+			else if (x[i]==0)
+				sx=0;
+			else
+				sx=-1;
+			xosz[i]=sx*exp(xx+0.049*(sin(c1*xx)+sin(c2*xx)));
+		}
+		else
+			xosz[i]=x[i];
+    }
+}
+
+void cf_cal(double *x, double *f, int nx, double *Os,double * delta,double * bias,double * fit, int cf_num)
+{
+	int i,j;
+	double *w;
+	double w_max=0,w_sum=0;
+	w=(double *)malloc(cf_num * sizeof(double));
+	for (i=0; i<cf_num; i++)
+	{
+		fit[i]+=bias[i];
+		w[i]=0;
+		for (j=0; j<nx; j++)
+		{
+			w[i]+=pow(x[j]-Os[i*nx+j],2.0);
+		}
+		if (w[i]!=0)
+			w[i]=pow(1.0/w[i],0.5)*exp(-w[i]/2.0/nx/pow(delta[i],2.0));
+		else
+			w[i]=INF;
+		if (w[i]>w_max)
+			w_max=w[i];
+	}
+
+	for (i=0; i<cf_num; i++)
+	{
+		w_sum=w_sum+w[i];
+	}
+	if(w_max==0)
+	{
+		for (i=0; i<cf_num; i++)
+			w[i]=1;
+		w_sum=cf_num;
+	}
+	f[0] = 0.0;
+    for (i=0; i<cf_num; i++)
+    {
+		f[0]=f[0]+w[i]/w_sum*fit[i];
+    }
+	free(w);
+}
+
+} // namespace cec
@@ -0,0 +1,61 @@
+/*
+  Base functions and transformations shared by the CEC suites, see
+  cec_base.cpp. The suites build their hybrid and composition functions
+  from these, and differ only in their data and in the bias they add.
+
+  All base functions have the form
+
+    name_func(x, f, nx, Os, Mr, s_flag, r_flag, y, z)
+
+  and evaluate one individual x [nx] into f[0], shifting x by Os if
+  s_flag is 1 and rotating it by the nx*nx row-major matrix Mr if r_flag
+  is 1. s_flag=-1 says that sr_block has already shifted, shrunk and
+  rotated x. y and z are scratch vectors of nx entries owned by the caller, so
+  that any number of threads can evaluate at once; the hybrid functions
+  pass their own y and z on, with x pointing into y.
+*/
+#ifndef CEC_BASE_H
+#define CEC_BASE_H
+
+#define INF 1.0e99
+#define EPS 1.0e-14
+#define E  2.7182818284590452353602874713526625
+#define PI 3.1415926535897932384626433832795029
+
+namespace cec {
+
+void sphere_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Sphere */
+void ellips_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Ellipsoidal */
+void bent_cigar_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Bent_Cigar */
+void discus_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Discus */
+void dif_powers_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Different Powers */
+void rosenbrock_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Rosenbrock's */
+void schaffer_F7_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Schwefel's F7 */
+void ackley_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Ackley's */
+void rastrigin_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Rastrigin's  */
+void weierstrass_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Weierstrass's  */
+void griewank_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Griewank's  */
+void schwefel_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Schwefel's */
+void katsuura_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Katsuura */
+void bi_rastrigin_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Lunacek Bi_rastrigin */
+void grie_rosen_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Griewank-Rosenbrock  */
+void escaffer6_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Expanded Scaffer's F6  */
+void step_rastrigin_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Noncontinuous Rastrigin's  */
+void happycat_func (double *, double *, int , double *,double *, int, int,double *,double *); /* HappyCat */
+void hgbat_func (double *, double *, int , double *,double *, int, int,double *,double *); /* HGBat  */
+void sum_diff_pow_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Sum of different power */
+void zakharov_func (double *, double *, int , double *,double *, int, int,double *,double *); /* ZAKHAROV */
+void levy_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Levy */
+void dixon_price_func (double *, double *, int , double *,double *, int, int,double *,double *); /* Dixon and Price */
+
+void shiftfunc (double*,double*,int,double*);
+void rotatefunc (double*,double*,int, double*);
+void sr_func (double *, double *, int, double*, double*, double, int, int, double*); /* shift and rotate */
+void sr_block (double *, double *, int, int, double*, double*, double); /* shift and rotate a population */
+void asyfunc (double *, double *x, int, double);
+void oszfunc (double *, double *, int);
+void cf_cal(double *, double *, int, double *,double *,double *,double *,int);
+
+} // namespace cec
+
+#endif /* CEC_BASE_H */
@@ -0,0 +1,265 @@
+//
+// Headless throughput benchmark for the CEC benchmark library.
+//
+// Usage:
+//   cec_benchmark [--suite 17,19,20,22] [--funcs 1,3,4] [--dims 10,30]
+//                 [--pop 100] [--time 0.5] [--threads 1,4] [--data DIR]
+//                 [--dump FILE | --compare FILE | --reference] [--tol ULP]
+//
+// For every suite, function and dimension, a fixed population drawn
+// uniformly from [-100, 100]^D is evaluated repeatedly for at least --time
+// seconds, and the table reports evaluations (columns) per second.
+// Combinations that are not defined by a suite are skipped, so the default
+// dimension lists can be shared. --dump writes the objective values of the
+// population, and --compare reports the largest difference in ulp to a dump
+// written by another build, e.g. before and after a change to the kernels.
+// --reference instead evaluates the population with the kernels as they were
+// before the library (reference/cecXX_ref.cpp).
+//
+// With --compare or --reference the exit status is 1 if any difference
+// exceeds --tol ulp, by default 0. Against the reference, allow 8 ulp (the
+// ctest setting): the library takes sqrt for pow(x,0.5) and sums some
+// kernels in SIMD lanes under OpenMP, which moves a few values by 1-2 ulp.
+// Populations shifted and rotated at once by sr_block give bitwise the
+// values of single individuals, unless -DUSE_BLAS leaves the order of the
+// rotation sums to dgemm; a BLAS that reorders them, or -ffast-math, may
+// need a looser --tol.
+//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "cec.h"
+#include "reference/cec_reference.h"
+
+#define TIME_NOW std::chrono::high_resolution_clock::now
+
+typedef std::map<std::vector<int>, double> Dump;
+
+std::vector<int> parseList(const char * s) {
+    std::vector<int> out;
+    while (*s) {
+        char * end;
+        out.push_back(std::strtol(s, &end, 10));
+        s = *end ? end + 1 : end;
+    }
+    return out;
+}
+
+// Distance between two doubles in units in the last place.
+int64_t ulpDistance(double a, double b) {
+    int64_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(a));
+    std::memcpy(&ib, &b, sizeof(b));
+    if (ia < 0) ia = INT64_MIN - ia;
+    if (ib < 0) ib = INT64_MIN - ib;
+    return ia > ib ? ia - ib : ib - ia;
+}
+
+bool readDump(const char * file, Dump & dump) {
+    FILE * fp = std::fopen(file, "r");
+    if (fp == NULL) {
+        return false;
+    }
+    int suite, id, dim, i;
+    double f;
+    while (std::fscanf(fp, "%d %d %d %d %lf", &suite, &id, &dim, &i, &f) == 5) {
+        std::vector<int> key = {suite, id, dim, i};
+        dump[key] = f;
+    }
+    std::fclose(fp);
+    return true;
+}
+
+// Evaluate with the kernel of the suite from before the library.
+void referenceEvaluate(int suite, int id, int dim, double * x, double * f, int pop) {
+    switch (suite) {
+    case 17:
+        cec17_ref::cec17_test_func(x, f, dim, pop, id);
+        break;
+    case 19: {
+        static std::string dir;
+        if (dir.empty()) {
+            dir = cec::dataRoot() + "/input_data_cec2019";
+            cec19_ref::set_dir_path(dir.c_str());
+        }
+        cec19_ref::cec19_test_func(x, f, dim, pop, id);
+        break;
+    }
+    case 20:
+        cec20_ref::cec20_test_func(x, f, dim, pop, id);
+        break;
+    case 22:
+        cec22_ref::cec22_test_func(x, f, dim, pop, id);
+        break;
+    }
+}
+
+int main(int argc, char ** argv) {
+    std::vector<int> suites = {17, 19, 20, 22};
+    std::vector<int> funcs, dims, threads;
+    int pop = 100;
+    double minTime = 0.5;
+    const char * dumpFile = NULL;
+    const char * compareFile = NULL;
+    bool useReference = false;
+    int64_t tol = 0;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--suite") && hasValue) {
+            suites = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--funcs") && hasValue) {
+            funcs = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--dims") && hasValue) {
+            dims = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--pop") && hasValue) {
+            pop = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--time") && hasValue) {
+            minTime = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--threads") && hasValue) {
+            threads = parseList(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--data") && hasValue) {
+            cec::setDataRoot(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--dump") && hasValue) {
+            dumpFile = argv[++i];
+        } else if (!std::strcmp(argv[i], "--compare") && hasValue) {
+            compareFile = argv[++i];
+        } else if (!std::strcmp(argv[i], "--reference")) {
+            useReference = true;
+        } else if (!std::strcmp(argv[i], "--tol") && hasValue) {
+            tol = std::atoll(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (threads.empty()) {
+#ifdef _OPENMP
+        threads.push_back(omp_get_max_threads());
+#else
+        threads.push_back(1);
+#endif
+    }
+    Dump reference;
+    if (compareFile != NULL && !readDump(compareFile, reference)) {
+        std::fprintf(stderr, "Cannot read %s\n", compareFile);
+        return 1;
+    }
+    FILE * dump = NULL;
+    if (dumpFile != NULL && (dump = std::fopen(dumpFile, "w")) == NULL) {
+        std::fprintf(stderr, "Cannot write %s\n", dumpFile);
+        return 1;
+    }
+    std::printf("# data root %s, population %d\n", cec::dataRoot().c_str(), pop);
+    const bool checking = compareFile != NULL || useReference;
+    int64_t worstUlp = 0;
+    std::printf("%-6s %4s %4s %4s %12s %10s%s\n", "suite", "F", "D", "thr", "evals/s", "us/eval",
+                checking ? "   max ulp" : "");
+    for (size_t s = 0; s < suites.size(); s++) {
+        const int suite = suites[s];
+        std::vector<int> ids = funcs, ds = dims;
+        if (ids.empty()) {
+            for (int id = 1; id <= cec::numFunctions(suite); id++) {
+                ids.push_back(id);
+            }
+        }
+        if (ds.empty()) {
+            if (suite == 17) {
+                ds = {10, 30, 50, 100};
+            } else if (suite == 19) {
+                ds = {9, 16, 18, 10};
+            } else {
+                ds = {10, 20};
+            }
+        }
+        for (size_t k = 0; k < ids.size(); k++) {
+            for (size_t d = 0; d < ds.size(); d++) {
+                const int id = ids[k], dim = ds[d];
+                if (cec::check(suite, id, dim) != NULL) {
+                    continue;
+                }
+                cec::Problem * problem;
+                try {
+                    problem = new cec::Problem(suite, id, dim);
+                } catch (const std::exception & e) {
+                    std::printf("# skipped CEC20%d F%d D%d: %s\n", suite, id, dim, e.what());
+                    continue;
+                }
+                std::mt19937 gen(1000 * suite + 10 * id + dim);
+                std::uniform_real_distribution<double> u(-100.0, 100.0);
+                std::vector<double> x((size_t)dim * pop), f(pop);
+                for (size_t i = 0; i < x.size(); i++) {
+                    x[i] = u(gen);
+                }
+                problem->evaluate(x.data(), f.data(), pop);
+                std::vector<double> fRef;
+                if (useReference) {
+                    std::vector<double> xRef(x);
+                    fRef.resize(pop);
+                    referenceEvaluate(suite, id, dim, xRef.data(), fRef.data(), pop);
+                }
+                int64_t maxUlp = -1;
+                for (int i = 0; i < pop; i++) {
+                    if (dump != NULL) {
+                        std::fprintf(dump, "%d %d %d %d %.17g\n", suite, id, dim, i, f[i]);
+                    }
+                    if (useReference) {
+                        maxUlp = std::max(maxUlp, ulpDistance(f[i], fRef[i]));
+                        continue;
+                    }
+                    std::vector<int> key = {suite, id, dim, i};
+                    Dump::const_iterator ref = reference.find(key);
+                    if (ref != reference.end()) {
+                        maxUlp = std::max(maxUlp, ulpDistance(f[i], ref->second));
+                    }
+                }
+                worstUlp = std::max(worstUlp, maxUlp);
+                for (size_t t = 0; t < threads.size(); t++) {
+#ifdef _OPENMP
+                    omp_set_num_threads(threads[t]);
+#endif
+                    long evals = 0;
+                    double elapsed = 0.0;
+                    auto t0 = TIME_NOW();
+                    do {
+                        problem->evaluate(x.data(), f.data(), pop);
+                        evals += pop;
+                        elapsed = std::chrono::duration<double>(TIME_NOW() - t0).count();
+                    } while (elapsed < minTime);
+                    std::printf("%-6d %4d %4d %4d %12.4g %10.3f", 2000 + suite, id, dim, threads[t],
+                                evals / elapsed, 1e6 * elapsed / evals);
+                    if (checking) {
+                        if (maxUlp < 0) {
+                            std::printf(" %9s", "-");
+                        } else {
+                            std::printf(" %9lld", (long long)maxUlp);
+                        }
+                    }
+                    std::printf("\n");
+                }
+                delete problem;
+            }
+        }
+    }
+    if (dump != NULL) {
+        std::fclose(dump);
+    }
+    if (checking && worstUlp > tol) {
+        std::printf("# largest difference %lld ulp exceeds --tol %lld\n", (long long)worstUlp,
+                    (long long)tol);
+        return 1;
+    }
+    return 0;
+}
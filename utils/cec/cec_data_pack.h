@@ -0,0 +1,164 @@
+/*
+  Binary problem data packs for the CEC test function suites.
+
+  The text data files (rotation matrices, shift vectors and shuffles) of a
+  (func_num, D) pair are parsed once with fscanf, and the parsed arrays are
+  written to a single pack file next to them. Later loads of the same pair
+  map the pack into memory (POSIX) or read it with one fread (Windows)
+  instead of parsing text again.
+
+  A pack is a cec_pack_header followed by nM rotation matrix entries and
+  nOShift shift vector entries (double) and nSS shuffle entries (int), in
+  native byte order. Packs that do not match the suite, func_num, D or file
+  size are ignored. Delete the *.pack files to force the text files to be
+  parsed again.
+*/
+#ifndef CEC_DATA_PACK_H
+#define CEC_DATA_PACK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define CEC_PACK_MAGIC 0x50434543 /* "CECP" */
+#define CEC_PACK_VERSION 1
+
+typedef struct
+{
+	int magic,version,suite,func_num,nx,nM,nOShift,nSS;
+} cec_pack_header;
+
+typedef struct
+{
+	char *base; /* pack contents, NULL if the data was not loaded from a pack */
+	size_t size;
+	int mapped;
+} cec_pack;
+
+static size_t cec_pack_size(const cec_pack_header *h)
+{
+	return sizeof(cec_pack_header)+sizeof(double)*((size_t)h->nM+h->nOShift)+sizeof(int)*(size_t)h->nSS;
+}
+
+static int cec_pack_valid(const cec_pack_header *h, int suite, int func_num, int nx)
+{
+	return h->magic==CEC_PACK_MAGIC&&h->version==CEC_PACK_VERSION&&h->suite==suite
+		&&h->func_num==func_num&&h->nx==nx&&h->nM>=0&&h->nOShift>=0&&h->nSS>=0;
+}
+
+/* Load a pack. Returns 1 and points M, OShift and SS into the pack (NULL for
+   empty arrays) on success, 0 if there is no matching pack. */
+static int cec_pack_load(cec_pack *p, const char *file, int suite, int func_num, int nx,
+	double **M, double **OShift, int **SS)
+{
+	cec_pack_header h;
+	char *base=NULL;
+	size_t size=0;
+	int mapped=0;
+	double *data;
+#if defined(_WIN32)
+	FILE *fpt=fopen(file,"rb");
+	if (fpt==NULL)
+		return 0;
+	if (fread(&h,sizeof(h),1,fpt)==1&&cec_pack_valid(&h,suite,func_num,nx))
+	{
+		size=cec_pack_size(&h);
+		base=(char *)malloc(size);
+		if (base!=NULL)
+		{
+			memcpy(base,&h,sizeof(h));
+			if (fread(base+sizeof(h),1,size-sizeof(h),fpt)!=size-sizeof(h)||fgetc(fpt)!=EOF)
+			{
+				free(base);
+				base=NULL;
+			}
+		}
+	}
+	fclose(fpt);
+#else
+	struct stat st;
+	int fd=open(file,O_RDONLY);
+	if (fd<0)
+		return 0;
+	if (fstat(fd,&st)==0&&(size_t)st.st_size>=sizeof(h))
+	{
+		size=(size_t)st.st_size;
+		void *addr=mmap(NULL,size,PROT_READ,MAP_PRIVATE,fd,0);
+		if (addr!=MAP_FAILED)
+		{
+			memcpy(&h,addr,sizeof(h));
+			if (cec_pack_valid(&h,suite,func_num,nx)&&cec_pack_size(&h)==size)
+			{
+				base=(char *)addr;
+				mapped=1;
+			}
+			else
+				munmap(addr,size);
+		}
+	}
+	close(fd);
+#endif
+	if (base==NULL)
+		return 0;
+	p->base=base;
+	p->size=size;
+	p->mapped=mapped;
+	data=(double *)(base+sizeof(h));
+	*M=h.nM>0?data:NULL;
+	*OShift=h.nOShift>0?data+h.nM:NULL;
+	*SS=h.nSS>0?(int *)(data+h.nM+h.nOShift):NULL;
+	return 1;
+}
+
+/* Write a pack. The pack is written under a temporary name and renamed, so
+   that a partially written pack is never loaded. Failures (e.g. a read-only
+   data directory) are ignored; the text files are then parsed every time. */
+static void cec_pack_write(const char *file, int suite, int func_num, int nx,
+	const double *M, int nM, const double *OShift, int nOShift, const int *SS, int nSS)
+{
+	cec_pack_header h={CEC_PACK_MAGIC,CEC_PACK_VERSION,suite,func_num,nx,nM,nOShift,nSS};
+	char TmpName[1040];
+	FILE *fpt;
+	int ok;
+	sprintf(TmpName,"%s.tmp",file);
+	fpt=fopen(TmpName,"wb");
+	if (fpt==NULL)
+		return;
+	ok=fwrite(&h,sizeof(h),1,fpt)==1;
+	ok=ok&&(nM==0||fwrite(M,sizeof(double),nM,fpt)==(size_t)nM);
+	ok=ok&&(nOShift==0||fwrite(OShift,sizeof(double),nOShift,fpt)==(size_t)nOShift);
+	ok=ok&&(nSS==0||fwrite(SS,sizeof(int),nSS,fpt)==(size_t)nSS);
+	ok=(fclose(fpt)==0)&&ok;
+	if (ok)
+	{
+#if defined(_WIN32)
+		remove(file); /* rename does not replace an existing file */
+#endif
+		ok=rename(TmpName,file)==0;
+	}
+	if (!ok)
+		remove(TmpName);
+}
+
+static void cec_pack_close(cec_pack *p)
+{
+	if (p->base==NULL)
+		return;
+#if !defined(_WIN32)
+	if (p->mapped)
+		munmap(p->base,p->size);
+	else
+#endif
+		free(p->base);
+	p->base=NULL;
+	p->size=0;
+	p->mapped=0;
+}
+
+#endif /* CEC_DATA_PACK_H */
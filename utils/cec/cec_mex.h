@@ -0,0 +1,74 @@
+/*
+  Shared MATLAB gateway of the cecXX_func MEX files:
+
+    f = cecXX_func(x, func_num)
+
+  where x is a D*pop_size matrix and f is 1*pop_size. Unless CEC_DATA_ROOT
+  is set, the problem data is read from the input_data directories next to
+  the MEX file, so the functions work from any working directory.
+*/
+#ifndef CEC_MEX_H
+#define CEC_MEX_H
+
+#include <mex.h>
+#include <stdlib.h>
+#include <string.h>
+#include <exception>
+#include <string>
+#include "cec.h"
+
+inline void cecMexDataRoot()
+{
+	static bool done=false;
+	mxArray *name,*path=NULL;
+	if (done||getenv("CEC_DATA_ROOT")!=NULL)
+		return;
+	done=true;
+	name=mxCreateString(mexFunctionName());
+	if (mexCallMATLAB(1,&path,1,&name,"which")==0)
+	{
+		char *p=mxArrayToString(path);
+		std::string s(p);
+		size_t k=s.find_last_of("/\\");
+		if (k!=std::string::npos)
+			cec::setDataRoot(s.substr(0,k));
+		mxFree(p);
+		mxDestroyArray(path);
+	}
+	mxDestroyArray(name);
+}
+
+inline void cecMexFunction(int suite, int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+	static char err[512];
+	const char *msg;
+	int m,n,func_num;
+	mexAtExit(cec::clearCache);
+	if ((nrhs<2)||(nlhs<1)||!mxIsDouble(prhs[0])||mxIsComplex(prhs[0]))
+	{
+		mexPrintf("usage: f = %s(x, func_num);\n",mexFunctionName());
+		mexErrMsgTxt("x must be a real D*pop_size matrix.");
+	}
+	n=(int)mxGetM(prhs[0]);
+	m=(int)mxGetN(prhs[0]);
+	func_num=(int)mxGetScalar(prhs[1]);
+	msg=cec::check(suite,func_num,n);
+	if (msg!=NULL)
+		mexErrMsgTxt(msg);
+	cecMexDataRoot();
+	plhs[0]=mxCreateDoubleMatrix(1,m,mxREAL);
+	err[0]='\0';
+	try
+	{
+		cec::Problem p(suite,func_num,n);
+		p.evaluate(mxGetPr(prhs[0]),mxGetPr(plhs[0]),m);
+	}
+	catch (const std::exception &e)
+	{
+		strncpy(err,e.what(),sizeof(err)-1);
+	}
+	if (err[0]!='\0')
+		mexErrMsgTxt(err);
+}
+
+#endif /* CEC_MEX_H */
@@ -0,0 +1,41 @@
+/*
+  Entry points of the individual suites, used by cec.cpp. Each suite keeps
+  its own cache of problem data: load returns a context from that cache,
+  or NULL if the data files could not be read, and clear releases it.
+*/
+#ifndef CEC_SUITES_H
+#define CEC_SUITES_H
+
+namespace cec {
+
+namespace cec17 {
+const char *check(int id, int dim);
+void *load(int id, int dim);
+void evaluate(void *context, double *x, double *f, int m);
+void clear();
+}
+
+namespace cec19 {
+const char *check(int id, int dim);
+void *load(int id, int dim);
+void evaluate(void *context, double *x, double *f, int m);
+void clear();
+}
+
+namespace cec20 {
+const char *check(int id, int dim);
+void *load(int id, int dim);
+void evaluate(void *context, double *x, double *f, int m);
+void clear();
+}
+
+namespace cec22 {
+const char *check(int id, int dim);
+void *load(int id, int dim);
+void evaluate(void *context, double *x, double *f, int m);
+void clear();
+}
+
+} // namespace cec
+
+#endif /* CEC_SUITES_H */
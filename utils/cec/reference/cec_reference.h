@@ -0,0 +1,15 @@
+/*
+  Entry points of the CEC kernels as they were before the cec library, see
+  cecXX_ref.cpp. Each suite keeps its data in globals, so they must be
+  called from one thread at a time.
+*/
+#ifndef CEC_REFERENCE_H
+#define CEC_REFERENCE_H
+
+namespace cec17_ref { void cec17_test_func(double *, double *, int, int, int); }
+namespace cec19_ref { void cec19_test_func(double *, double *, int, int, int);
+                      void set_dir_path(const char *); }
+namespace cec20_ref { void cec20_test_func(double *, double *, int, int, int); }
+namespace cec22_ref { void cec22_test_func(double *, double *, int, int, int); }
+
+#endif /* CEC_REFERENCE_H */
@@ -95,6 +95,22 @@ else
     model.bf_type = bf_type;
     model.bf_c = bf_c;
     model.poly = usePolyPart;
+
+    if exist('rbfbuild_mex', 'file') == 3 && any(model.poly == [0 1 2])
+        % Compiled engine (see buildRBFMex): a direct solve of the
+        % regularised system that LSQR approximates below
+        kname = upper(bf_type);
+        if ~any(strcmp(kname, {'BH', 'IMQ', 'CUB', 'TPS', 'G'}))
+            kname = 'MQ';
+        end
+        model.coefs = rbfbuild_mex(Xtr, Ytr, kname, bf_c, model.poly, 1e-6);
+        model.lambda_used = 1e-6;
+        time = toc;
+        if verbose
+            fprintf('Execution time: %0.2f seconds\n', time);
+        end
+        return
+    end
     
     %calculate and transform distances between all the points in the training data
     dist = zeros(n, n);
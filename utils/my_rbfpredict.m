@@ -52,6 +52,17 @@ if model.n ~= size(Xtr, 1)
     error('The matrix Xtr should be the same matrix with which the model was built.');
 end
 
+if exist('rbfpredict_mex', 'file') == 3 && any(model.poly == [0 1 2])
+    % Compiled engine, see buildRBFMex
+    kname = upper(model.bf_type);
+    if ~any(strcmp(kname, {'BH', 'IMQ', 'CUB', 'TPS', 'G'}))
+        kname = 'MQ';
+    end
+    Yq = rbfpredict_mex(Xtr, model.coefs, model.meanY * (model.poly == 0), kname, ...
+                        model.bf_c, model.poly, Xq);
+    return
+end
+
 nq = size(Xq, 1);
 Yq = zeros(nq, 1);
 